@@ -0,0 +1,24 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef _AVN_LOGGER_BENCHES_H_
+#define _AVN_LOGGER_BENCHES_H_
+
+#include <cstddef>
+#include <string>
+
+/** Write syscalls amount performed by the current process or 0 if it is not available */
+std::size_t bench_write_syscalls();
+
+/** Print benchmark result line. Zero syscalls amount is not printed */
+void bench_report(const std::string& name, std::size_t records, double seconds, std::size_t syscalls = 0);
+
+void bench_flush();
+void bench_layout();
+void bench_utf8();
+void bench_json();
+void bench_format();
+void bench_trace();
+void bench_group();
+
+#endif  // _AVN_LOGGER_BENCHES_H_
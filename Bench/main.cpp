@@ -0,0 +1,47 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <benches.h>
+
+std::size_t bench_write_syscalls()
+{
+    std::ifstream io("/proc/self/io");
+
+    for (std::string key; io >> key; ) {
+        std::size_t value;
+        io >> value;
+        if (key == "syscw:")
+            return value;
+    }
+
+    return 0;
+}
+
+void bench_report(const std::string& name, std::size_t records, double seconds, std::size_t syscalls)
+{
+    std::cout << "    " << std::left << std::setw(28) << name << std::right
+              << std::setw(10) << static_cast<std::size_t>(records / seconds) << " rec/s";
+    if (syscalls != 0)
+        std::cout << std::setw(10) << syscalls << " write syscalls";
+    std::cout << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    std::cout << "Start ALogger library benchmarks" << std::endl;
+
+    bench_flush();
+    bench_layout();
+    bench_utf8();
+    bench_json();
+    bench_format();
+    bench_trace();
+    bench_group();
+
+    return 0;
+}
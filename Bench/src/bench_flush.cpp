@@ -0,0 +1,57 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include <benches.h>
+#include <avn/logger/logger_txt_file.h>
+
+namespace {
+
+    constexpr std::size_t records = 200000;
+
+    void _benchFlush(const std::filesystem::path& file, const std::string& name, const ALogger::SFlushPolicy& policy)
+    {
+        using TClock = std::chrono::steady_clock;
+
+        ALogger::ALoggerTxtFile<true, char> log(file);
+
+        log.setFlushPolicy(policy);
+        log.addLevelDescr(0, "INFO");
+        log.addLevelDescr(1, "CRITICAL");
+        log.setLevels({0, 1});
+
+        const auto syscalls{ bench_write_syscalls() };
+        const auto start{ TClock::now() };
+
+        for (std::size_t i = 0; i < records; ++i)
+            log.addString(i % 1000 == 0 ? 1 : 0, "This is benchmark string : integer = ", i);
+        log.flushFile();
+
+        const std::chrono::duration<double> elapsed{ TClock::now() - start };
+        bench_report(name, records, elapsed.count(), bench_write_syscalls() - syscalls);
+    }
+
+}   // namespace
+
+void bench_flush()
+{
+    using namespace std::chrono_literals;
+    namespace fs = std::filesystem;
+
+    const auto file{ fs::temp_directory_path() / "avn_logger_bench_flush.log" };
+
+    std::cout << "START bench_flush, " << records << " records" << std::endl;
+
+    _benchFlush(file, "flush always (std::endl)", { 0, 0ms, {}, true });
+    _benchFlush(file, "default", {});
+    _benchFlush(file, "64 KB", { 64 * 1024, 0ms, {} });
+    _benchFlush(file, "200 ms timer", { 0, 200ms, {} });
+    _benchFlush(file, "CRITICAL levels", { 0, 0ms, { 1 } });
+    _benchFlush(file, "CRITICAL fdatasync", { 0, 0ms, { 1 }, false, true });
+
+    fs::remove(file);
+}
@@ -0,0 +1,59 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <benches.h>
+#include <avn/logger/logger_txt_base.h>
+
+namespace {
+
+    constexpr std::size_t records = 1000000;
+
+    using TClock = std::chrono::steady_clock;
+
+    class ALoggerTxtNull : public ALogger::ALoggerTxtBase<false, char> {
+    public:
+        std::size_t _size{0};
+
+    private:
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const std::string& data) noexcept override
+        {
+            _size += data.size();
+            return true;
+        }
+    };
+
+    template<typename TFunc>
+    void _benchMessages(const std::string& name, TFunc&& func)
+    {
+        ALoggerTxtNull log;
+        log.enableLevel(0);
+
+        const auto start{ TClock::now() };
+
+        for (std::size_t i = 0; i < records; ++i)
+            func(log, i);
+
+        const std::chrono::duration<double> elapsed{ TClock::now() - start };
+        bench_report(name, records, elapsed.count());
+    }
+
+}   // namespace
+
+void bench_format()
+{
+    std::cout << "START bench_format, " << records << " records" << std::endl;
+
+    const std::string user{ "user" };
+
+    _benchMessages("addString", [&](ALoggerTxtNull& log, std::size_t i) {
+        log.addString(0, "Request ", i, " from ", user, " finished in ", 0.125 * static_cast<double>(i % 8), " s");
+    });
+
+    _benchMessages("addFormat", [&](ALoggerTxtNull& log, std::size_t i) {
+        log.addFormat(0, AVN_FMT("Request {} from {} finished in {:.3f} s"), i, user, 0.125 * static_cast<double>(i % 8));
+    });
+}
@@ -0,0 +1,68 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <benches.h>
+#include <avn/logger/logger_txt_group.h>
+
+namespace {
+
+    constexpr std::size_t records = 10000000;
+
+    using TClock = std::chrono::steady_clock;
+
+    class ALoggerTxtNull : public ALogger::ALoggerTxtBase<false, char> {
+    public:
+        std::size_t _size{0};
+
+    private:
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const std::string& data) noexcept override
+        {
+            _size += data.size();
+            return true;
+        }
+    };
+
+    using TGroup = ALogger::ALoggerTxtGroup<ALoggerTxtNull, ALoggerTxtNull, ALoggerTxtNull>;
+
+    template<typename TFunc>
+    void _benchMessages(const std::string& name, std::size_t amount, TFunc&& func)
+    {
+        TGroup group;
+        group.enableLevel(0);
+
+        const auto start{ TClock::now() };
+
+        for (std::size_t i = 0; i < amount; ++i)
+            func(group, i);
+
+        const std::chrono::duration<double> elapsed{ TClock::now() - start };
+        bench_report(name, amount, elapsed.count());
+    }
+
+}   // namespace
+
+void bench_group()
+{
+    std::cout << "START bench_group, " << records << " records for the group of 3 loggers" << std::endl;
+
+    const std::string user{ "user" };
+
+    // Each logger checks the message itself, as the group did before the filter
+    _benchMessages("rejected, loggers check", records, [&](TGroup& group, std::size_t i) {
+        group.logger<0>().addString(1, "Request ", i, " from ", user);
+        group.logger<1>().addString(1, "Request ", i, " from ", user);
+        group.logger<2>().addString(1, "Request ", i, " from ", user);
+    });
+
+    _benchMessages("rejected, group filter", records, [&](TGroup& group, std::size_t i) {
+        group.addString(1, "Request ", i, " from ", user);
+    });
+
+    _benchMessages("accepted", records / 10, [&](TGroup& group, std::size_t i) {
+        group.addString(0, "Request ", i, " from ", user);
+    });
+}
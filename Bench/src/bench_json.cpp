@@ -0,0 +1,57 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <benches.h>
+#include <avn/logger/logger_json_escape.h>
+
+namespace {
+
+    constexpr std::size_t records = 1000000;
+
+    using TClock = std::chrono::steady_clock;
+
+    const std::string message{ "Request \"GET /api/v1/items\" finished : status = 200, elapsed = 12 ms, user = test@example.com" };
+
+    void _escapeBytewise(std::string& out, const std::string& str)
+    {
+        for (const auto ch : str) {
+            switch (ch) {
+            case '"' :  out += "\\\""; break;
+            case '\\' : out += "\\\\"; break;
+            case '\n' : out += "\\n"; break;
+            default :   out.push_back(ch); break;
+            }
+        }
+    }
+
+    template<typename _TEscape>
+    void _benchEscape(const std::string& name, _TEscape escape)
+    {
+        std::string out;
+        std::size_t size{0};
+
+        const auto start{ TClock::now() };
+
+        for (std::size_t i = 0; i < records; ++i) {
+            out.clear();
+            escape(out, message);
+            size += out.size();
+        }
+
+        const std::chrono::duration<double> elapsed{ TClock::now() - start };
+        bench_report(name, size != 0 ? records : 0, elapsed.count());
+    }
+
+}   // namespace
+
+void bench_json()
+{
+    std::cout << "START bench_json, " << records << " records" << std::endl;
+
+    _benchEscape("bytewise escaping", _escapeBytewise);
+    _benchEscape("span escaping", [](std::string& out, const std::string& str) { ALogger::JsonEscape::append(out, str); });
+}
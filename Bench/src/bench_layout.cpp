@@ -0,0 +1,65 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <benches.h>
+#include <avn/logger/logger_txt_base.h>
+
+namespace {
+
+    constexpr std::size_t records = 1000000;
+
+    /** Logger that only formats messages */
+    class ALoggerTxtNull : public ALogger::ALoggerTxtBase<false, char> {
+    public:
+        ALoggerTxtNull(bool string_maker)
+        {
+            if (string_maker)
+                setStringMaker(selectDefaultStringMaker());
+        }
+
+        std::size_t _size{0};
+
+    private:
+        std::string _line;
+
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const std::string& data) noexcept override
+        {
+            _line.clear();
+            prepareString(_line, level, time, data);
+            _size += _line.size();
+            return true;
+        }
+    };
+
+    void _benchLayout(const std::string& name, bool string_maker)
+    {
+        using TClock = std::chrono::steady_clock;
+
+        ALoggerTxtNull log(string_maker);
+        const std::string message{ "This is benchmark string : integer = 10" };
+
+        log.addLevelDescr(0, "INFO");
+        log.enableLevel(0);
+
+        const auto start{ TClock::now() };
+
+        for (std::size_t i = 0; i < records; ++i)
+            log.forceAddToLog(0, message, std::chrono::system_clock::now());
+
+        const std::chrono::duration<double> elapsed{ TClock::now() - start };
+        bench_report(name, records, elapsed.count());
+    }
+
+}   // namespace
+
+void bench_layout()
+{
+    std::cout << "START bench_layout, " << records << " records" << std::endl;
+
+    _benchLayout("string maker", true);
+    _benchLayout("precompiled layout", false);
+}
@@ -0,0 +1,61 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <benches.h>
+#include <avn/logger/logger_base.h>
+
+namespace {
+
+    constexpr std::size_t tasks = 1000000;
+
+    using TClock = std::chrono::steady_clock;
+
+    class ALoggerNull : public ALogger::ALoggerBase<false, std::string> {
+    public:
+        std::size_t _size{0};
+
+    private:
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const std::string& data) noexcept override
+        {
+            _size += data.size();
+            return true;
+        }
+    };
+
+    void _benchTasks(const std::string& name, ALogger::ALoggerTrace* trace)
+    {
+        ALoggerNull log;
+        log.setTrace(trace);
+
+        const auto start{ TClock::now() };
+
+        // Each task is the outer span with one nested span and one message, like the request with the query inside
+        for (std::size_t i = 0; i < tasks; ++i) {
+            auto task{ log.addTask() };
+            task.setName("request").succeeded();
+            {
+                auto query{ log.addTask() };
+                query.setName("query").succeeded();
+                log.addToLog(0, "Query");
+            }
+        }
+
+        const std::chrono::duration<double> elapsed{ TClock::now() - start };
+        bench_report(name, tasks, elapsed.count());
+    }
+
+}   // namespace
+
+void bench_trace()
+{
+    std::cout << "START bench_trace, " << tasks << " tasks with nested task" << std::endl;
+
+    ALogger::ALoggerTrace trace(2 * tasks);
+
+    _benchTasks("tasks without trace", nullptr);
+    _benchTasks("tasks with trace", &trace);
+}
@@ -0,0 +1,90 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <chrono>
+#include <codecvt>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <locale>
+#include <string>
+
+#include <benches.h>
+#include <avn/logger/logger_txt_file.h>
+
+namespace {
+
+    constexpr std::size_t records = 1000000;
+
+    using TClock = std::chrono::steady_clock;
+
+    const std::wstring message{ L"2020-01-01 00:00:00 [INFO] This is benchmark string : integer = 10, value = 3.14159" };
+
+    void _benchCodecvt(const std::filesystem::path& file)
+    {
+        // Previous wide file output path : wide stream with UTF-8 codecvt locale
+        std::wofstream stream(file);
+        stream.imbue(std::locale(std::locale(), new std::codecvt_utf8<wchar_t>()));
+
+        const auto start{ TClock::now() };
+
+        for (std::size_t i = 0; i < records; ++i)
+            stream << message << stream.widen('\n');
+        stream.flush();
+
+        const std::chrono::duration<double> elapsed{ TClock::now() - start };
+        bench_report("wofstream + codecvt_utf8", records, elapsed.count());
+    }
+
+    void _benchTranscoder(const std::filesystem::path& file)
+    {
+        std::ofstream stream(file, std::ios_base::binary);
+        std::string bytes;
+
+        const auto start{ TClock::now() };
+
+        for (std::size_t i = 0; i < records; ++i) {
+            bytes.clear();
+            ALogger::Utf8::append(bytes, message);
+            stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size())).put('\n');
+        }
+        stream.flush();
+
+        const std::chrono::duration<double> elapsed{ TClock::now() - start };
+        bench_report("ofstream + Utf8::append", records, elapsed.count());
+    }
+
+    void _benchLogger(const std::filesystem::path& file)
+    {
+        ALogger::ALoggerTxtFile<false, wchar_t> log(file);
+
+        log.addLevelDescr(0, L"INFO");
+        log.setLayout(L"%v");
+        log.enableLevel(0);
+
+        const auto start{ TClock::now() };
+
+        for (std::size_t i = 0; i < records; ++i)
+            log.forceAddToLog(0, message, std::chrono::system_clock::now());
+        log.flushFile();
+
+        const std::chrono::duration<double> elapsed{ TClock::now() - start };
+        bench_report("wchar_t file logger", records, elapsed.count());
+    }
+
+}   // namespace
+
+void bench_utf8()
+{
+    namespace fs = std::filesystem;
+
+    std::cout << "START bench_utf8, " << records << " records" << std::endl;
+
+    const auto file{ fs::temp_directory_path() / "bench_utf8.log" };
+
+    _benchCodecvt(file);
+    _benchTranscoder(file);
+    _benchLogger(file);
+
+    fs::remove(file);
+}
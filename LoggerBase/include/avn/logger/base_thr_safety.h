@@ -12,7 +12,8 @@
  * use any thread safety primitives.
  *
  * Also this class declares \a outData pure virtual function that has to be implemented by children classes. This
- * function is called from \a outDataThrSafe function.
+ * function is called from \a outDataThrSafe function. After it \a commitData virtual function is called without output
+ * lock. Children classes can use it to wait for data durability without blocking other threads output.
  */
 
 #ifndef _AVN_LOGGER_BASE_THR_SAFETY_H_
@@ -62,8 +63,13 @@ namespace ALogger {
          */
         bool outDataThrSafe(std::size_t level, std::chrono::system_clock::time_point time, const _TLogData& data)
         {
-            std::lock_guard<std::mutex> lock_guard(_outMutex);
-            return outData(level, time, data);
+            bool res;
+            {
+                std::lock_guard<std::mutex> lock_guard(_outMutex);
+                res = outData(level, time, data);
+            }
+            commitData(level);
+            return res;
         }
 
         /** Output data.
@@ -78,6 +84,15 @@ namespace ALogger {
          */
         virtual bool outData(std::size_t level, std::chrono::system_clock::time_point time, const _TLogData& data) noexcept = 0;
 
+        /** Commit output data.
+         *
+         * This function is called from #outDataThrSafe after #outData call without output lock. It can be used to
+         * wait for data durability. Default implementation does nothing.
+         *
+         * \param[in] level ALogger level of the data output.
+         */
+        virtual void commitData(std::size_t /* level */) noexcept { }
+
     private:
         std::mutex _outMutex;
     };
@@ -105,7 +120,9 @@ namespace ALogger {
          */
         bool outDataThrSafe(std::size_t level, std::chrono::system_clock::time_point time, const _TLogData& data) noexcept
         {
-            return outData(level, time, data);
+            const bool res{ outData(level, time, data) };
+            commitData(level);
+            return res;
         }
 
         /** Output data.
@@ -119,6 +136,15 @@ namespace ALogger {
          * \return true if data was output successfully or false otherwise.
          */
         virtual bool outData(std::size_t level, std::chrono::system_clock::time_point time, const _TLogData& data) noexcept = 0;
+
+        /** Commit output data.
+         *
+         * This function is called from #outDataThrSafe after #outData call without output lock. It can be used to
+         * wait for data durability. Default implementation does nothing.
+         *
+         * \param[in] level ALogger level of the data output.
+         */
+        virtual void commitData(std::size_t /* level */) noexcept { }
     };
 
 } // namespace ALogger
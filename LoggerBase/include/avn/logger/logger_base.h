@@ -94,6 +94,9 @@ logger.enableLevel(ALogger::ERROR);
 
  * \endcode
  *
+ * Tasks above are bound to the thread. Request that runs on several threads, say, on the thread pool, uses the shared
+ * task created by #ALogger::ALoggerBase::addSharedTask call, see logger_task_handle.h.
+ *
  * However, during application debugging taks mode is not useful because you see messages only after task finish. You
  * can temporary or for Debug mode build disable task mode by #ALogger::ALoggerBase::disableTasks call.
  */
@@ -101,17 +104,21 @@ logger.enableLevel(ALogger::ERROR);
 #ifndef _AVN_LOGGER_BASE_H_
 #define _AVN_LOGGER_BASE_H_
 
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <map>
 #include <set>
 #include <stack>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <avn/logger/data_types.h>
 #include <avn/logger/base_thr_safety.h>
+#include <avn/logger/logger_levels_filter.h>
 #include <avn/logger/logger_task.h>
+#include <avn/logger/logger_task_handle.h>
 #include <avn/logger/logger_group.h>
 
 namespace ALogger {
@@ -200,6 +207,58 @@ namespace ALogger {
          */
         ALoggerTask<_TLogData> addTask(TLevels levels) noexcept { return addTask(levels, false); }
 
+        /** Add task with sampling
+         *
+         * This call creates task for the current thread like #addTask(bool) does. Sampled task outputs all messages
+         * even if it succeeds. Sampling decision costs one counter increment or one
+         * comparison of the key hash. Messages of the sampled nested task are output even if the enclosing task is not
+         * sampled and succeeds.
+         *
+         * \code
+
+    auto task{ logger.addTask(ALogger::STaskSampling::oneIn(1000)) };             // Each 1000th task
+    auto task{ logger.addTask(ALogger::STaskSampling::byKey(request_id, 1000)) }; // Tasks by request hash
+
+         * \endcode
+         *
+         * \param[in] sampling Sampling
+         * \param[in] init_success_state Success state at the beginning. It can be changed later.
+         *
+         * \return Created task object
+         */
+        ALoggerTask<_TLogData> addTask(const STaskSampling& sampling, bool init_success_state = false) noexcept;
+
+        /** Add task that is not bound to the thread
+         *
+         * Task gets messages of threads that activate it by #ALogger::ALoggerBase::activate call. Levels to be enabled
+         * are inherited from current logger.
+         *
+         * \param[in] init_success_state Success state at the beginning. It can be changed later.
+         *
+         * \return Task handle
+         */
+        ALoggerTaskHandle<_TLogData> addSharedTask(bool init_success_state = false) noexcept { return addSharedTask(_outLevels, init_success_state); }
+
+        /** Add task that is not bound to the thread with specified levels
+         *
+         * \param[in] levels levels to be enabled.
+         * \param[in] init_success_state Success state at the beginning. It can be changed later.
+         *
+         * \return Task handle
+         */
+        ALoggerTaskHandle<_TLogData> addSharedTask(TLevels levels, bool init_success_state = false) noexcept;
+
+        /** Activate shared task on the current thread
+         *
+         * Messages of this logger added by the current thread go to \a task until the returned scope is destroyed.
+         * Scope keeps the task alive.
+         *
+         * \param[in] task Task handle
+         *
+         * \return Activation scope
+         */
+        ALoggerTaskScope activate(const ALoggerTaskHandle<_TLogData>& task) noexcept { return ALoggerTaskScope(this, task._task); }
+
         /** Enable or disable specific level
          *
          * \param[in] level Level to be enabled or disabled.
@@ -229,7 +288,46 @@ namespace ALogger {
          * 
          * \param[in] levels Levels to use
          */
-        void setLevels(TLevels levels) noexcept { _outLevels = levels; }
+        void setLevels(TLevels levels) noexcept { _outLevels = levels; SLevelsState::changed(); }
+
+        /** Set tasks memory budget
+         *
+         * Tasks that exceed the budget move their messages to the temporary file, see logger_task_spill.h. It is
+         * applied to the data types that have #ALogger::SSpillCodec specialization only.
+         *
+         * \param[in] policy Budget policy. No limits by default
+         */
+        void setSpillPolicy(const SSpillPolicy& policy) noexcept { _spillBudget.setPolicy(policy); }
+
+        /** Tasks memory budget
+         *
+         * \return Budget with current policy and memory used by tasks
+         */
+        const ALoggerSpillBudget& spillBudget() const noexcept { return _spillBudget; }
+
+        /** Set partial flush policy of new tasks
+         *
+         * Each task can change it by #ALogger::ALoggerTask::setFlushPolicy call.
+         *
+         * \param[in] policy Flush policy. Partial flush is disabled by default
+         */
+        void setTaskFlushPolicy(const STaskFlushPolicy& policy) noexcept { _flushPolicy = policy; }
+
+        /** Open tasks registry
+         *
+         * Registry is used by #ALogger::ALoggerTaskWatchdog, see logger_task_watchdog.h.
+         *
+         * \return Registry reference
+         */
+        ALoggerTaskRegistry& openTasks() noexcept { return _openTasks; }
+
+        /** Set tasks trace
+         *
+         * Tasks created after this call are recorded as spans, see logger_task_trace.h.
+         *
+         * \param[in] trace Trace. It has to outlive the logger tasks. Null pointer disables tracing
+         */
+        void setTrace(ALoggerTrace* trace) noexcept { _trace = trace; }
 
         /** Check level to be output
          *
@@ -251,6 +349,19 @@ namespace ALogger {
          */
         bool forceAddToLog(std::size_t level, const _TLogData& data, std::chrono::system_clock::time_point time = std::chrono::system_clock::now()) noexcept override;
 
+        /** Force the message to be output with specified timestamp
+         *
+         * Message will be output regardless level and task presence. Sinks get it by reference, it is not copied.
+         *
+         * \param[in] level Message level
+         * \param[in] data Message to be output
+         * \param[in] time Timestamp
+         *
+         * \return true if message is output
+         */
+        bool forceAddToLog(std::size_t level, _TLogData&& data, std::chrono::system_clock::time_point time = std::chrono::system_clock::now()) noexcept override
+                                                                                        { return forceAddToLog(level, static_cast<const _TLogData&>(data), time); }
+
         /** Output the message
          *
          * If a task is active, message could be output at the task end. If no task is active, message will be output
@@ -265,6 +376,20 @@ namespace ALogger {
          */
         bool addToLog(std::size_t level, const _TLogData& data) noexcept { return addToLog(level, data, std::chrono::system_clock::now()); }
 
+        /** Output the message
+         *
+         * If a task is active, message is moved into the task storage and could be output at the task end. If no
+         * task is active, message will be output only if logger level is enabled.
+         *
+         * Message will be output with the current timestamp.
+         *
+         * \param[in] level Message level
+         * \param[in] data Message to be output
+         *
+         * \return true if message is output
+         */
+        bool addToLog(std::size_t level, _TLogData&& data) noexcept { return addToLog(level, std::move(data), std::chrono::system_clock::now()); }
+
         /** Output the message with specified timestamp
          *
          * If a task is active, message could be output at the task end. If no task is active, message will be output
@@ -276,7 +401,20 @@ namespace ALogger {
          *
          * \return true if message is output
          */
-        bool addToLog(std::size_t level, const _TLogData& data, std::chrono::system_clock::time_point time) noexcept;
+        bool addToLog(std::size_t level, const _TLogData& data, std::chrono::system_clock::time_point time) noexcept   { return addToLogImpl(level, data, time); }
+
+        /** Output the message with specified timestamp
+         *
+         * If a task is active, message is moved into the task storage and could be output at the task end. If no
+         * task is active, message will be output only if logger level is enabled.
+         *
+         * \param[in] level Message level
+         * \param[in] data Message to be output
+         * \param[in] time Timestamp
+         *
+         * \return true if message is output
+         */
+        bool addToLog(std::size_t level, _TLogData&& data, std::chrono::system_clock::time_point time) noexcept        { return addToLogImpl(level, std::move(data), time); }
 
         /** Return ITaskLogger interface
          *
@@ -305,8 +443,23 @@ namespace ALogger {
         TLevels _outLevels;
         TThreads _threads;
         bool _enableTasks{true};
+        ALoggerSpillBudget _spillBudget;
+        STaskFlushPolicy _flushPolicy;
+        ALoggerTaskRegistry _openTasks;
+        ALoggerTrace* _trace{nullptr};
+        std::atomic<std::size_t> _sampleCounter{0};
 
         void removeTask() noexcept override;
+        ALoggerSpillBudget& taskSpillBudget() noexcept override  { return _spillBudget; }
+        const STaskFlushPolicy& taskFlushPolicy() const noexcept override { return _flushPolicy; }
+        ALoggerTaskRegistry& taskRegistry() noexcept override   { return _openTasks; }
+        ALoggerTrace* taskTrace() noexcept override             { return _trace; }
+
+        ALoggerTask<_TLogData>* enclosingTask(const SActiveTask* active) noexcept;
+        ALoggerSharedTask<_TLogData>* enclosingSharedTask(const SActiveTask* active) noexcept;
+
+        template<typename TData>
+        bool addToLogImpl(std::size_t level, TData&& data, std::chrono::system_clock::time_point time) noexcept;
 
         ALoggerTask<_TLogData>*  addTaskForLoggerGroup(bool init_succeeded) noexcept override;
         ALoggerTask<_TLogData>*  addTaskForLoggerGroup() noexcept override                   { return addTaskForLoggerGroup(false); }
@@ -322,19 +475,60 @@ namespace ALogger {
             assert(tasks.empty());
     }
 
+    template<bool _ThrSafe, typename _TLogData>
+    ALoggerTask<_TLogData> ALoggerBase<_ThrSafe, _TLogData>::addTask(const STaskSampling& sampling, bool init_success_state) noexcept
+    {
+        auto task{ addTask(init_success_state) };
+        task.setSampled(sampling.sample(_sampleCounter));
+        return task;
+    }
+
+    template<bool _ThrSafe, typename _TLogData>
+    ALoggerTaskHandle<_TLogData> ALoggerBase<_ThrSafe, _TLogData>::addSharedTask(TLevels levels, bool init_success_state) noexcept
+    {
+        return ALoggerTaskHandle<_TLogData>(std::make_shared<ALoggerSharedTask<_TLogData>>(static_cast<ITask&>(*this), std::move(levels), init_success_state));
+    }
+
+    template<bool _ThrSafe, typename _TLogData>
+    ALoggerTask<_TLogData>* ALoggerBase<_ThrSafe, _TLogData>::enclosingTask(const SActiveTask* active) noexcept
+    {
+        // The first task opened inside the active shared task scope is enclosed by the shared task
+        if (active != nullptr && active->_localTasks == 0)
+            return nullptr;
+
+        const auto& tasks{ _threads[std::this_thread::get_id()] };
+        return tasks.empty() ? nullptr : tasks.top();
+    }
+
+    template<bool _ThrSafe, typename _TLogData>
+    ALoggerSharedTask<_TLogData>* ALoggerBase<_ThrSafe, _TLogData>::enclosingSharedTask(const SActiveTask* active) noexcept
+    {
+        if (active == nullptr || active->_localTasks != 0)
+            return nullptr;
+        return static_cast<ALoggerSharedTask<_TLogData>*>(active->_task);
+    }
+
     template<bool _ThrSafe, typename _TLogData>
     ALoggerTask<_TLogData> ALoggerBase<_ThrSafe, _TLogData>::addTask(bool init_success_state) noexcept
     {
-        auto task{ ITask::createTask(init_success_state) };
+        auto* active{ SActiveTask::find(this) };
+        auto task{ ITask::createTask(init_success_state, enclosingTask(active), enclosingSharedTask(active)) };
         _threads[std::this_thread::get_id()].push(&task);
+        ++SLevelsState::threadTasks();
+        if (active != nullptr)
+            ++active->_localTasks;
         return task;
     }
 
     template<bool _ThrSafe, typename _TLogData>
     ALoggerTask<_TLogData>* ALoggerBase<_ThrSafe, _TLogData>::addTaskForLoggerGroup(bool init_succeeded) noexcept
     {
-        auto task{ IGroup::createTask(*this, init_succeeded) };
+        auto* active{ SActiveTask::find(this) };
+        auto task{ IGroup::createTask(*this, init_succeeded, enclosingTask(active), enclosingSharedTask(active)) };
         _threads[std::this_thread::get_id()].push(task);
+        ++SLevelsState::threadTasks();
+        if (active != nullptr)
+            ++active->_localTasks;
         return task;
     }
 
@@ -359,6 +553,10 @@ namespace ALogger {
     {
         assert(!_threads[std::this_thread::get_id()].empty());
         _threads[std::this_thread::get_id()].pop();
+        --SLevelsState::threadTasks();
+
+        if (auto* active{ SActiveTask::find(this) }; active != nullptr && active->_localTasks != 0)
+            --active->_localTasks;
     }
 
     template<bool _ThrSafe, typename _TLogData>
@@ -366,11 +564,16 @@ namespace ALogger {
     {
         if (to_enable)  _outLevels.emplace(level);
         else            _outLevels.erase(level);
+
+        SLevelsState::changed();
     }
 
     template<bool _ThrSafe, typename _TLogData>
     bool ALoggerBase<_ThrSafe, _TLogData>::taskOrToBeAdded(std::size_t level) const noexcept
     {
+        if (SActiveTask::find(this) != nullptr)
+            return true;
+
         const auto thread{ _threads.find(std::this_thread::get_id()) };
         if (thread != _threads.cend() && !thread->second.empty())
             return true;
@@ -381,15 +584,21 @@ namespace ALogger {
     }
 
     template<bool _ThrSafe, typename _TLogData>
-    bool ALoggerBase<_ThrSafe, _TLogData>::addToLog(std::size_t level, const _TLogData& data, std::chrono::system_clock::time_point time) noexcept
+    template<typename TData>
+    bool ALoggerBase<_ThrSafe, _TLogData>::addToLogImpl(std::size_t level, TData&& data, std::chrono::system_clock::time_point time) noexcept
     {
-        auto thread{ _threads.find(std::this_thread::get_id()) };
-        auto& tasks = thread->second;
+        // Active shared task gets messages unless thread-bound task is opened after its activation
+        if (auto* active{ SActiveTask::find(this) }; _enableTasks && active != nullptr && active->_localTasks == 0) {
+            static_cast<ALoggerSharedTask<_TLogData>*>(active->_task)->addToLog(level, std::forward<TData>(data), time);
+            return true;
+        }
+
+        const auto thread{ _threads.find(std::this_thread::get_id()) };
 
-        if (_enableTasks && thread != _threads.end() && !tasks.empty()) {
-            auto& top{ tasks.top() };
+        if (_enableTasks && thread != _threads.end() && !thread->second.empty()) {
+            auto& top{ thread->second.top() };
             assert(top);
-            top->addToLog(level, data, time);
+            top->addToLog(level, std::forward<TData>(data), time);
             return true;
         } else if (taskOrToBeAdded(level)) {
             return ALoggerBaseThrSafety<_ThrSafe,_TLogData>::outDataThrSafe(level, time, data);
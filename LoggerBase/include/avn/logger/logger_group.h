@@ -36,9 +36,12 @@ _log.addString(WARNING, L"Warning message!");         // Outputs message
 #ifndef _AVN_LOGGER_LOGGER_GROUP_H
 #define _AVN_LOGGER_LOGGER_GROUP_H
 
+#include <atomic>
 #include <tuple>
+#include <utility>
 #include <avn/logger/logger_base.h>
 #include <avn/logger/logger_group_task.h>
+#include <avn/logger/logger_levels_filter.h>
 
 namespace ALogger {
 
@@ -49,9 +52,10 @@ namespace ALogger {
         friend class ALoggerGroup;
 
     protected:
-        ALoggerTask<_TLogData>* createTask(ITaskLogger<_TLogData>& logger, bool init_success_state) noexcept
+        ALoggerTask<_TLogData>* createTask(ITaskLogger<_TLogData>& logger, bool init_success_state, ALoggerTask<_TLogData>* parent = nullptr,
+                                           ALoggerSharedTask<_TLogData>* shared = nullptr) noexcept
         {
-            return new ALoggerTask<_TLogData>(logger, init_success_state);
+            return new ALoggerTask<_TLogData>(logger, init_success_state, parent, shared);
         };
 
     private:
@@ -147,6 +151,28 @@ namespace ALogger {
          */
         void setLevels(TLevels levels) noexcept;
 
+        /** Set tasks memory budget for all loggers inside container
+         *
+         * \param[in] policy Budget policy
+         */
+        void setSpillPolicy(const SSpillPolicy& policy) noexcept;
+
+        /** Set partial flush policy of new tasks for all loggers inside container
+         *
+         * \param[in] policy Flush policy
+         */
+        void setTaskFlushPolicy(const STaskFlushPolicy& policy) noexcept;
+
+        /** Check that any logger inside container may output the message
+         *
+         * Check does not visit loggers unless their levels are changed, see logger_levels_filter.h.
+         *
+         * \param[in] level Message level
+         *
+         * \return False if no logger outputs the message
+         */
+        bool mayOutput(std::size_t level) const noexcept;
+
         /** Force the message to be output for all loggers inside container
          *
          * Message will be output regardless level and task presence.
@@ -169,6 +195,18 @@ namespace ALogger {
          */
         bool addToLog(std::size_t level, const TLogData& data, std::chrono::system_clock::time_point time = std::chrono::system_clock::now()) noexcept;
 
+        /** Output the message for all loggers inside container
+         *
+         * Message is copied for all loggers except the last one, the last logger gets the moved message.
+         *
+         * \param[in] level Message level
+         * \param[in] data Message to be output
+         * \param[in] time Timestamp. Current time by default
+         *
+         * \return true if message is output
+         */
+        bool addToLog(std::size_t level, TLogData&& data, std::chrono::system_clock::time_point time = std::chrono::system_clock::now()) noexcept;
+
         /** Add task for all loggers inside container
          *
          * \return Task object
@@ -200,8 +238,21 @@ namespace ALogger {
          */
         auto addTask(TLevels levels, bool init_success_state) noexcept;
 
+        /** Add task with sampling for all loggers inside container
+         *
+         * Sampling decision is made once, so all tasks of the container are sampled or not.
+         *
+         * \param[in] sampling Sampling
+         * \param[in] init_success_state Initial task state
+         *
+         * \return Tasks object
+         */
+        auto addTask(const STaskSampling& sampling, bool init_success_state = false) noexcept;
+
     protected:
         TArray _logger;
+        std::atomic<std::size_t> _sampleCounter{0};
+        ALoggerLevelsFilter _filter;
 
     };  // class ALoggerGroup
 
@@ -231,6 +282,13 @@ namespace ALogger {
         std::apply([&](auto&... logger) { (logger.setLevels(levels), ...); }, _logger);
     }
 
+    template< typename... _TLogger >
+    bool ALoggerGroup<_TLogger...>::mayOutput(std::size_t level) const noexcept {
+        return _filter.test(level, [this]() {
+            return std::apply([](const auto&... logger) { return (SLevelsState::mask(logger.levels()) | ...); }, _logger);
+        });
+    }
+
     template< typename... _TLogger >
     bool ALoggerGroup<_TLogger...>::forceAddToLog(std::size_t level, const TLogData& data, std::chrono::system_clock::time_point time) noexcept {
         bool res{true};
@@ -238,6 +296,16 @@ namespace ALogger {
         return res;
     }
 
+    template< typename... _TLogger >
+    void ALoggerGroup<_TLogger...>::setSpillPolicy(const SSpillPolicy& policy) noexcept {
+        std::apply([&](auto&... logger) { (logger.setSpillPolicy(policy), ...); }, _logger);
+    }
+
+    template< typename... _TLogger >
+    void ALoggerGroup<_TLogger...>::setTaskFlushPolicy(const STaskFlushPolicy& policy) noexcept {
+        std::apply([&](auto&... logger) { (logger.setTaskFlushPolicy(policy), ...); }, _logger);
+    }
+
     template< typename... _TLogger >
     void ALoggerGroup<_TLogger...>::disableTasks() noexcept {
         std::apply([&](auto&... logger) { (logger.disableTasks(), ...); }, _logger);
@@ -245,11 +313,27 @@ namespace ALogger {
 
     template< typename... _TLogger >
     bool ALoggerGroup<_TLogger...>::addToLog(std::size_t level, const TLogData& data, std::chrono::system_clock::time_point time) noexcept {
+        if (!mayOutput(level))
+            return false;
+
         bool res{true};
         std::apply([&](auto&... logger) { (res &= ... &= logger.addToLog(level, data, time)); }, _logger);
         return res;
     }
 
+    template< typename... _TLogger >
+    bool ALoggerGroup<_TLogger...>::addToLog(std::size_t level, TLogData&& data, std::chrono::system_clock::time_point time) noexcept {
+        if (!mayOutput(level))
+            return false;
+
+        bool res{true};
+        std::size_t index{0};
+        std::apply([&](auto&... logger) {
+            ((res &= (++index == sizeof...(_TLogger) ? logger.addToLog(level, std::move(data), time) : logger.addToLog(level, std::as_const(data), time))), ...);
+        }, _logger);
+        return res;
+    }
+
     template< typename... _TLogger >
     auto ALoggerGroup<_TLogger...>::addTask() noexcept {
         auto tasks{ std::apply([](auto&&... logger){
@@ -282,6 +366,16 @@ namespace ALogger {
         return ALoggerGroupTask(std::move(tasks));
     }
 
+    template< typename... _TLogger >
+    auto ALoggerGroup<_TLogger...>::addTask(const STaskSampling& sampling, bool init_success_state) noexcept {
+        const bool sampled{ sampling.sample(_sampleCounter) };
+        auto tasks{ std::apply([init_success_state](auto&&... logger){
+            return std::make_tuple((logger.getLoggerGroupInterface())->addTaskForLoggerGroup(init_success_state) ...);
+        }, _logger) };
+        std::apply([sampled](auto*... task) { (task->setSampled(sampled), ...); }, tasks);
+        return ALoggerGroupTask(std::move(tasks));
+    }
+
 }   // namespace ALogger
 
 #endif // _AVN_LOGGER_LOGGER_GROUP_H
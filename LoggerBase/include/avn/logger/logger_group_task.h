@@ -37,7 +37,9 @@ _log.addString(WARNING, L"Warning message!");         // Outputs message at the
 #ifndef _AVN_LOGGER_LOGGER_GROUP_TASK_H
 #define _AVN_LOGGER_LOGGER_GROUP_TASK_H
 
+#include <string>
 #include <tuple>
+#include <utility>
 
 namespace ALogger {
 
@@ -113,6 +115,18 @@ namespace ALogger {
          */
         ALoggerGroupTask& addToLog(std::size_t level, const TLogData& data, std::chrono::system_clock::time_point time) noexcept;
 
+        /** Add the message for all tasks inside container
+         *
+         * Message is copied for all tasks except the last one, the last task gets the moved message.
+         *
+         * \param[in] level Message level
+         * \param[in] data Message to be output
+         * \param[in] time Message timestamp. Current time by default
+         *
+         * \return Current task group instance
+         */
+        ALoggerGroupTask& addToLog(std::size_t level, TLogData&& data, std::chrono::system_clock::time_point time = std::chrono::system_clock::now()) noexcept;
+
         /** Enable or disable specified logger level
          *
          * \param[in] level Message level to be disabled or enabled
@@ -146,6 +160,36 @@ namespace ALogger {
          */
         ALoggerGroupTask& disableLevel(std::size_t level) noexcept;
 
+        /** Set partial flush policy for all tasks inside container
+         *
+         * \param[in] policy Flush policy
+         *
+         * \return Current task group instance
+         */
+        ALoggerGroupTask& setFlushPolicy(const STaskFlushPolicy& policy) noexcept;
+
+        /** Output messages of enabled levels immediately for all tasks inside container
+         *
+         * \return Current task group instance
+         */
+        ALoggerGroupTask& flush() noexcept;
+
+        /** Set name for all tasks inside container
+         *
+         * \param[in] name Task name
+         *
+         * \return Current task group instance
+         */
+        ALoggerGroupTask& setName(const std::string& name) noexcept;
+
+        /** Set sampling for all tasks inside container
+         *
+         * \param[in] sampled All messages are output regardless of the task result
+         *
+         * \return Current task group instance
+         */
+        ALoggerGroupTask& setSampled(bool sampled) noexcept;
+
     private:
         TArrayPtr _task;
 
@@ -200,17 +244,55 @@ namespace ALogger {
             return *this;
     }
 
+    template< typename... _TTaskPtr >
+    ALoggerGroupTask<_TTaskPtr...>& ALoggerGroupTask<_TTaskPtr...>::setFlushPolicy(const STaskFlushPolicy& policy) noexcept
+    {
+        std::apply([&policy](auto&... task) { (task->setFlushPolicy(policy), ...); }, _task);
+        return *this;
+    }
+
+    template< typename... _TTaskPtr >
+    ALoggerGroupTask<_TTaskPtr...>& ALoggerGroupTask<_TTaskPtr...>::flush() noexcept
+    {
+        std::apply([](auto&... task) { (task->flush(), ...); }, _task);
+        return *this;
+    }
+
+    template< typename... _TTaskPtr >
+    ALoggerGroupTask<_TTaskPtr...>& ALoggerGroupTask<_TTaskPtr...>::setName(const std::string& name) noexcept
+    {
+        std::apply([&name](auto&... task) { (task->setName(name), ...); }, _task);
+        return *this;
+    }
+
+    template< typename... _TTaskPtr >
+    ALoggerGroupTask<_TTaskPtr...>& ALoggerGroupTask<_TTaskPtr...>::setSampled(bool sampled) noexcept
+    {
+        std::apply([sampled](auto&... task) { (task->setSampled(sampled), ...); }, _task);
+        return *this;
+    }
+
     template< typename... _TTaskPtr >
     ALoggerGroupTask<_TTaskPtr...>& ALoggerGroupTask<_TTaskPtr...>::addToLog(std::size_t level, const TLogData& data) noexcept
     {
-        std::apply([level,data](auto&... task) { (task->addToLog(level, data), ...); }, _task);
+        std::apply([&](auto&... task) { (task->addToLog(level, data), ...); }, _task);
         return *this;
     }
 
     template< typename... _TTaskPtr >
     ALoggerGroupTask<_TTaskPtr...>& ALoggerGroupTask<_TTaskPtr...>::addToLog(std::size_t level, const TLogData& data, std::chrono::system_clock::time_point time) noexcept
     {
-        std::apply([level,data,time](auto&... task) { (task->addToLog(level, data, time), ...); }, _task);
+        std::apply([&](auto&... task) { (task->addToLog(level, data, time), ...); }, _task);
+        return *this;
+    }
+
+    template< typename... _TTaskPtr >
+    ALoggerGroupTask<_TTaskPtr...>& ALoggerGroupTask<_TTaskPtr...>::addToLog(std::size_t level, TLogData&& data, std::chrono::system_clock::time_point time) noexcept
+    {
+        std::size_t index{0};
+        std::apply([&](auto&... task) {
+            ((++index == sizeof...(_TTaskPtr) ? task->addToLog(level, std::move(data), time) : task->addToLog(level, std::as_const(data), time)), ...);
+        }, _task);
         return *this;
     }
 
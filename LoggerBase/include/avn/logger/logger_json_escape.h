@@ -0,0 +1,199 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_json_escape.h
+ * \brief JSON and logfmt strings escaping.
+ *
+ * Most of logger messages do not contain characters to be escaped. #ALogger::JsonEscape::append scans the text for
+ * quotes, backslashes and control characters, copies clean spans as a whole and escapes only found characters. If
+ * SSE2 is available, text is scanned by 16 bytes at once.
+ *
+ * logfmt values are written as is if they do not contain spaces, equal signs, quotes and control characters.
+ * Otherwise they are quoted and escaped like JSON strings. logfmt keys can not be quoted, so such characters are
+ * replaced by underscores.
+ *
+ * \code
+
+    std::string out;
+    ALogger::JsonEscape::append(out, "Text with \"quotes\"");     // Text with \"quotes\"
+
+ * \endcode
+ */
+
+#ifndef _AVN_LOGGER_JSON_ESCAPE_H_
+#define _AVN_LOGGER_JSON_ESCAPE_H_
+
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AVN_LOGGER_JSON_ESCAPE_SSE2
+#endif
+
+namespace ALogger {
+
+    namespace JsonEscape {
+
+        /** Check that character has to be escaped or quoted
+         *
+         * \tparam _Logfmt Check space and equal sign too
+         * \param[in] ch Character
+         *
+         * \return True if character is special one
+         */
+        template<bool _Logfmt>
+        constexpr bool special(unsigned char ch) noexcept
+        {
+            return ch < 0x20 || ch == '"' || ch == '\\' || (_Logfmt && (ch == ' ' || ch == '='));
+        }
+
+        /** Find the first special character
+         *
+         * \tparam _Logfmt Find space and equal sign too
+         * \param[in] data Text
+         * \param[in] size Text size
+         *
+         * \return Special character position or \a size if there is no one
+         */
+        template<bool _Logfmt>
+        std::size_t find(const char* data, std::size_t size) noexcept
+        {
+            std::size_t pos{0};
+
+#ifdef AVN_LOGGER_JSON_ESCAPE_SSE2
+            const auto control{ _mm_set1_epi8(0x1F) };
+            const auto quote{ _mm_set1_epi8('"') };
+            const auto backslash{ _mm_set1_epi8('\\') };
+
+            for (; pos + 16 <= size; pos += 16) {
+                const auto chunk{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos)) };
+
+                // Unsigned ch <= 0x1F is equal to min(ch, 0x1F) == ch
+                auto found{ _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk),
+                                         _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash))) };
+                if constexpr (_Logfmt)
+                    found = _mm_or_si128(found, _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('='))));
+
+                auto mask{ static_cast<unsigned>(_mm_movemask_epi8(found)) };
+                if (mask != 0) {
+                    while ((mask & 1u) == 0) {
+                        mask >>= 1;
+                        ++pos;
+                    }
+                    return pos;
+                }
+            }
+#endif
+
+            for (; pos < size; ++pos)
+                if (special<_Logfmt>(static_cast<unsigned char>(data[pos])))
+                    return pos;
+
+            return size;
+        }
+
+        /** Append escaped JSON string content
+         *
+         * Quotes are not added.
+         *
+         * \param[out] out Output buffer
+         * \param[in] str Text
+         */
+        inline void append(std::string& out, std::string_view str) noexcept
+        {
+            const char* data{ str.data() };
+            std::size_t size{ str.size() };
+
+            while (size != 0) {
+                const auto clean{ find<false>(data, size) };
+                out.append(data, clean);
+
+                if (clean == size)
+                    break;
+
+                const auto ch{ static_cast<unsigned char>(data[clean]) };
+                switch (ch) {
+                case '"' :  out.append("\\\"", 2); break;
+                case '\\' : out.append("\\\\", 2); break;
+                case '\n' : out.append("\\n", 2); break;
+                case '\r' : out.append("\\r", 2); break;
+                case '\t' : out.append("\\t", 2); break;
+                case '\b' : out.append("\\b", 2); break;
+                case '\f' : out.append("\\f", 2); break;
+                default : {
+                    constexpr char hex[]{ "0123456789abcdef" };
+                    const char code[]{ '\\', 'u', '0', '0', hex[ch >> 4], hex[ch & 0x0F] };
+                    out.append(code, sizeof(code));
+                    break;
+                }
+                }
+
+                data += clean + 1;
+                size -= clean + 1;
+            }
+        }
+
+        /** Append JSON string with quotes
+         *
+         * \param[out] out Output buffer
+         * \param[in] str Text
+         */
+        inline void appendQuoted(std::string& out, std::string_view str) noexcept
+        {
+            out.push_back('"');
+            append(out, str);
+            out.push_back('"');
+        }
+
+        /** Append logfmt value
+         *
+         * Value is quoted only if it is empty or contains special characters.
+         *
+         * \param[out] out Output buffer
+         * \param[in] str Value
+         */
+        inline void appendLogfmt(std::string& out, std::string_view str) noexcept
+        {
+            if (!str.empty() && find<true>(str.data(), str.size()) == str.size())
+                out.append(str);
+            else
+                appendQuoted(out, str);
+        }
+
+        /** Append logfmt key
+         *
+         * Spaces, equal signs, quotes, backslashes and control characters are replaced by underscores. Empty key is
+         * written as one underscore.
+         *
+         * \param[out] out Output buffer
+         * \param[in] str Key
+         */
+        inline void appendLogfmtKey(std::string& out, std::string_view str) noexcept
+        {
+            if (str.empty()) {
+                out.push_back('_');
+                return;
+            }
+
+            const char* data{ str.data() };
+            std::size_t size{ str.size() };
+
+            while (size != 0) {
+                const auto clean{ find<true>(data, size) };
+                out.append(data, clean);
+
+                if (clean == size)
+                    break;
+
+                out.push_back('_');
+                data += clean + 1;
+                size -= clean + 1;
+            }
+        }
+
+    } // namespace JsonEscape
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_JSON_ESCAPE_H_
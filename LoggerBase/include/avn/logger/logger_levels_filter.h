@@ -0,0 +1,117 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_levels_filter.h
+ * \brief ALoggerLevelsFilter class is the early-out check of the loggers group.
+ *
+ * Group passes the message to each logger, and each logger reads the clock and checks its levels and tasks before the
+ * message is made. #ALogger::ALoggerLevelsFilter keeps the union mask of the group loggers levels, so the message
+ * that no logger wants is rejected by one check before the arguments are touched.
+ *
+ * Mask is recalculated after any level change of any logger. Loggers increase the global levels generation on each
+ * change, see #ALogger::SLevelsState, so levels changed directly by the group logger reference are taken into account
+ * too. If the current thread has an open task or an active shared task of any logger, the message is not rejected by
+ * the filter and each logger checks it as usual.
+ */
+
+#ifndef _AVN_LOGGER_LEVELS_FILTER_H_
+#define _AVN_LOGGER_LEVELS_FILTER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include <avn/logger/data_types.h>
+#include <avn/logger/logger_task_handle.h>
+
+namespace ALogger {
+
+    /** Levels and tasks state shared by all loggers
+     *
+     * It is for internal usage.
+     */
+    struct SLevelsState {
+        /** Levels amount the mask can hold. Greater levels are never rejected by the filter */
+        constexpr static std::size_t MaskLevels{ 64 };
+
+        /** Levels generation
+         *
+         * \return Generation increased on each levels change of any logger
+         */
+        static std::atomic<std::uint64_t>& generation() noexcept    { static std::atomic<std::uint64_t> value{1}; return value; }
+
+        /** Mark levels of some logger as changed */
+        static void changed() noexcept                              { generation().fetch_add(1, std::memory_order_release); }
+
+        /** Open thread-bound tasks of all loggers on the current thread
+         *
+         * \return Tasks amount reference
+         */
+        static std::size_t& threadTasks() noexcept                  { thread_local std::size_t count{0}; return count; }
+
+        /** Levels mask
+         *
+         * \param[in] levels Levels
+         *
+         * \return Mask with bits of levels less than #ALogger::SLevelsState::MaskLevels
+         */
+        static std::uint64_t mask(const TLevels& levels) noexcept
+        {
+            std::uint64_t mask{0};
+            for (const auto level : levels) {
+                if (level >= MaskLevels)
+                    break;
+                mask |= std::uint64_t{1} << level;
+            }
+            return mask;
+        }
+    };
+
+    /** Loggers group early-out filter
+     *
+     * Filter is thread safe.
+     */
+    class ALoggerLevelsFilter {
+    public:
+        /** Check that any logger may output the message
+         *
+         * \tparam TMask Function that returns the union mask of loggers levels, see #ALogger::SLevelsState::mask
+         *
+         * \param[in] level Message level
+         * \param[in] mask Mask function. It is called only after levels change
+         *
+         * \return False if no logger outputs the message
+         */
+        template<typename TMask>
+        bool test(std::size_t level, TMask mask) const noexcept;
+
+    private:
+        mutable std::mutex _mutex;
+        mutable std::atomic<std::uint64_t> _mask{0};
+        mutable std::atomic<std::uint64_t> _generation{0};     // 0 is never used by SLevelsState
+    };
+
+    template<typename TMask>
+    bool ALoggerLevelsFilter::test(std::size_t level, TMask mask) const noexcept
+    {
+        // Open task takes all messages, loggers check it themselves
+        if (level >= SLevelsState::MaskLevels || SLevelsState::threadTasks() != 0 || SActiveTask::top() != nullptr)
+            return true;
+
+        if (_generation.load(std::memory_order_acquire) != SLevelsState::generation().load(std::memory_order_acquire)) {
+            std::lock_guard lock(_mutex);
+
+            // Generation is read before levels, so the change made during the calculation leads to the next one
+            const auto generation{ SLevelsState::generation().load(std::memory_order_acquire) };
+            if (_generation.load(std::memory_order_relaxed) != generation) {
+                _mask.store(mask(), std::memory_order_relaxed);
+                _generation.store(generation, std::memory_order_release);
+            }
+        }
+
+        return (_mask.load(std::memory_order_relaxed) >> level) & 1u;
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_LEVELS_FILTER_H_
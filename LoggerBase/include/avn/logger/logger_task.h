@@ -49,36 +49,172 @@ logger.enableLevel(ALogger::ERROR);
 
  * \endcode
  *
+ * Task memory can be limited, see logger_task_spill.h. Messages of the task that exceeds the budget are moved to the
+ * temporary file and are read back at the task end.
+ *
+ * Long-lived task can output its messages partially, see #ALogger::STaskFlushPolicy. After the policy interval or
+ * entries amount the task outputs all messages of enabled levels immediately, because they are output regardless of
+ * the task result. Only messages that are output for failed task are kept till the task end. Like this the output is
+ * spread over the task life instead of the burst at its end. Note that messages of disabled levels are output after
+ * all flushed ones if the task fails.
+ *
+ * \code
+
+{
+  auto task = logger.addTask();
+  task.setFlushPolicy({ std::chrono::seconds(5), 1000 });   // Flush each 5 seconds or each 1000 messages
+
+  for (const auto& item : items)
+    logger.Output(ALogger::INFO, item);                      // INFO messages are output during the task
+}
+
+ * \endcode
+ *
+ * Tasks that are open too long are reported by the watchdog, see logger_task_watchdog.h.
+ *
+ * Tasks are recorded as tracing spans if the logger has the trace, see logger_task_trace.h.
+ *
+ * Succeeded tasks output enabled levels only, so healthy requests are never seen in details. Sampled task outputs all
+ * its messages like the failed one, see #ALogger::STaskSampling and #ALogger::ALoggerBase::addTask overload with
+ * sampling.
+ *
+ * Nested task does not output its messages at its end if the enclosing task of the same thread is still open. Messages
+ * that survive the nested task result are handed to the enclosing task, other ones are released. All messages of the
+ * failed or sampled nested task survive and are output regardless of the enclosing task result, messages of the
+ * succeeded one are output at the outermost task end according to its result. Message storage is the chunk list, see
+ * logger_task_chunks.h, so the nested task storage is appended to the enclosing one without messages copying.
  */
 
 #ifndef _AVN_LOGGER_BASE_TASK_H_
 #define _AVN_LOGGER_BASE_TASK_H_
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <avn/logger/data_types.h>
+#include <avn/logger/logger_task_chunks.h>
+#include <avn/logger/logger_task_spill.h>
+#include <avn/logger/logger_task_trace.h>
+#include <avn/logger/logger_task_watchdog.h>
 
 namespace ALogger {
 
     template<typename _TLogData> class ALoggerTask;
     template<typename _TLogData> class ILoggerGroup;
+    template<typename _TLogData> class ALoggerSharedTask;
+
+    /** Task partial flush policy
+     *
+     * Task messages of enabled levels are output when any of limits is reached. All zeros disable partial flush.
+     *
+     * Limits are checked when the task adds a message. Task is not synchronized, so it is never flushed from other
+     * threads, and the stuck task that adds nothing is not flushed by the interval. Use #ALogger::ALoggerTaskWatchdog
+     * to report such tasks.
+     */
+    struct STaskFlushPolicy {
+        std::chrono::steady_clock::duration _interval{0};   ///< Time since the last flush. 0 if not used
+        std::size_t _entries{0};                            ///< Messages amount since the last flush. 0 if not used
+
+        /** Check that partial flush is enabled
+         *
+         * \return True if any limit is set
+         */
+        bool enabled() const noexcept   { return _interval.count() != 0 || _entries != 0; }
+    };
+
+    /** Succeeded tasks sampling
+     *
+     * Sampled task outputs all messages regardless of its result. Decision is made once at the task creation: either
+     * each \a _rate task of the logger is sampled or the task is sampled by the key hash, so all tasks with the same
+     * key, say, request identifier, are sampled in all processes.
+     */
+    struct STaskSampling {
+        std::size_t _rate{0};       ///< One of \a _rate tasks is sampled. 0 disables sampling
+        std::uint64_t _hash{0};     ///< Key hash, see #ALogger::STaskSampling::byKey
+        bool _keyed{false};         ///< Task is sampled by the key hash instead of the counter
+
+        /** Constructor without sampling
+         *
+         * It is user provided, so sampling is not an aggregate and braced levels list like addTask({1}, true) is not
+         * ambiguous.
+         */
+        STaskSampling() noexcept {}
+
+        /** Sample one of \a rate tasks
+         *
+         * \param[in] rate Sampling rate
+         *
+         * \return Sampling
+         */
+        static STaskSampling oneIn(std::size_t rate) noexcept                       { STaskSampling sampling; sampling._rate = rate; return sampling; }
+
+        /** Sample tasks by the key
+         *
+         * Hash is FNV-1a, so it is the same on all platforms and in all runs.
+         *
+         * \param[in] key Task key
+         * \param[in] rate Sampling rate
+         *
+         * \return Sampling
+         */
+        static STaskSampling byKey(std::string_view key, std::size_t rate) noexcept
+        {
+            std::uint64_t hash{ 0xcbf29ce484222325ull };
+            for (const char ch : key)
+                hash = (hash ^ static_cast<unsigned char>(ch)) * 0x100000001b3ull;
+            STaskSampling sampling;
+            sampling._rate = rate;
+            sampling._hash = hash;
+            sampling._keyed = true;
+            return sampling;
+        }
+
+        /** Make sampling decision
+         *
+         * \param[in,out] counter Tasks counter of the logger
+         *
+         * \return True if the task is sampled
+         */
+        bool sample(std::atomic<std::size_t>& counter) const noexcept
+        {
+            if (_rate == 0)
+                return false;
+            if (_keyed)
+                return _hash % _rate == 0;
+            return counter.fetch_add(1, std::memory_order_relaxed) % _rate == 0;
+        }
+    };
 
     /** Interface for internal usage */
     template<typename _TLogData>
     class ITaskLogger{
         friend class ALoggerTask<_TLogData>;
+        friend class ALoggerSharedTask<_TLogData>;
 
     protected:
-        ALoggerTask<_TLogData> createTask(bool init_success_state) noexcept
+        ALoggerTask<_TLogData> createTask(bool init_success_state, ALoggerTask<_TLogData>* parent = nullptr,
+                                          ALoggerSharedTask<_TLogData>* shared = nullptr) noexcept
         {
-            return ALoggerTask<_TLogData>(*this, init_success_state);
+            return ALoggerTask<_TLogData>(*this, init_success_state, parent, shared);
         };
 
     private:
         virtual const TLevels& levels() const noexcept = 0;
         virtual bool forceAddToLog(std::size_t level, const _TLogData& data, std::chrono::system_clock::time_point time) noexcept = 0;
+        virtual bool forceAddToLog(std::size_t level, _TLogData&& data, std::chrono::system_clock::time_point time) noexcept = 0;
         virtual void removeTask() noexcept = 0;
+        virtual ALoggerSpillBudget& taskSpillBudget() noexcept = 0;
+        virtual const STaskFlushPolicy& taskFlushPolicy() const noexcept = 0;
+        virtual ALoggerTaskRegistry& taskRegistry() noexcept = 0;
+        virtual ALoggerTrace* taskTrace() noexcept = 0;
     };
 
     /** ALogger task
@@ -93,9 +229,19 @@ namespace ALogger {
         friend class ILoggerGroup<_TLogData>;
 
     private:
-        ALoggerTask(ITaskLogger<_TLogData>& logger, bool init_succeeded) noexcept :
-                _successState(init_succeeded), _logger(logger), _outLevels(logger.levels())
-            {}
+        ALoggerTask(ITaskLogger<_TLogData>& logger, bool init_succeeded, ALoggerTask* parent, ALoggerSharedTask<_TLogData>* shared) noexcept :
+                _logger(logger), _parent(parent), _shared(shared), _outLevels(logger.levels()), _budget(logger.taskSpillBudget()),
+                _flushPolicy(logger.taskFlushPolicy()), _registry(logger.taskRegistry()), _registryId(_registry.add()),
+                _trace(logger.taskTrace()), _successState(init_succeeded)
+        {
+            if (_flushPolicy._interval.count() != 0)
+                _lastFlush = std::chrono::steady_clock::now();
+
+            if (_trace != nullptr) {
+                _traceThread = _trace->begin(_depth);
+                _start = std::chrono::steady_clock::now();
+            }
+        }
 
     public:
         /** ALogger data type */
@@ -103,7 +249,7 @@ namespace ALogger {
 
         ALoggerTask() = delete;
         ALoggerTask(const ALoggerTask&) = delete;
-        ALoggerTask(ALoggerTask&&) noexcept = default;
+        ALoggerTask(ALoggerTask&& task) noexcept;
 
         ALoggerTask operator=(const ALoggerTask&) = delete;
         ALoggerTask operator=(ALoggerTask&&) = delete;
@@ -122,11 +268,25 @@ namespace ALogger {
         /** Get task result */
         bool TaskResult() const noexcept                             { return _successState; }
 
+        /** Output all messages regardless of the task result
+         *
+         * \param[in] sampled Task is sampled
+         *
+         * \return Current task instance
+         */
+        ALoggerTask& setSampled(bool sampled) noexcept               { _sampled = sampled; return *this; }
+
+        /** Check that task is sampled
+         *
+         * \return True if all messages are output regardless of the task result
+         */
+        bool sampled() const noexcept                                { return _sampled; }
+
         /** Output the message
          *
          * Message could be output at the task end.
          *
-         * Message will be owned by logger.
+         * Message will be owned by logger. Rvalue message is moved into the task storage without copying.
          *
          * \param[in] level Message level
          * \param[in] data Message to be output
@@ -170,23 +330,137 @@ namespace ALogger {
          */
         ALoggerTask& disableLevel(std::size_t level) noexcept { initLevel(level, false); return *this; }
 
+        /** Spilled messages amount
+         *
+         * \return Messages amount that are kept in the spill file and are not output yet
+         */
+        std::size_t spilledEntries() const noexcept                 { return _spilled; }
+
+        /** Task memory accounted by the spill budget
+         *
+         * \return Memory of in-memory messages in bytes
+         */
+        std::size_t memory() const noexcept                         { return _memory; }
+
+        /** Set partial flush policy
+         *
+         * Logger policy is used by default, see #ALogger::ALoggerBase::setTaskFlushPolicy.
+         *
+         * \param[in] policy Flush policy
+         *
+         * \return Current task instance
+         */
+        ALoggerTask& setFlushPolicy(const STaskFlushPolicy& policy) noexcept;
+
+        /** Output messages of enabled levels immediately
+         *
+         * Messages that are output only if the task fails are kept.
+         *
+         * \return Current task instance
+         */
+        ALoggerTask& flush() noexcept;
+
+        /** Partial flushes amount
+         *
+         * \return Amount of #ALogger::ALoggerTask::flush calls including ones made by the flush policy
+         */
+        std::size_t flushes() const noexcept                        { return _flushes; }
+
+        /** Set task name
+         *
+         * Name is used as the tracing span name, see logger_task_trace.h. It is "task" by default.
+         *
+         * \param[in] name Task name
+         *
+         * \return Current task instance
+         */
+        ALoggerTask& setName(std::string name) noexcept             { _name = std::move(name); return *this; }
+
+        /** Task name
+         *
+         * \return Task name. Empty if it is not set
+         */
+        const std::string& name() const noexcept                    { return _name; }
+
     private:
+        using TCodec = SSpillCodec<_TLogData>;
+
         struct SLogEntry {
             template<typename TData>
-            SLogEntry(std::size_t level, TData data, std::chrono::system_clock::time_point time) noexcept :
+            SLogEntry(std::size_t level, TData&& data, std::chrono::system_clock::time_point time) noexcept :
                     _time(time), _level(level), _data(std::forward<TData>(data)) {}
 
             std::chrono::system_clock::time_point _time;
             std::size_t _level;
+            bool _forced{false};        // Message of the failed or sampled nested task, it is output regardless of the result
             _TLogData _data;
         };
 
+        using TEntries = ALoggerChunkList<SLogEntry>;
+
         ITaskLogger<_TLogData>& _logger;
+        ALoggerTask* _parent{nullptr};
+        ALoggerSharedTask<_TLogData>* _shared{nullptr};    // Active shared task the outermost task is opened in
         TLevels _outLevels;
-        std::vector<SLogEntry> _logEntries;
+        TEntries _logEntries;
+        ALoggerSpillBudget& _budget;
+        std::unique_ptr<ALoggerSpillFile> _spill;
+        std::size_t _memory{0};         // Bytes accounted by _budget
+        std::size_t _spilled{0};        // Spilled messages that are not output yet
+        bool _spillFailed{false};
+        std::size_t _spillAt{0};        // Task memory to be reached before the next spill
+        std::uint64_t _spillRead{0};    // Position of the first record that is not read by partial flushes
+        std::size_t _spillReadIndex{0}; // Index of that record
+        std::vector<bool> _spillOutput; // Spilled messages output by partial flushes, one flag per record
+        STaskFlushPolicy _flushPolicy;
+        std::chrono::steady_clock::time_point _lastFlush;
+        std::size_t _unflushed{0};      // Messages added since the last flush
+        std::size_t _flushes{0};
+        ALoggerTaskRegistry& _registry;
+        std::uint64_t _registryId;
+        ALoggerTrace* _trace;
+        ALoggerTrace::TThread _traceThread{nullptr};
+        std::string _name;
+        std::chrono::steady_clock::time_point _start;
+        std::uint32_t _depth{0};
+        std::size_t _entries{0};
         bool _successState;
+        bool _sampled{false};
+
+        bool fullOutput() const noexcept                            { return !_successState || _sampled; }
+        bool unconditional(std::size_t level, bool forced) const noexcept       { return forced || _outLevels.count(level); }
+        bool toBeOutput(std::size_t level, bool forced = false) const noexcept  { return fullOutput() || unconditional(level, forced); }
+        void spill() noexcept;
+        void outputSpilled() noexcept;
+        void readSpilled(TEntries& entries) noexcept;
+        void flushSpilled() noexcept;
+        void adopt(ALoggerTask& task) noexcept;
+        std::size_t takeSurvived(TEntries& entries, bool account) noexcept;
+        bool toBeFlushed() noexcept;
+        std::size_t entryMemory(const SLogEntry& entry) const noexcept;
     };
 
+    template<typename _TLogData>
+    ALoggerTask<_TLogData>::ALoggerTask(ALoggerTask&& task) noexcept :
+            _logger(task._logger), _parent(task._parent), _shared(task._shared), _outLevels(std::move(task._outLevels)), _logEntries(std::move(task._logEntries)),
+            _budget(task._budget), _spill(std::move(task._spill)), _memory(std::exchange(task._memory, 0)),
+            _spilled(task._spilled), _spillFailed(task._spillFailed), _spillAt(task._spillAt), _spillRead(task._spillRead),
+            _spillReadIndex(task._spillReadIndex), _spillOutput(std::move(task._spillOutput)), _flushPolicy(task._flushPolicy),
+            _lastFlush(task._lastFlush), _unflushed(task._unflushed), _flushes(task._flushes), _registry(task._registry),
+            _registryId(std::exchange(task._registryId, 0)), _trace(std::exchange(task._trace, nullptr)),
+            _traceThread(task._traceThread), _name(std::move(task._name)), _start(task._start), _depth(task._depth),
+            _entries(task._entries), _successState(task._successState), _sampled(task._sampled)
+    {}
+
+    template<typename _TLogData>
+    ALoggerTask<_TLogData>& ALoggerTask<_TLogData>::setFlushPolicy(const STaskFlushPolicy& policy) noexcept
+    {
+        _flushPolicy = policy;
+        _lastFlush = std::chrono::steady_clock::now();
+        _unflushed = 0;
+        return *this;
+    }
+
     template<typename _TLogData>
     ALoggerTask<_TLogData>& ALoggerTask<_TLogData>::initLevel(std::size_t level, bool to_enable) noexcept
     {
@@ -199,19 +473,309 @@ namespace ALogger {
     template<typename TData>
     ALoggerTask<_TLogData>& ALoggerTask<_TLogData>::addToLog(std::size_t level, TData&& data, std::chrono::system_clock::time_point time) noexcept
     {
-        _logEntries.emplace_back(level, std::forward<TData>(data), time);
+        const auto& entry{ _logEntries.emplace_back(level, std::forward<TData>(data), time) };
+        ++_entries;
+
+        if constexpr (TCodec::Supported) {
+            if (_budget.limited()) {
+                const auto bytes{ entryMemory(entry) };
+                _memory += bytes;
+                if (_budget.add(bytes, _memory) && _memory >= _spillAt && !_spillFailed)
+                    spill();
+            }
+        }
+
+        if (_flushPolicy.enabled() && toBeFlushed())
+            flush();
+
+        return *this;
+    }
+
+    template<typename _TLogData>
+    std::size_t ALoggerTask<_TLogData>::entryMemory(const SLogEntry& entry) const noexcept
+    {
+        if constexpr (TCodec::Supported)
+            return sizeof(SLogEntry) + TCodec::memory(entry._data);
+        else
+            return 0;
+    }
+
+    template<typename _TLogData>
+    bool ALoggerTask<_TLogData>::toBeFlushed() noexcept
+    {
+        ++_unflushed;
+
+        if (_flushPolicy._entries != 0 && _unflushed >= _flushPolicy._entries)
+            return true;
+
+        return _flushPolicy._interval.count() != 0 && std::chrono::steady_clock::now() - _lastFlush >= _flushPolicy._interval;
+    }
+
+    template<typename _TLogData>
+    ALoggerTask<_TLogData>& ALoggerTask<_TLogData>::flush() noexcept
+    {
+        flushSpilled();
+
+        // Messages of enabled levels are output, other ones are kept in the same order
+        std::size_t released{0};
+
+        _logEntries.eraseIf([&](SLogEntry& entry) {
+            if (!unconditional(entry._level, entry._forced))
+                return false;
+
+            if (_memory != 0)
+                released += entryMemory(entry);
+            _logger.forceAddToLog(entry._level, std::move(entry._data), entry._time);
+            return true;
+        });
+
+        released = std::min(released, _memory);
+        _budget.release(released);
+        _memory -= released;
+
+        if (_flushPolicy._interval.count() != 0)
+            _lastFlush = std::chrono::steady_clock::now();
+        _unflushed = 0;
+        ++_flushes;
+
         return *this;
     }
 
+    template<typename _TLogData>
+    void ALoggerTask<_TLogData>::spill() noexcept
+    {
+        if constexpr (TCodec::Supported) {
+            if (!_spill)
+                _spill = std::make_unique<ALoggerSpillFile>();
+
+            if (!_spill->isOpened()) {
+                _spillFailed = true;
+                return;
+            }
+
+            // Oldest messages are spilled down to the low watermark, so spilled ones are always older than in-memory ones
+            const auto excess{ _budget.excess(_memory) };
+            std::string bytes;
+            std::string payload;
+            std::size_t released{0};
+            std::size_t count{0};
+
+            for (const auto& entry : _logEntries) {
+                if (released >= excess && count != 0)
+                    break;
+
+                released += entryMemory(entry);
+                ++count;
+
+                payload.clear();
+                TCodec::encode(payload, entry._data);
+                ALoggerSpillFile::header(bytes, entry._time.time_since_epoch().count(), ALoggerSpillFile::level(entry._level, entry._forced),
+                                         static_cast<std::uint32_t>(payload.size()));
+                bytes.append(payload);
+            }
+
+            if (!_spill->write(bytes)) {
+                _spillFailed = true;
+                return;
+            }
+
+            _logEntries.eraseFront(count);
+
+            released = std::min(released, _memory);
+            _budget.release(released);
+            _memory -= released;
+            _spilled += count;
+            _spillOutput.resize(_spillOutput.size() + count, false);
+            _spillAt = _memory + _budget.hysteresis();
+        }
+    }
+
+    template<typename _TLogData>
+    void ALoggerTask<_TLogData>::outputSpilled() noexcept
+    {
+        if constexpr (TCodec::Supported) {
+            if (!_spill || _spilled == 0)
+                return;
+
+            _spill->rewind();
+
+            std::int64_t ticks;
+            std::uint64_t level;
+            std::uint32_t size;
+            std::string payload;
+
+            for (std::size_t index = 0; _spill->readHeader(ticks, level, size); ++index) {
+                const auto forced{ ALoggerSpillFile::forced(level) };
+                if ((index < _spillOutput.size() && _spillOutput[index]) || !toBeOutput(static_cast<std::size_t>(level), forced)) {
+                    if (!_spill->skipPayload(size))
+                        break;
+                    continue;
+                }
+
+                if (!_spill->readPayload(payload, size))
+                    break;
+
+                const std::chrono::system_clock::time_point time{ std::chrono::system_clock::duration(ticks) };
+                _logger.forceAddToLog(static_cast<std::size_t>(level), TCodec::decode(payload), time);
+            }
+
+            _spill.reset();
+        }
+    }
+
+    template<typename _TLogData>
+    void ALoggerTask<_TLogData>::flushSpilled() noexcept
+    {
+        if constexpr (TCodec::Supported) {
+            if (!_spill || _spilled == 0)
+                return;
+
+            // Records before the read position are output or kept till the task end, only new ones are read
+            if (!_spill->seek(_spillRead))
+                return;
+
+            std::int64_t ticks;
+            std::uint64_t level;
+            std::uint32_t size;
+            std::string payload;
+            while (_spill->readHeader(ticks, level, size)) {
+                const auto forced{ ALoggerSpillFile::forced(level) };
+                if (unconditional(static_cast<std::size_t>(level), forced)) {
+                    if (!_spill->readPayload(payload, size))
+                        break;
+
+                    const std::chrono::system_clock::time_point time{ std::chrono::system_clock::duration(ticks) };
+                    _logger.forceAddToLog(static_cast<std::size_t>(level), TCodec::decode(payload), time);
+                    if (_spillReadIndex < _spillOutput.size())
+                        _spillOutput[_spillReadIndex] = true;
+                    --_spilled;
+                } else if (!_spill->skipPayload(size)) {
+                    break;
+                }
+
+                _spillRead += ALoggerSpillFile::HeaderSize + size;
+                ++_spillReadIndex;
+            }
+        }
+    }
+
+    template<typename _TLogData>
+    void ALoggerTask<_TLogData>::readSpilled(TEntries& entries) noexcept
+    {
+        if constexpr (TCodec::Supported) {
+            if (!_spill || _spilled == 0)
+                return;
+
+            _spill->rewind();
+
+            std::int64_t ticks;
+            std::uint64_t level;
+            std::uint32_t size;
+            std::string payload;
+
+            for (std::size_t index = 0; _spill->readHeader(ticks, level, size); ++index) {
+                const auto forced{ ALoggerSpillFile::forced(level) };
+                if ((index < _spillOutput.size() && _spillOutput[index]) || !toBeOutput(static_cast<std::size_t>(level), forced)) {
+                    if (!_spill->skipPayload(size))
+                        break;
+                    continue;
+                }
+
+                if (!_spill->readPayload(payload, size))
+                    break;
+
+                const std::chrono::system_clock::time_point time{ std::chrono::system_clock::duration(ticks) };
+                entries.emplace_back(static_cast<std::size_t>(level), TCodec::decode(payload), time)._forced = forced;
+            }
+
+            _spill.reset();
+            _spilled = 0;
+            _spillRead = 0;
+            _spillReadIndex = 0;
+            _spillOutput.clear();
+        }
+    }
+
+    template<typename _TLogData>
+    std::size_t ALoggerTask<_TLogData>::takeSurvived(TEntries& entries, bool account) noexcept
+    {
+        // Spilled messages are older than in-memory ones. They are filtered by the same rule
+        readSpilled(entries);
+
+        std::size_t spilled_bytes{0};
+        if (account) {
+            for (const auto& entry : entries)
+                spilled_bytes += entryMemory(entry);
+        }
+
+        // Messages that do not survive the task are released now, survived ones of the failed or sampled task are
+        // output regardless of the enclosing task result
+        if (fullOutput()) {
+            for (auto& entry : _logEntries)
+                entry._forced = true;
+            for (auto& entry : entries)
+                entry._forced = true;
+        } else {
+            std::size_t released{0};
+            _logEntries.eraseIf([&](const SLogEntry& entry) {
+                if (toBeOutput(entry._level, entry._forced))
+                    return false;
+                if (_memory != 0)
+                    released += entryMemory(entry);
+                return true;
+            });
+
+            released = std::min(released, _memory);
+            _budget.release(released);
+            _memory -= released;
+        }
+
+        entries.splice(_logEntries);
+        return spilled_bytes;
+    }
+
+    template<typename _TLogData>
+    void ALoggerTask<_TLogData>::adopt(ALoggerTask& task) noexcept
+    {
+        TEntries entries;
+        const auto spilled_bytes{ task.takeSurvived(entries, _budget.limited()) };
+        _logEntries.splice(entries);
+
+        // Nested task memory is accounted by the budget already, only its spilled messages are added
+        _memory += task._memory + spilled_bytes;
+        task._memory = 0;
+
+        if (_budget.limited() && _budget.add(spilled_bytes, _memory) && _memory >= _spillAt && !_spillFailed)
+            spill();
+    }
+
     template<typename _TLogData>
     ALoggerTask<_TLogData>::~ALoggerTask() noexcept
     {
-        for (auto& entry : _logEntries) {
-            if (!_successState || _outLevels.count(entry._level ))
-                _logger.forceAddToLog(entry._level, std::move(entry._data), entry._time);
+        // Span covers the task work, not its output
+        if (_trace != nullptr)
+            _trace->end(_traceThread, { _name.empty() ? "task" : std::move(_name), _start, std::chrono::steady_clock::now(), 0, _depth, _entries, _successState });
+
+        if (_parent != nullptr) {
+            _parent->adopt(*this);
+        } else if (_shared != nullptr) {
+            // Shared task is not bound to the thread, so survived messages are added to it one by one
+            TEntries entries;
+            takeSurvived(entries, false);
+            for (auto& entry : entries)
+                _shared->addToLog(entry._level, std::move(entry._data), entry._time, entry._forced);
+        } else {
+            outputSpilled();
+
+            for (auto& entry : _logEntries) {
+                if (toBeOutput(entry._level, entry._forced))
+                    _logger.forceAddToLog(entry._level, std::move(entry._data), entry._time);
+            }
         }
 
         _logEntries.clear();
+        _budget.release(_memory);
+        _registry.remove(_registryId);
         _logger.removeTask();
     }
 
@@ -0,0 +1,232 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_task_chunks.h
+ * \brief ALoggerChunkList class implements the task messages storage.
+ *
+ * Task messages are stored in the list of fixed capacity chunks. Messages are never relocated when the task grows,
+ * unlike in std::vector, and the whole storage of the nested task is appended to the enclosing task by
+ * #ALogger::ALoggerChunkList::splice call without touching messages.
+ */
+
+#ifndef _AVN_LOGGER_TASK_CHUNKS_H_
+#define _AVN_LOGGER_TASK_CHUNKS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace ALogger {
+
+    /** List of chunks
+     *
+     * \tparam T Item type
+     * \tparam _ChunkSize Items amount in one chunk
+     */
+    template<typename T, std::size_t _ChunkSize = 64>
+    class ALoggerChunkList {
+        struct SChunk {
+            SChunk() noexcept                       { _items.reserve(_ChunkSize); }
+
+            std::vector<T> _items;
+            SChunk* _next{nullptr};
+        };
+
+    public:
+        /** Forward iterator */
+        class iterator {
+            friend class ALoggerChunkList;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+
+            reference operator*() const noexcept                    { return _chunk->_items[_index]; }
+            pointer operator->() const noexcept                     { return &_chunk->_items[_index]; }
+            iterator& operator++() noexcept                         { ++_index; skipEmpty(); return *this; }
+            bool operator==(const iterator& it) const noexcept      { return _chunk == it._chunk && _index == it._index; }
+            bool operator!=(const iterator& it) const noexcept      { return !(*this == it); }
+
+        private:
+            SChunk* _chunk{nullptr};
+            std::size_t _index{0};
+
+            explicit iterator(SChunk* chunk) noexcept : _chunk(chunk)  { skipEmpty(); }
+
+            void skipEmpty() noexcept
+            {
+                while (_chunk != nullptr && _index == _chunk->_items.size()) {
+                    _chunk = _chunk->_next;
+                    _index = 0;
+                }
+            }
+        };
+
+        ALoggerChunkList() noexcept = default;
+        ALoggerChunkList(const ALoggerChunkList&) = delete;
+        ALoggerChunkList& operator=(const ALoggerChunkList&) = delete;
+
+        ALoggerChunkList(ALoggerChunkList&& list) noexcept :
+                _head(std::exchange(list._head, nullptr)), _tail(std::exchange(list._tail, nullptr)), _size(std::exchange(list._size, 0))
+        {}
+
+        ALoggerChunkList& operator=(ALoggerChunkList&& list) noexcept;
+
+        ~ALoggerChunkList() noexcept                                { clear(); }
+
+        /** Add item at the end
+         *
+         * \param[in] args Item constructor arguments
+         *
+         * \return Added item
+         */
+        template<typename... TArgs>
+        T& emplace_back(TArgs&&... args) noexcept;
+
+        /** The last item */
+        T& back() noexcept                                          { return _tail->_items.back(); }
+
+        /** Items amount */
+        std::size_t size() const noexcept                           { return _size; }
+
+        /** Check that there are no items */
+        bool empty() const noexcept                                 { return _size == 0; }
+
+        iterator begin() const noexcept                             { return iterator(_head); }
+        iterator end() const noexcept                               { return iterator(nullptr); }
+
+        /** Remove all items */
+        void clear() noexcept;
+
+        /** Move all items of \a list to the end
+         *
+         * Chunks are linked, items are not moved.
+         *
+         * \param[in,out] list Items to be appended. It is empty after the call
+         */
+        void splice(ALoggerChunkList& list) noexcept;
+
+        /** Remove the first items
+         *
+         * Whole chunks are released, items of the first remaining chunk are shifted.
+         *
+         * \param[in] count Items amount to be removed
+         */
+        void eraseFront(std::size_t count) noexcept;
+
+        /** Remove items that match the predicate
+         *
+         * Order of the remaining items is kept.
+         *
+         * \param[in] pred Predicate
+         */
+        template<typename TPred>
+        void eraseIf(TPred pred) noexcept;
+
+    private:
+        SChunk* _head{nullptr};
+        SChunk* _tail{nullptr};
+        std::size_t _size{0};
+    };
+
+    template<typename T, std::size_t _ChunkSize>
+    ALoggerChunkList<T, _ChunkSize>& ALoggerChunkList<T, _ChunkSize>::operator=(ALoggerChunkList&& list) noexcept
+    {
+        if (this != &list) {
+            clear();
+            _head = std::exchange(list._head, nullptr);
+            _tail = std::exchange(list._tail, nullptr);
+            _size = std::exchange(list._size, 0);
+        }
+        return *this;
+    }
+
+    template<typename T, std::size_t _ChunkSize>
+    template<typename... TArgs>
+    T& ALoggerChunkList<T, _ChunkSize>::emplace_back(TArgs&&... args) noexcept
+    {
+        // Spliced tail chunk can be partially filled, it is filled up before the next chunk is added
+        if (_tail == nullptr || _tail->_items.size() >= _ChunkSize) {
+            auto* chunk{ new SChunk };
+            if (_tail != nullptr)
+                _tail->_next = chunk;
+            else
+                _head = chunk;
+            _tail = chunk;
+        }
+
+        ++_size;
+        return _tail->_items.emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    template<typename T, std::size_t _ChunkSize>
+    void ALoggerChunkList<T, _ChunkSize>::clear() noexcept
+    {
+        while (_head != nullptr)
+            delete std::exchange(_head, _head->_next);
+
+        _tail = nullptr;
+        _size = 0;
+    }
+
+    template<typename T, std::size_t _ChunkSize>
+    void ALoggerChunkList<T, _ChunkSize>::splice(ALoggerChunkList& list) noexcept
+    {
+        if (list._head == nullptr)
+            return;
+
+        if (_tail != nullptr)
+            _tail->_next = list._head;
+        else
+            _head = list._head;
+
+        _tail = list._tail;
+        _size += list._size;
+
+        list._head = list._tail = nullptr;
+        list._size = 0;
+    }
+
+    template<typename T, std::size_t _ChunkSize>
+    void ALoggerChunkList<T, _ChunkSize>::eraseFront(std::size_t count) noexcept
+    {
+        count = std::min(count, _size);
+        _size -= count;
+
+        while (count != 0) {
+            auto& items{ _head->_items };
+            if (count < items.size()) {
+                items.erase(items.begin(), items.begin() + static_cast<std::ptrdiff_t>(count));
+                break;
+            }
+
+            count -= items.size();
+            delete std::exchange(_head, _head->_next);
+        }
+
+        if (_head == nullptr)
+            _tail = nullptr;
+    }
+
+    template<typename T, std::size_t _ChunkSize>
+    template<typename TPred>
+    void ALoggerChunkList<T, _ChunkSize>::eraseIf(TPred pred) noexcept
+    {
+        ALoggerChunkList kept;
+
+        for (auto& item : *this) {
+            if (!pred(item))
+                kept.emplace_back(std::move(item));
+        }
+
+        *this = std::move(kept);
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_TASK_CHUNKS_H_
@@ -0,0 +1,280 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_task_handle.h
+ * \brief ALoggerTaskHandle class implements tasks that are not bound to the thread.
+ *
+ * #ALogger::ALoggerTask is bound to the thread that creates it. Request of the thread pool or of the asynchronous
+ * executor runs its continuations on different threads, so its messages escape the task. Shared task is created by
+ * #ALogger::ALoggerBase::addSharedTask call. It returns #ALogger::ALoggerTaskHandle that can be copied and captured
+ * by continuations. Continuation activates the task on its thread by #ALogger::ALoggerBase::activate call, and all
+ * messages of this logger added by the thread go to the shared task until the returned scope object is destroyed.
+ *
+ * Messages are appended to the task by the lock-free list, so several threads can add messages simultaneously. Task
+ * outputs its messages in the addition order when the last handle or scope is released, like #ALogger::ALoggerTask
+ * does at its end.
+ *
+ * \code
+
+    auto task{ logger.addSharedTask() };
+
+    executor.post([&logger, task]() {
+        auto scope{ logger.activate(task) };
+
+        logger.Output(ALogger::DEBUG, msg1);    // Message is added to the shared task
+        task.succeeded();
+    });
+
+ * \endcode
+ *
+ * Thread-bound task created inside the active scope gets messages until its end as usual. At its end messages that
+ * survive its result are handed to the shared task, like the nested task hands them to the enclosing one, so they are
+ * output according to the shared task levels and result.
+ */
+
+#ifndef _AVN_LOGGER_TASK_HANDLE_H_
+#define _AVN_LOGGER_TASK_HANDLE_H_
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <memory>
+#include <utility>
+
+#include <avn/logger/data_types.h>
+#include <avn/logger/logger_task.h>
+
+namespace ALogger {
+
+    template<bool _ThrSafe, typename _TLogData> class ALoggerBase;
+
+    /** Active shared task frame of the thread
+     *
+     * Frames make the thread-local stack. It is for internal usage.
+     */
+    struct SActiveTask {
+        const void* _logger;            ///< Logger the task belongs to
+        void* _task;                    ///< Shared task
+        std::size_t _localTasks;        ///< Thread-bound tasks of the logger opened inside the frame
+        SActiveTask* _previous;         ///< Previous frame
+
+        /** Top frame of the current thread
+         *
+         * \return Top frame pointer reference
+         */
+        static SActiveTask*& top() noexcept                         { thread_local SActiveTask* frame{nullptr}; return frame; }
+
+        /** Find the top frame of the logger
+         *
+         * \param[in] logger Logger
+         *
+         * \return Frame or null pointer if the logger has no active shared task on the current thread
+         */
+        static SActiveTask* find(const void* logger) noexcept
+        {
+            for (auto* frame{ top() }; frame != nullptr; frame = frame->_previous) {
+                if (frame->_logger == logger)
+                    return frame;
+            }
+            return nullptr;
+        }
+    };
+
+    /** Shared task
+     *
+     * It is created by #ALogger::ALoggerBase::addSharedTask call and is owned by #ALogger::ALoggerTaskHandle handles.
+     *
+     * \tparam _TLogData ALogger data type
+     */
+    template<typename _TLogData>
+    class ALoggerSharedTask {
+    public:
+        /** Constructor
+         *
+         * \param[in] logger Logger. It has to outlive the task
+         * \param[in] levels Levels to be output if the task succeeds
+         * \param[in] init_succeeded Initial task result
+         */
+        ALoggerSharedTask(ITaskLogger<_TLogData>& logger, TLevels levels, bool init_succeeded) noexcept :
+                _logger(logger), _outLevels(std::move(levels)), _successState(init_succeeded)
+        {}
+
+        ALoggerSharedTask(const ALoggerSharedTask&) = delete;
+        ALoggerSharedTask& operator=(const ALoggerSharedTask&) = delete;
+
+        /** Output messages */
+        ~ALoggerSharedTask() noexcept;
+
+        /** Set task result */
+        void setTaskResult(bool success) noexcept                   { _successState.store(success, std::memory_order_relaxed); }
+
+        /** Get task result */
+        bool taskResult() const noexcept                            { return _successState.load(std::memory_order_relaxed); }
+
+        /** Add the message
+         *
+         * It can be called by several threads simultaneously.
+         *
+         * \param[in] level Message level
+         * \param[in] data Message
+         * \param[in] time Message timestamp
+         * \param[in] forced Message is output regardless of the task result
+         */
+        template<typename TData>
+        void addToLog(std::size_t level, TData&& data, std::chrono::system_clock::time_point time, bool forced = false) noexcept;
+
+    private:
+        struct SNode {
+            template<typename TData>
+            SNode(std::size_t level, TData&& data, std::chrono::system_clock::time_point time, bool forced) noexcept :
+                    _time(time), _level(level), _forced(forced), _data(std::forward<TData>(data)) {}
+
+            SNode* _next{nullptr};
+            std::chrono::system_clock::time_point _time;
+            std::size_t _level;
+            bool _forced;                   // Message of the failed or sampled thread-bound task
+            _TLogData _data;
+        };
+
+        ITaskLogger<_TLogData>& _logger;
+        const TLevels _outLevels;
+        std::atomic<bool> _successState;
+        std::atomic<SNode*> _head{nullptr};     // The last added message
+    };
+
+    /** Shared task handle
+     *
+     * Handle can be copied and used by any thread. Task ends when the last handle and the last activation scope are
+     * released.
+     *
+     * \tparam _TLogData ALogger data type
+     */
+    template<typename _TLogData>
+    class ALoggerTaskHandle {
+        template<bool, typename> friend class ALoggerBase;
+
+    public:
+        /** ALogger data type */
+        using TLogData = _TLogData;
+
+        ALoggerTaskHandle() noexcept = default;
+
+        /** Check that handle has the task
+         *
+         * \return True if handle is not empty
+         */
+        explicit operator bool() const noexcept                     { return static_cast<bool>(_task); }
+
+        /** Set task result - success or fail */
+        const ALoggerTaskHandle& setTaskResult(bool success) const noexcept { _task->setTaskResult(success); return *this; }
+
+        /** Set task result as succeeded */
+        const ALoggerTaskHandle& succeeded() const noexcept         { return setTaskResult(true); }
+
+        /** Set task result as failed */
+        const ALoggerTaskHandle& failed() const noexcept            { return setTaskResult(false); }
+
+        /** Get task result */
+        bool TaskResult() const noexcept                            { return _task->taskResult(); }
+
+        /** Add the message directly to the task
+         *
+         * \param[in] level Message level
+         * \param[in] data Message
+         * \param[in] time Message timestamp. Current time by default
+         *
+         * \return Current handle
+         */
+        template<typename TData>
+        const ALoggerTaskHandle& addToLog(std::size_t level, TData&& data, std::chrono::system_clock::time_point time = std::chrono::system_clock::now()) const noexcept
+        {
+            _task->addToLog(level, std::forward<TData>(data), time);
+            return *this;
+        }
+
+        /** Release the task
+         *
+         * Task ends if it was the last reference.
+         */
+        void reset() noexcept                                       { _task.reset(); }
+
+    private:
+        std::shared_ptr<ALoggerSharedTask<_TLogData>> _task;
+
+        explicit ALoggerTaskHandle(std::shared_ptr<ALoggerSharedTask<_TLogData>> task) noexcept : _task(std::move(task)) {}
+    };
+
+    /** Shared task activation scope
+     *
+     * It is returned by #ALogger::ALoggerBase::activate call. Scopes have to be destroyed by the same thread in the
+     * reverse order.
+     */
+    class ALoggerTaskScope {
+    public:
+        /** Activate task
+         *
+         * \param[in] logger Logger
+         * \param[in] task Shared task
+         */
+        template<typename _TLogData>
+        ALoggerTaskScope(const void* logger, std::shared_ptr<ALoggerSharedTask<_TLogData>> task) noexcept :
+                _frame{ logger, task.get(), 0, SActiveTask::top() }, _keep(std::move(task))
+        {
+            SActiveTask::top() = &_frame;
+        }
+
+        ALoggerTaskScope(const ALoggerTaskScope&) = delete;
+        ALoggerTaskScope(ALoggerTaskScope&&) = delete;
+        ALoggerTaskScope& operator=(const ALoggerTaskScope&) = delete;
+        ALoggerTaskScope& operator=(ALoggerTaskScope&&) = delete;
+
+        /** Deactivate task */
+        ~ALoggerTaskScope() noexcept
+        {
+            assert(SActiveTask::top() == &_frame && _frame._localTasks == 0);
+            SActiveTask::top() = _frame._previous;
+        }
+
+    private:
+        SActiveTask _frame;
+        std::shared_ptr<void> _keep;
+    };
+
+    template<typename _TLogData>
+    template<typename TData>
+    void ALoggerSharedTask<_TLogData>::addToLog(std::size_t level, TData&& data, std::chrono::system_clock::time_point time, bool forced) noexcept
+    {
+        auto* node{ new SNode(level, std::forward<TData>(data), time, forced) };
+
+        node->_next = _head.load(std::memory_order_relaxed);
+        while (!_head.compare_exchange_weak(node->_next, node, std::memory_order_release, std::memory_order_relaxed))
+            ;
+    }
+
+    template<typename _TLogData>
+    ALoggerSharedTask<_TLogData>::~ALoggerSharedTask() noexcept
+    {
+        // List is in the reverse order
+        SNode* node{ _head.exchange(nullptr, std::memory_order_acquire) };
+        SNode* first{nullptr};
+
+        while (node != nullptr) {
+            auto* next{ node->_next };
+            node->_next = first;
+            first = node;
+            node = next;
+        }
+
+        const bool success{ taskResult() };
+
+        while (first != nullptr) {
+            if (!success || first->_forced || _outLevels.count(first->_level))
+                _logger.forceAddToLog(first->_level, std::move(first->_data), first->_time);
+
+            delete std::exchange(first, first->_next);
+        }
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_TASK_HANDLE_H_
@@ -0,0 +1,358 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_task_spill.h
+ * \brief Memory budget and spill-to-disk storage of logger tasks.
+ *
+ * Task keeps all its messages until the task end. Long-running task can collect a lot of them, so task memory can be
+ * limited by #ALogger::ALoggerBase::setSpillPolicy call. Policy has the per-task budget and the budget of all tasks of
+ * the logger, see #ALogger::SSpillPolicy. When any of them is exceeded, the task writes its oldest messages in order to
+ * the temporary file and releases them. At the task end spilled messages are read back before in-memory ones, and
+ * only messages that are output are decoded. Other ones are skipped.
+ *
+ * Task spills its oldest messages down to the low watermark, 3/4 of the exceeded limit. If the total budget is used
+ * by other tasks, the task may not get below it, so it spills again only after it adds the quarter of the limit.
+ * Like this each spill writes a batch of messages instead of one file write per message.
+ *
+ * Messages are written to the file by #ALogger::SSpillCodec specialization of the logger data type. Codecs for
+ * std::basic_string and text logger records are provided. If there is no codec for the data type, tasks never spill.
+ *
+ * Spill file record format, all numbers are in the native byte order because the file is removed at the task end :
+ * - timestamp, 8 bytes, system clock ticks ;
+ * - level, 8 bytes. The highest bit marks the message that is output regardless of the task result ;
+ * - payload size, 4 bytes ;
+ * - payload made by #ALogger::SSpillCodec::encode call.
+ *
+ * \code
+
+    logger.setSpillPolicy({ 64 * 1024 * 1024, 512 * 1024 * 1024 });     // 64 MB per task, 512 MB for all tasks
+
+ * \endcode
+ */
+
+#ifndef _AVN_LOGGER_TASK_SPILL_H_
+#define _AVN_LOGGER_TASK_SPILL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace ALogger {
+
+    /** Task memory budget policy */
+    struct SSpillPolicy {
+        std::size_t _taskBytes{0};      ///< Memory budget of one task in bytes. 0 if unlimited
+        std::size_t _totalBytes{0};     ///< Memory budget of all tasks of the logger in bytes. 0 if unlimited
+    };
+
+    /** Task memory budget
+     *
+     * Budget is shared by all tasks of the logger. It is thread safe.
+     */
+    class ALoggerSpillBudget {
+    public:
+        /** Set policy
+         *
+         * Tasks that are already created use the new policy too.
+         *
+         * \param[in] policy Policy
+         */
+        void setPolicy(const SSpillPolicy& policy) noexcept
+        {
+            _taskBytes.store(policy._taskBytes, std::memory_order_relaxed);
+            _totalBytes.store(policy._totalBytes, std::memory_order_relaxed);
+        }
+
+        /** Get policy
+         *
+         * \return Policy
+         */
+        SSpillPolicy policy() const noexcept    { return { _taskBytes.load(std::memory_order_relaxed), _totalBytes.load(std::memory_order_relaxed) }; }
+
+        /** Check that budget is set
+         *
+         * \return True if any limit is set
+         */
+        bool limited() const noexcept           { return _taskBytes.load(std::memory_order_relaxed) != 0 || _totalBytes.load(std::memory_order_relaxed) != 0; }
+
+        /** Memory used by all tasks
+         *
+         * \return Memory in bytes
+         */
+        std::size_t used() const noexcept       { return _used.load(std::memory_order_relaxed); }
+
+        /** Account task memory
+         *
+         * \param[in] bytes Added memory in bytes
+         * \param[in] task_bytes Task memory including \a bytes
+         *
+         * \return True if task or total budget is exceeded
+         */
+        bool add(std::size_t bytes, std::size_t task_bytes) noexcept
+        {
+            const auto used{ _used.fetch_add(bytes, std::memory_order_relaxed) + bytes };
+            const auto task_limit{ _taskBytes.load(std::memory_order_relaxed) };
+            const auto total_limit{ _totalBytes.load(std::memory_order_relaxed) };
+
+            return (task_limit != 0 && task_bytes > task_limit) || (total_limit != 0 && used > total_limit);
+        }
+
+        /** Release task memory
+         *
+         * \param[in] bytes Released memory in bytes
+         */
+        void release(std::size_t bytes) noexcept    { _used.fetch_sub(bytes, std::memory_order_relaxed); }
+
+        /** Memory to be released to get below low watermarks
+         *
+         * \param[in] task_bytes Task memory
+         *
+         * \return Memory in bytes. It may exceed \a task_bytes if the total budget is used by other tasks
+         */
+        std::size_t excess(std::size_t task_bytes) const noexcept
+        {
+            const auto used{ _used.load(std::memory_order_relaxed) };
+            const auto task_limit{ _taskBytes.load(std::memory_order_relaxed) };
+            const auto total_limit{ _totalBytes.load(std::memory_order_relaxed) };
+
+            std::size_t excess{0};
+            if (task_limit != 0 && task_bytes > lowWatermark(task_limit))
+                excess = task_bytes - lowWatermark(task_limit);
+            if (total_limit != 0 && used > lowWatermark(total_limit))
+                excess = std::max(excess, used - lowWatermark(total_limit));
+            return excess;
+        }
+
+        /** Memory that task adds after the spill before it spills again
+         *
+         * \return Memory in bytes, the gap between the least limit and its low watermark
+         */
+        std::size_t hysteresis() const noexcept
+        {
+            const auto task_limit{ _taskBytes.load(std::memory_order_relaxed) };
+            const auto total_limit{ _totalBytes.load(std::memory_order_relaxed) };
+            const auto limit{ task_limit == 0 ? total_limit : total_limit == 0 ? task_limit : std::min(task_limit, total_limit) };
+
+            return limit - lowWatermark(limit);
+        }
+
+        /** Low watermark of the limit
+         *
+         * \param[in] limit Limit in bytes
+         *
+         * \return Memory in bytes
+         */
+        constexpr static std::size_t lowWatermark(std::size_t limit) noexcept  { return limit - limit / 4; }
+
+    private:
+        std::atomic<std::size_t> _taskBytes{0};
+        std::atomic<std::size_t> _totalBytes{0};
+        std::atomic<std::size_t> _used{0};
+    };
+
+    /** Spill codec of the logger data type
+     *
+     * Specialize this template to let tasks spill your data type. Specialization must have :
+     * - constexpr static bool Supported{ true } ;
+     * - static std::size_t memory(const T& data) : heap memory held by \a data in bytes ;
+     * - static void encode(std::string& out, const T& data) : append \a data bytes to \a out ;
+     * - static T decode(std::string_view in) : make data from bytes appended by \a encode.
+     *
+     * \tparam T Logger data type
+     */
+    template<typename T>
+    struct SSpillCodec {
+        /** Data type has no codec, tasks never spill */
+        constexpr static bool Supported{ false };
+    };
+
+    /** Spill codec of strings
+     *
+     * \tparam _TChar Character type
+     */
+    template<typename _TChar>
+    struct SSpillCodec<std::basic_string<_TChar>> {
+        /** String type */
+        using TString = std::basic_string<_TChar>;
+
+        /** Strings are supported */
+        constexpr static bool Supported{ true };
+
+        /** Heap memory held by string
+         *
+         * \param[in] data String
+         *
+         * \return Capacity in bytes
+         */
+        static std::size_t memory(const TString& data) noexcept             { return data.capacity() * sizeof(_TChar); }
+
+        /** Append string bytes
+         *
+         * \param[out] out Output buffer
+         * \param[in] data String
+         */
+        static void encode(std::string& out, const TString& data) noexcept  { out.append(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(_TChar)); }
+
+        /** Make string from bytes
+         *
+         * \param[in] in Bytes
+         *
+         * \return String
+         */
+        static TString decode(std::string_view in) noexcept
+        {
+            TString data(in.size() / sizeof(_TChar), _TChar());
+            std::memcpy(data.data(), in.data(), data.size() * sizeof(_TChar));
+            return data;
+        }
+    };
+
+    /** Temporary spill file
+     *
+     * File is created by std::tmpfile call, so it is removed when it is closed or the process terminates.
+     */
+    class ALoggerSpillFile {
+    public:
+        /** Record header size */
+        constexpr static std::size_t HeaderSize{ 20 };
+
+        /** Level bit of the message that is output regardless of the task result */
+        constexpr static std::uint64_t ForcedLevel{ std::uint64_t{1} << 63 };
+
+        /** Level field of the record header
+         *
+         * \param[in] level Level
+         * \param[in] forced Message is output regardless of the task result
+         *
+         * \return Level field
+         */
+        constexpr static std::uint64_t level(std::size_t level, bool forced) noexcept  { return forced ? level | ForcedLevel : level; }
+
+        /** Split level field of the record header
+         *
+         * \param[in,out] level Level field. Forced bit is removed
+         *
+         * \return True if message is output regardless of the task result
+         */
+        constexpr static bool forced(std::uint64_t& level) noexcept
+        {
+            const bool forced{ (level & ForcedLevel) != 0 };
+            level &= ~ForcedLevel;
+            return forced;
+        }
+
+        ALoggerSpillFile() noexcept : _file(std::tmpfile())     {}
+        ALoggerSpillFile(const ALoggerSpillFile&) = delete;
+        ALoggerSpillFile& operator=(const ALoggerSpillFile&) = delete;
+
+        ~ALoggerSpillFile() noexcept                            { if (_file != nullptr) std::fclose(_file); }
+
+        /** Check that file is created
+         *
+         * \return True if file is created
+         */
+        bool isOpened() const noexcept                          { return _file != nullptr; }
+
+        /** Append record header
+         *
+         * \param[out] out Output buffer
+         * \param[in] ticks Timestamp in system clock ticks
+         * \param[in] level Level
+         * \param[in] size Payload size
+         */
+        static void header(std::string& out, std::int64_t ticks, std::uint64_t level, std::uint32_t size) noexcept
+        {
+            char bytes[HeaderSize];
+            std::memcpy(bytes, &ticks, 8);
+            std::memcpy(bytes + 8, &level, 8);
+            std::memcpy(bytes + 16, &size, 4);
+            out.append(bytes, sizeof(bytes));
+        }
+
+        /** Parse record header
+         *
+         * \param[in] bytes Header bytes, at least #ALogger::ALoggerSpillFile::HeaderSize
+         * \param[out] ticks Timestamp in system clock ticks
+         * \param[out] level Level
+         * \param[out] size Payload size
+         */
+        static void parseHeader(const char* bytes, std::int64_t& ticks, std::uint64_t& level, std::uint32_t& size) noexcept
+        {
+            std::memcpy(&ticks, bytes, 8);
+            std::memcpy(&level, bytes + 8, 8);
+            std::memcpy(&size, bytes + 16, 4);
+        }
+
+        /** Write bytes at the end of file
+         *
+         * \param[in] bytes Bytes
+         *
+         * \return True if bytes are written
+         */
+        bool write(std::string_view bytes) noexcept
+        {
+            // File may be read since the last write
+            return std::fseek(_file, 0, SEEK_END) == 0 && std::fwrite(bytes.data(), 1, bytes.size(), _file) == bytes.size();
+        }
+
+        /** Start reading from the beginning */
+        void rewind() noexcept                                  { std::fflush(_file); std::rewind(_file); }
+
+        /** Start reading from the position
+         *
+         * \param[in] position Record position from the file beginning
+         *
+         * \return True if position is set
+         */
+        bool seek(std::uint64_t position) noexcept              { std::fflush(_file); return std::fseek(_file, static_cast<long>(position), SEEK_SET) == 0; }
+
+        /** Read record header
+         *
+         * \param[out] ticks Timestamp in system clock ticks
+         * \param[out] level Level
+         * \param[out] size Payload size
+         *
+         * \return False if there are no more records
+         */
+        bool readHeader(std::int64_t& ticks, std::uint64_t& level, std::uint32_t& size) noexcept
+        {
+            char bytes[HeaderSize];
+            if (std::fread(bytes, 1, sizeof(bytes), _file) != sizeof(bytes))
+                return false;
+
+            parseHeader(bytes, ticks, level, size);
+            return true;
+        }
+
+        /** Read payload
+         *
+         * \param[out] out Payload buffer. It is resized to \a size
+         * \param[in] size Payload size
+         *
+         * \return True if payload is read
+         */
+        bool readPayload(std::string& out, std::uint32_t size) noexcept
+        {
+            out.resize(size);
+            return std::fread(out.data(), 1, size, _file) == size;
+        }
+
+        /** Skip payload
+         *
+         * \param[in] size Payload size
+         *
+         * \return True if payload is skipped
+         */
+        bool skipPayload(std::uint32_t size) noexcept           { return std::fseek(_file, static_cast<long>(size), SEEK_CUR) == 0; }
+
+    private:
+        std::FILE* _file;
+    };
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_TASK_SPILL_H_
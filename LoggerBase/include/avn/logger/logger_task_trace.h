@@ -0,0 +1,300 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_task_trace.h
+ * \brief ALoggerTrace class collects task spans and writes them as Chrome trace events.
+ *
+ * Task marks the begin and the end of the work unit of the thread, so it is the tracing span. When the logger has the
+ * trace, see #ALogger::ALoggerBase::setTrace, each task records its start and end time, nesting depth, result and
+ * messages amount at the task end. Spans are stored in the per-thread buffer of the trace, so threads do not contend
+ * with each other. Buffers are owned by the trace, threads keep weak references and forget buffers of destroyed
+ * traces.
+ *
+ * #ALogger::ALoggerTrace::writeChromeTrace writes spans in the Chrome trace event JSON format. It can be opened by
+ * Perfetto UI or chrome://tracing offline.
+ *
+ * \code
+
+    ALogger::ALoggerTrace trace;
+    logger.setTrace(&trace);
+
+    {
+        auto task = logger.addTask();
+        task.setName("request");
+        ...
+    }
+
+    trace.saveChromeTrace("trace.json");
+
+ * \endcode
+ *
+ * Nesting depth is counted per thread and per trace, so several loggers can share the same trace. Only one logger of
+ * the loggers group should have the trace because each logger of the group has its own task.
+ */
+
+#ifndef _AVN_LOGGER_TASK_TRACE_H_
+#define _AVN_LOGGER_TASK_TRACE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <avn/logger/logger_json_escape.h>
+
+namespace ALogger {
+
+    /** Task span */
+    struct STaskSpan {
+        std::string _name;                                  ///< Task name
+        std::chrono::steady_clock::time_point _start;       ///< Task start
+        std::chrono::steady_clock::time_point _end;         ///< Task end
+        std::uint32_t _thread;                              ///< Thread number inside the trace
+        std::uint32_t _depth;                               ///< Nesting depth, 0 for the outer task
+        std::size_t _entries;                               ///< Messages amount added to the task
+        bool _succeeded;                                    ///< Task result
+    };
+
+    /** Tasks trace
+     *
+     * Trace is thread safe. It has to outlive loggers that use it.
+     */
+    class ALoggerTrace {
+        struct SThreadBuffer;
+
+    public:
+        /** Thread buffer handle returned by #ALogger::ALoggerTrace::begin */
+        using TThread = SThreadBuffer*;
+
+        /** Constructor
+         *
+         * \param[in] thread_capacity Maximum spans amount kept for each thread. Next spans are dropped
+         */
+        explicit ALoggerTrace(std::size_t thread_capacity = 1024 * 1024) noexcept :
+                _id(++lastId()), _threadCapacity(thread_capacity), _epoch(std::chrono::steady_clock::now())
+        {}
+
+        ALoggerTrace(const ALoggerTrace&) = delete;
+        ALoggerTrace& operator=(const ALoggerTrace&) = delete;
+
+        /** Start span of the current thread
+         *
+         * \param[out] depth Nesting depth of the span
+         *
+         * \return Current thread buffer to be passed to #ALogger::ALoggerTrace::end
+         */
+        TThread begin(std::uint32_t& depth) noexcept;
+
+        /** End span
+         *
+         * \param[in] thread Thread buffer returned by #ALogger::ALoggerTrace::begin call of the same thread
+         * \param[in] span Span. Thread number is set by the trace
+         */
+        void end(TThread thread, STaskSpan&& span) noexcept;
+
+        /** All collected spans
+         *
+         * \return Spans ordered by start time
+         */
+        std::vector<STaskSpan> spans() const noexcept;
+
+        /** Dropped spans amount
+         *
+         * \return Spans amount dropped due to the thread capacity limit
+         */
+        std::size_t dropped() const noexcept;
+
+        /** Remove collected spans */
+        void clear() noexcept;
+
+        /** Write spans as Chrome trace events
+         *
+         * Each span is the complete ("X") event. Time is in microseconds since the trace creation.
+         *
+         * \param[out] out Output stream
+         *
+         * \return True if stream is good after the output
+         */
+        bool writeChromeTrace(std::ostream& out) const noexcept;
+
+        /** Save spans as Chrome trace events file
+         *
+         * \param[in] file File name
+         *
+         * \return True if file is written
+         */
+        bool saveChromeTrace(const std::filesystem::path& file) const noexcept;
+
+    private:
+        struct SThreadBuffer {
+            std::mutex _mutex;
+            std::vector<STaskSpan> _spans;
+            std::size_t _dropped{0};
+            std::uint32_t _depth{0};        // Used by the owner thread only
+            std::uint32_t _thread{0};
+        };
+
+        using TBufferPtr = std::shared_ptr<SThreadBuffer>;
+
+        std::uint64_t _id;
+        std::size_t _threadCapacity;
+        std::chrono::steady_clock::time_point _epoch;
+        mutable std::mutex _mutex;
+        std::vector<TBufferPtr> _buffers;
+
+        static std::atomic<std::uint64_t>& lastId() noexcept    { static std::atomic<std::uint64_t> id{0}; return id; }
+
+        SThreadBuffer& threadBuffer() noexcept;
+        static void appendMicro(std::string& out, std::chrono::steady_clock::duration time) noexcept;
+    };
+
+    inline ALoggerTrace::SThreadBuffer& ALoggerTrace::threadBuffer() noexcept
+    {
+        struct SThreadRef {
+            std::uint64_t _id;
+            std::weak_ptr<SThreadBuffer> _owner;
+            SThreadBuffer* _buffer;
+        };
+
+        // Identifiers are used instead of pointers because the trace address can be reused by the next trace. Buffer
+        // of the found trace is alive, because the trace owns it
+        thread_local std::vector<SThreadRef> buffers;
+
+        for (const auto& ref : buffers) {
+            if (ref._id == _id)
+                return *ref._buffer;
+        }
+
+        // Buffers of destroyed traces are forgotten
+        buffers.erase(std::remove_if(buffers.begin(), buffers.end(), [](const auto& ref) { return ref._owner.expired(); }), buffers.end());
+
+        auto buffer{ std::make_shared<SThreadBuffer>() };
+        {
+            std::lock_guard lock(_mutex);
+            buffer->_thread = static_cast<std::uint32_t>(_buffers.size() + 1);
+            _buffers.push_back(buffer);
+        }
+
+        buffers.push_back({ _id, buffer, buffer.get() });
+        return *buffer;
+    }
+
+    inline ALoggerTrace::TThread ALoggerTrace::begin(std::uint32_t& depth) noexcept
+    {
+        auto& buffer{ threadBuffer() };
+        depth = buffer._depth++;
+        return &buffer;
+    }
+
+    inline void ALoggerTrace::end(TThread thread, STaskSpan&& span) noexcept
+    {
+        auto& buffer{ *thread };
+
+        if (buffer._depth != 0)
+            --buffer._depth;
+
+        span._thread = buffer._thread;
+
+        std::lock_guard lock(buffer._mutex);
+        if (buffer._spans.size() < _threadCapacity)
+            buffer._spans.push_back(std::move(span));
+        else
+            ++buffer._dropped;
+    }
+
+    inline std::vector<STaskSpan> ALoggerTrace::spans() const noexcept
+    {
+        std::vector<STaskSpan> spans;
+
+        {
+            std::lock_guard lock(_mutex);
+            for (const auto& buffer : _buffers) {
+                std::lock_guard buffer_lock(buffer->_mutex);
+                spans.insert(spans.end(), buffer->_spans.cbegin(), buffer->_spans.cend());
+            }
+        }
+
+        std::stable_sort(spans.begin(), spans.end(), [](const auto& lhs, const auto& rhs) { return lhs._start < rhs._start; });
+        return spans;
+    }
+
+    inline std::size_t ALoggerTrace::dropped() const noexcept
+    {
+        std::size_t dropped{0};
+
+        std::lock_guard lock(_mutex);
+        for (const auto& buffer : _buffers) {
+            std::lock_guard buffer_lock(buffer->_mutex);
+            dropped += buffer->_dropped;
+        }
+
+        return dropped;
+    }
+
+    inline void ALoggerTrace::clear() noexcept
+    {
+        std::lock_guard lock(_mutex);
+        for (const auto& buffer : _buffers) {
+            std::lock_guard buffer_lock(buffer->_mutex);
+            buffer->_spans.clear();
+            buffer->_dropped = 0;
+        }
+    }
+
+    inline void ALoggerTrace::appendMicro(std::string& out, std::chrono::steady_clock::duration time) noexcept
+    {
+        // std::to_chars does not depend on the locale, so the decimal point is always '.'
+        char buffer[48];
+        const auto micro{ static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count()) / 1000.0 };
+        const auto res{ std::to_chars(buffer, buffer + sizeof(buffer), micro, std::chars_format::fixed, 3) };
+        out.append(buffer, res.ptr);
+    }
+
+    inline bool ALoggerTrace::writeChromeTrace(std::ostream& out) const noexcept
+    {
+        std::string event;
+        bool first{true};
+
+        out << "{\"traceEvents\":[";
+
+        for (const auto& span : spans()) {
+            event.assign(first ? "\n" : ",\n");
+            event.append("{\"name\":");
+            JsonEscape::appendQuoted(event, span._name);
+            event.append(",\"cat\":\"task\",\"ph\":\"X\",\"ts\":");
+            appendMicro(event, span._start - _epoch);
+            event.append(",\"dur\":");
+            appendMicro(event, span._end - span._start);
+            event.append(",\"pid\":1,\"tid\":").append(std::to_string(span._thread));
+            event.append(",\"args\":{\"depth\":").append(std::to_string(span._depth));
+            event.append(",\"entries\":").append(std::to_string(span._entries));
+            event.append(",\"succeeded\":").append(span._succeeded ? "true" : "false").append("}}");
+
+            out << event;
+            first = false;
+        }
+
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+        return out.good();
+    }
+
+    inline bool ALoggerTrace::saveChromeTrace(const std::filesystem::path& file) const noexcept
+    {
+        std::ofstream out(file, std::ios_base::out | std::ios_base::trunc);
+        return out.is_open() && writeChromeTrace(out);
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_TASK_TRACE_H_
@@ -0,0 +1,257 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_task_watchdog.h
+ * \brief Registry of open logger tasks and the watchdog that reports long-lived ones.
+ *
+ * Task messages reach the output at the task end, so the stuck task shows nothing. #ALogger::ALoggerTaskWatchdog
+ * checks open tasks of the logger in its own thread and reports each task that is open longer than the threshold
+ * once.
+ *
+ * Tasks are registered in the logger #ALogger::ALoggerTaskRegistry only while any watchdog is attached to it, so
+ * there is no cost if watchdogs are not used. Tasks that were created before the watchdog are not reported.
+ *
+ * \code
+
+    ALogger::ALoggerTaskWatchdog watchdog(logger.openTasks(), std::chrono::seconds(30), std::chrono::seconds(1),
+        [&logger](const ALogger::STaskInfo& task) {
+            logger.forceAddToLog(WARNING, "Task is open for " + std::to_string(std::chrono::duration_cast<std::chrono::seconds>(task._age).count()) + " s");
+        });
+
+ * \endcode
+ *
+ * Report function is called from the watchdog thread without any watchdog lock held, so the logger has to be thread
+ * safe if it outputs the report.
+ *
+ * Watchdog only reports tasks, it does not output their messages. Task is used by its thread without locks, so the
+ * partial flush, see #ALogger::STaskFlushPolicy, is made by the task itself when it adds a message, and the stuck task
+ * is not flushed.
+ */
+
+#ifndef _AVN_LOGGER_TASK_WATCHDOG_H_
+#define _AVN_LOGGER_TASK_WATCHDOG_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace ALogger {
+
+    /** Open task information */
+    struct STaskInfo {
+        std::uint64_t _id;                                  ///< Task identifier inside the registry
+        std::thread::id _thread;                            ///< Thread that created the task
+        std::chrono::system_clock::time_point _start;       ///< Task creation time
+        std::chrono::steady_clock::duration _age;           ///< Time passed since the task creation
+    };
+
+    /** Open tasks registry of the logger
+     *
+     * Registry is thread safe.
+     */
+    class ALoggerTaskRegistry {
+    public:
+        /** Start tasks tracking
+         *
+         * Each call has to be paired with #ALogger::ALoggerTaskRegistry::detach call.
+         */
+        void attach() noexcept                  { _watchers.fetch_add(1, std::memory_order_relaxed); }
+
+        /** Stop tasks tracking */
+        void detach() noexcept                  { _watchers.fetch_sub(1, std::memory_order_relaxed); }
+
+        /** Check that tasks are tracked
+         *
+         * \return True if any watchdog is attached
+         */
+        bool tracked() const noexcept           { return _watchers.load(std::memory_order_relaxed) != 0; }
+
+        /** Register task of the current thread
+         *
+         * \return Task identifier or 0 if tasks are not tracked
+         */
+        std::uint64_t add() noexcept;
+
+        /** Unregister task
+         *
+         * \param[in] id Task identifier. 0 is ignored
+         */
+        void remove(std::uint64_t id) noexcept;
+
+        /** Open tasks amount
+         *
+         * \return Registered tasks amount
+         */
+        std::size_t size() const noexcept       { std::lock_guard lock(_mutex); return _tasks.size(); }
+
+        /** Tasks that are open longer than threshold
+         *
+         * \param[in] threshold Task age threshold
+         *
+         * \return Tasks information, the oldest first
+         */
+        std::vector<STaskInfo> longTasks(std::chrono::steady_clock::duration threshold) const noexcept;
+
+    private:
+        struct STask {
+            std::thread::id _thread;
+            std::chrono::system_clock::time_point _start;
+            std::chrono::steady_clock::time_point _steadyStart;
+        };
+
+        mutable std::mutex _mutex;
+        std::atomic<std::size_t> _watchers{0};
+        std::uint64_t _lastId{0};
+        std::map<std::uint64_t, STask> _tasks;
+    };
+
+    /** Watchdog of long-lived tasks
+     *
+     * Watchdog checks the registry in its own thread each period and reports tasks that are open longer than the
+     * threshold. Each task is reported once.
+     */
+    class ALoggerTaskWatchdog {
+    public:
+        /** Report function type */
+        using TReport = std::function<void(const STaskInfo&)>;
+
+        /** Start watchdog
+         *
+         * \param[in] registry Logger tasks registry, see #ALogger::ALoggerBase::openTasks
+         * \param[in] threshold Task age to be reported
+         * \param[in] period Check period
+         * \param[in] report Report function
+         */
+        ALoggerTaskWatchdog(ALoggerTaskRegistry& registry, std::chrono::steady_clock::duration threshold,
+                            std::chrono::steady_clock::duration period, TReport report) noexcept;
+
+        ALoggerTaskWatchdog(const ALoggerTaskWatchdog&) = delete;
+        ALoggerTaskWatchdog& operator=(const ALoggerTaskWatchdog&) = delete;
+
+        /** Stop watchdog */
+        ~ALoggerTaskWatchdog() noexcept;
+
+        /** Check tasks immediately
+         *
+         * \return Amount of newly reported tasks
+         */
+        std::size_t check() noexcept;
+
+    private:
+        ALoggerTaskRegistry& _registry;
+        std::chrono::steady_clock::duration _threshold;
+        std::chrono::steady_clock::duration _period;
+        TReport _report;
+        std::set<std::uint64_t> _reported;
+        std::mutex _mutex;
+        std::condition_variable _stopCond;
+        bool _stop{false};
+        std::thread _thread;
+
+        void run() noexcept;
+    };
+
+    inline std::uint64_t ALoggerTaskRegistry::add() noexcept
+    {
+        if (!tracked())
+            return 0;
+
+        STask task{ std::this_thread::get_id(), std::chrono::system_clock::now(), std::chrono::steady_clock::now() };
+
+        std::lock_guard lock(_mutex);
+        _tasks.emplace(++_lastId, task);
+        return _lastId;
+    }
+
+    inline void ALoggerTaskRegistry::remove(std::uint64_t id) noexcept
+    {
+        if (id == 0)
+            return;
+
+        std::lock_guard lock(_mutex);
+        _tasks.erase(id);
+    }
+
+    inline std::vector<STaskInfo> ALoggerTaskRegistry::longTasks(std::chrono::steady_clock::duration threshold) const noexcept
+    {
+        const auto now{ std::chrono::steady_clock::now() };
+        std::vector<STaskInfo> tasks;
+
+        std::lock_guard lock(_mutex);
+        // Identifiers grow, so the map order is the creation order
+        for (const auto& [id, task] : _tasks) {
+            const auto age{ now - task._steadyStart };
+            if (age >= threshold)
+                tasks.push_back({ id, task._thread, task._start, age });
+        }
+
+        return tasks;
+    }
+
+    inline ALoggerTaskWatchdog::ALoggerTaskWatchdog(ALoggerTaskRegistry& registry, std::chrono::steady_clock::duration threshold,
+                                                    std::chrono::steady_clock::duration period, TReport report) noexcept :
+            _registry(registry), _threshold(threshold), _period(period), _report(std::move(report))
+    {
+        _registry.attach();
+        _thread = std::thread([this]() { run(); });
+    }
+
+    inline ALoggerTaskWatchdog::~ALoggerTaskWatchdog() noexcept
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _stop = true;
+        }
+        _stopCond.notify_one();
+        _thread.join();
+
+        _registry.detach();
+    }
+
+    inline std::size_t ALoggerTaskWatchdog::check() noexcept
+    {
+        const auto tasks{ _registry.longTasks(_threshold) };
+        std::set<std::uint64_t> reported;
+        std::vector<STaskInfo> to_report;
+
+        {
+            std::lock_guard lock(_mutex);
+
+            for (const auto& task : tasks) {
+                reported.insert(task._id);
+                if (_reported.count(task._id) == 0)
+                    to_report.push_back(task);
+            }
+
+            // Finished tasks are forgotten
+            _reported = std::move(reported);
+        }
+
+        // Report function may be slow or check tasks again, so it is called without the lock
+        for (const auto& task : to_report)
+            _report(task);
+
+        return to_report.size();
+    }
+
+    inline void ALoggerTaskWatchdog::run() noexcept
+    {
+        std::unique_lock lock(_mutex);
+
+        while (!_stopCond.wait_for(lock, _period, [this]() { return _stop; })) {
+            lock.unlock();
+            check();
+            lock.lock();
+        }
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_TASK_WATCHDOG_H_
@@ -0,0 +1,250 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_txt_append_file.h
+ * \brief ALoggerTxtAppendFile class implements text logging to a file shared by several processes.
+ *
+ * As #ALogger::ALoggerBase child this class has features listed below :
+ * - multithreading or single thread mode.
+ * - enable or disable logger levels. If current output message has level that is enabled now, it will be output. Also it
+ * is possible to output regardless of current logger level by using #forceAddToLog call.
+ * - add logger tasks and automatically finish them.
+ *
+ * File is opened with O_APPEND flag. Messages are formatted into the own buffer that contains only complete records,
+ * and the whole buffer is emitted by the single write(2) call. Each write(2) call appends data at the end of file
+ * atomically, so records of several processes writing to the same file never interleave, without any inter-process
+ * lock. Short write is counted by #ALogger::ALoggerTxtAppendFile::writeErrors and the rest of the batch is dropped.
+ *
+ * By default each message is written instantly. Records can be batched by \a setFlushPolicy call, see
+ * #ALogger::ALoggerFlushPolicy class description. Batch never exceeds #ALogger::ALoggerTxtAppendFile::MaxBatch
+ * bytes except single record that is longer than this value.
+ *
+ * \code
+
+    constexpr auto WARNING = 0;     // WARNING identifier
+
+    ALogger::ALoggerTxtAppendFile<true, char> logger("/tmp/test.txt"s);
+
+    logger.setFlushPolicy({ 16 * 1024, std::chrono::milliseconds(100) });     // Batch records up to 16 KB or 100 ms
+    logger.addLevelDescr(WARNING, "WARNING");
+    logger.enableLevel(WARNING);
+    logger.addString(WARNING, "This is test string : integer = ", 10);
+
+ * \endcode
+ *
+ * \warning Only POSIX systems are supported.
+ */
+
+#ifndef _AVN_LOGGER_TXT_APPEND_FILE_H_
+#define _AVN_LOGGER_TXT_APPEND_FILE_H_
+
+#include <cerrno>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <avn/logger/logger_txt_base.h>
+#include <avn/logger/logger_flush_policy.h>
+
+namespace ALogger {
+
+    /** Text file logger with atomic appends
+     *
+     * \tparam _ThrSafe Thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated.
+     * \tparam _TChar Character type. Only char is currently supported.
+     */
+    template<bool _ThrSafe, typename _TChar>
+    class ALoggerTxtAppendFile : public ALoggerTxtBase<_ThrSafe, _TChar> {
+    public:
+        /** Current thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated */
+        constexpr static bool ThrSafe{ _ThrSafe };
+
+        /** Character type for text logger messages */
+        using TChar = _TChar;
+
+        static_assert(std::is_same_v<TChar, char>, "Only char is currently supported by append file logger");
+
+        /** String type for text logger messages */
+        using TString = std::basic_string<_TChar>;
+
+        /** Maximum batch size */
+        constexpr static std::size_t MaxBatch{ 64 * 1024 };
+
+        /** Default constructor
+         *
+         * \param[in] local_time Use local time instead of GMT one. True by default
+         */
+        ALoggerTxtAppendFile(bool local_time = true) noexcept :
+                ALoggerTxtBase<_ThrSafe, _TChar>(local_time),
+                _flush([this](bool datasync) { return writeBatch(datasync); }, SFlushPolicy{ 0, std::chrono::milliseconds(0), {}, true })    {}
+
+        /** Constructor with output file configuration
+         *
+         * #openFile is called after object construction
+         *
+         * \param[in] filename Output file name and path
+         * \param[in] local_time Use local time instead of GMT one. True by default
+         */
+        ALoggerTxtAppendFile(const std::filesystem::path& filename, bool local_time = true) noexcept :
+                ALoggerTxtAppendFile(local_time)
+        {
+            openFile(filename);
+        }
+
+        ALoggerTxtAppendFile(const ALoggerTxtAppendFile&) = delete;
+
+        ~ALoggerTxtAppendFile() noexcept override { closeFile(); }
+
+        /** Open file
+         *
+         * File is created if it does not exist. Messages are always appended to the end of file.
+         *
+         * \param[in] filename Output file name and path
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtAppendFile& openFile(const std::filesystem::path& filename) noexcept;
+
+        /** Close currently opened file
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtAppendFile& closeFile() noexcept;
+
+        /** Write current batch to the file
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtAppendFile& flushFile() noexcept                          { auto lock{ _flush.lock() }; writeBatch(false); _flush.flushed(); return *this; }
+
+        /** Set flush policy
+         *
+         * \param[in] policy Flush policy
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtAppendFile& setFlushPolicy(const SFlushPolicy& policy) noexcept    { _flush.setPolicy(policy); return *this; }
+
+        /** Get flush policy engine
+         *
+         * \return Flush policy engine
+         */
+        const ALoggerFlushPolicy& flushPolicy() const noexcept              { return _flush; }
+
+        /** Check that output file is opened
+         *
+         * \return True if file is opened
+         */
+        bool IsOpenedFile() const noexcept                                 { return _fd >= 0; }
+
+        /** Check that output file is opened
+         *
+         * \return True if file is opened
+         */
+        operator bool () const noexcept                                    { return IsOpenedFile(); }
+
+        /** Failed writes amount
+         *
+         * \return Failed writes amount
+         */
+        std::size_t writeErrors() const noexcept                           { return _errors; }
+
+    private:
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept override;
+        void commitData(std::size_t level) noexcept override                { _flush.commit(level); }
+        int writeBatch(bool datasync) noexcept;
+
+        TString _line;      // Reusable message buffer
+        int _fd{-1};
+        std::string _batch;
+        std::size_t _errors{0};
+
+        ALoggerFlushPolicy _flush;
+    };
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtAppendFile<_ThrSafe, _TChar>& ALoggerTxtAppendFile<_ThrSafe, _TChar>::openFile(const std::filesystem::path& filename) noexcept
+    {
+        closeFile();
+
+        auto lock{ _flush.lock() };
+
+        _fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        _batch.reserve(MaxBatch);
+
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtAppendFile<_ThrSafe, _TChar>& ALoggerTxtAppendFile<_ThrSafe, _TChar>::closeFile() noexcept
+    {
+        auto lock{ _flush.lock() };
+
+        if (_fd < 0)
+            return *this;
+
+        writeBatch(false);
+        ::close(_fd);
+        _fd = -1;
+
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    int ALoggerTxtAppendFile<_ThrSafe, _TChar>::writeBatch(bool datasync) noexcept
+    {
+        if (_fd < 0)
+            return -1;
+
+        // Batch is emitted by the single write(2) call. The rest of the short write (e. g. the disk is full) is not
+        // appended by the next call because records of other processes can get between them, it is counted as error.
+        while (!_batch.empty()) {
+            const auto res{ ::write(_fd, _batch.data(), _batch.size()) };
+
+            if (res < 0 && errno == EINTR)
+                continue;
+            if (res < 0 || static_cast<std::size_t>(res) != _batch.size())
+                ++_errors;
+            break;
+        }
+
+        _batch.clear();
+
+        return datasync ? ::dup(_fd) : -1;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    bool ALoggerTxtAppendFile<_ThrSafe, _TChar>::outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept
+    {
+        assert(_fd >= 0);
+
+        auto lock{ _flush.lock() };
+
+        if (_fd < 0)
+            return false;
+
+        auto& str{ _line };
+        str.clear();
+        ALoggerTxtBase<_ThrSafe, _TChar>::prepareString(str, level, time, data);
+
+        // Batch must contain only complete records
+        if (!_batch.empty() && _batch.size() + str.size() + 1 > MaxBatch) {
+            writeBatch(false);
+            _flush.flushed();
+        }
+
+        _batch.append(str);
+        _batch.push_back('\n');
+
+        if (_flush.written(level, str.size() + 1)) {
+            writeBatch(false);
+            _flush.flushed();
+        }
+
+        return true;
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_TXT_APPEND_FILE_H_
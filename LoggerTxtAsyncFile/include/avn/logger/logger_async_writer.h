@@ -0,0 +1,614 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_async_writer.h
+ * \brief AAsyncFileWriter classes implement asynchronous file writing with a fixed buffers pool.
+ *
+ * #ALogger::AAsyncFileWriter is the base class that owns fixed pool of buffers. Producer acquires free buffer, fills it
+ * and submits it with the file offset. Buffer returns to the pool after write completion. Producer waits only if all
+ * buffers are in flight.
+ *
+ * There are two implementations :
+ * - #ALogger::AUringFileWriter submits writes to the io_uring submission queue. Pool buffers are registered in the
+ * kernel, so IORING_OP_WRITE_FIXED requests are used. Completions are reaped by the producer itself, no additional
+ * thread is used ;
+ * - #ALogger::APwriteFileWriter is the fallback for systems without io_uring. Buffers are queued to the dedicated
+ * thread that calls pwrite(2).
+ *
+ * #ALogger::AAsyncFileWriter::create call selects io_uring if it is available at runtime.
+ *
+ * If O_DIRECT is used, buffers are aligned by #ALogger::AAsyncFileWriter::Alignment and writes sizes and offsets have
+ * to be aligned by caller.
+ *
+ * \warning Only POSIX systems are supported. io_uring is used only on Linux.
+ */
+
+#ifndef _AVN_LOGGER_ASYNC_WRITER_H_
+#define _AVN_LOGGER_ASYNC_WRITER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define AVN_LOGGER_URING
+#include <csignal>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif // __linux__
+
+namespace ALogger {
+
+    /** Asynchronous file writer options */
+    struct SAsyncFileOptions {
+        /** Pool buffer size. It is rounded up to #ALogger::AAsyncFileWriter::Alignment */
+        std::size_t _bufferSize{ 256 * 1024 };
+
+        /** Pool buffers amount */
+        std::size_t _buffers{ 8 };
+
+        /** Open file with O_DIRECT flag. It is ignored if the file system does not support it */
+        bool _directIO{ false };
+
+        /** Use io_uring if it is available. Otherwise pwrite(2) thread is used */
+        bool _uring{ true };
+    };
+
+    /** Asynchronous file writer base class with the buffers pool */
+    class AAsyncFileWriter {
+    public:
+        /** Buffers alignment. It is suitable for O_DIRECT writes */
+        constexpr static std::size_t Alignment{ 4096 };
+
+        /** Pool buffer */
+        struct SBuffer {
+            char* _data{nullptr};       ///< Buffer memory
+            std::size_t _index{0};      ///< Buffer index inside the pool
+            std::size_t _size{0};       ///< Bytes amount to be written
+            std::uint64_t _offset{0};   ///< File offset
+            std::size_t _done{0};       ///< Bytes amount already written
+        };
+
+        /** Constructor
+         *
+         * If buffers memory can not be allocated, the pool gets less buffers than it is requested by \a options.
+         *
+         * \param[in] fd File descriptor. It is not owned by writer
+         * \param[in] options Writer options
+         */
+        AAsyncFileWriter(int fd, const SAsyncFileOptions& options) noexcept;
+
+        AAsyncFileWriter(const AAsyncFileWriter&) = delete;
+        AAsyncFileWriter& operator=(const AAsyncFileWriter&) = delete;
+
+        virtual ~AAsyncFileWriter() noexcept;
+
+        /** Create writer
+         *
+         * io_uring writer is created if it is available and enabled by \a options. Otherwise pwrite(2) thread writer is
+         * created.
+         *
+         * \param[in] fd File descriptor. It is not owned by writer
+         * \param[in] options Writer options
+         *
+         * \return Writer instance or null pointer if no buffer can be allocated
+         */
+        static std::unique_ptr<AAsyncFileWriter> create(int fd, const SAsyncFileOptions& options) noexcept;
+
+        /** Buffer size
+         *
+         * \return Size of each pool buffer
+         */
+        std::size_t bufferSize() const noexcept         { return _bufferSize; }
+
+        /** Buffers amount
+         *
+         * \return Pool size
+         */
+        std::size_t buffers() const noexcept            { return _buffers.size(); }
+
+        /** Get free buffer
+         *
+         * If all buffers are in flight, this call waits for the first completion.
+         *
+         * \return Free buffer
+         */
+        SBuffer* acquire() noexcept;
+
+        /** Submit buffer to be written
+         *
+         * Buffer is returned to the pool after write completion.
+         *
+         * \param[in] buffer Buffer acquired by #acquire call
+         * \param[in] size Bytes amount to be written
+         * \param[in] offset File offset
+         */
+        virtual void submit(SBuffer* buffer, std::size_t size, std::uint64_t offset) noexcept = 0;
+
+        /** Wait for all submitted writes completion */
+        virtual void drain() noexcept = 0;
+
+        /** Check io_uring usage
+         *
+         * \return True if io_uring is used
+         */
+        virtual bool uring() const noexcept = 0;
+
+        /** Failed writes amount
+         *
+         * \return Failed writes amount
+         */
+        std::size_t errors() const noexcept             { return _errors; }
+
+    protected:
+        /** Wait till at least one buffer is released */
+        virtual void waitCompletion() noexcept;
+
+        /** Return buffer to the pool
+         *
+         * \param[in] buffer Buffer to be released
+         */
+        void release(SBuffer* buffer) noexcept;
+
+        int _fd;
+        std::size_t _bufferSize;
+        std::vector<SBuffer> _buffers;
+        std::atomic<std::size_t> _errors{0};
+
+    private:
+        std::mutex _freeMutex;
+        std::condition_variable _freeCv;
+        std::vector<SBuffer*> _free;
+    };
+
+    /** Asynchronous file writer that uses dedicated pwrite(2) thread */
+    class APwriteFileWriter : public AAsyncFileWriter {
+    public:
+        /** Constructor
+         *
+         * \param[in] fd File descriptor. It is not owned by writer
+         * \param[in] options Writer options
+         */
+        APwriteFileWriter(int fd, const SAsyncFileOptions& options) noexcept;
+        ~APwriteFileWriter() noexcept override;
+
+        void submit(SBuffer* buffer, std::size_t size, std::uint64_t offset) noexcept override;
+        void drain() noexcept override;
+        bool uring() const noexcept override            { return false; }
+
+    private:
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::deque<SBuffer*> _queue;
+        std::size_t _inFlight{0};
+        bool _stop{false};
+        std::thread _thread;
+
+        void worker() noexcept;
+    };
+
+#ifdef AVN_LOGGER_URING
+    /** Asynchronous file writer that uses io_uring */
+    class AUringFileWriter : public AAsyncFileWriter {
+    public:
+        /** Constructor
+         *
+         * Check #isValid after construction. It is false if io_uring is not available.
+         *
+         * \param[in] fd File descriptor. It is not owned by writer
+         * \param[in] options Writer options
+         */
+        AUringFileWriter(int fd, const SAsyncFileOptions& options) noexcept;
+        ~AUringFileWriter() noexcept override;
+
+        /** Check io_uring initialization
+         *
+         * \return True if io_uring is initialized
+         */
+        bool isValid() const noexcept                   { return _ringFd >= 0; }
+
+        void submit(SBuffer* buffer, std::size_t size, std::uint64_t offset) noexcept override;
+        void drain() noexcept override;
+        bool uring() const noexcept override            { return true; }
+
+    protected:
+        void waitCompletion() noexcept override         { reap(true); }
+
+    private:
+        int _ringFd{-1};
+        bool _fixed{false};
+        std::size_t _inFlight{0};
+        unsigned _queued{0};        // Entries added to the submission queue but not submitted yet
+
+        void* _sqRing{MAP_FAILED};
+        std::size_t _sqRingSize{0};
+        void* _cqRing{MAP_FAILED};
+        std::size_t _cqRingSize{0};
+        io_uring_sqe* _sqes{nullptr};
+        std::size_t _sqesSize{0};
+
+        unsigned* _sqTail{nullptr};
+        unsigned* _sqMask{nullptr};
+        unsigned* _sqArray{nullptr};
+        unsigned* _cqHead{nullptr};
+        unsigned* _cqTail{nullptr};
+        unsigned* _cqMask{nullptr};
+        io_uring_cqe* _cqes{nullptr};
+
+        void push(SBuffer* buffer) noexcept;
+        void submitQueued() noexcept;
+        void writeSync(SBuffer* buffer) noexcept;
+        void reap(bool wait) noexcept;
+        void complete(bool wait) noexcept;
+        int enter(unsigned to_submit, unsigned min_complete, unsigned flags) noexcept;
+    };
+#endif // AVN_LOGGER_URING
+
+    inline AAsyncFileWriter::AAsyncFileWriter(int fd, const SAsyncFileOptions& options) noexcept :
+            _fd(fd),
+            _bufferSize((std::max<std::size_t>(options._bufferSize, 1) + Alignment - 1) / Alignment * Alignment),
+            _buffers(std::max<std::size_t>(options._buffers, 1))
+    {
+        _free.reserve(_buffers.size());
+        for (std::size_t index = 0; index < _buffers.size(); ++index) {
+            auto data{ static_cast<char*>(std::aligned_alloc(Alignment, _bufferSize)) };
+            if (data == nullptr) {
+                // Shrinking keeps the storage, so free list pointers stay valid
+                _buffers.resize(index);
+                break;
+            }
+
+            _buffers[index]._data = data;
+            _buffers[index]._index = index;
+            _free.push_back(&_buffers[index]);
+        }
+    }
+
+    inline AAsyncFileWriter::~AAsyncFileWriter() noexcept
+    {
+        for (auto& buffer : _buffers)
+            std::free(buffer._data);
+    }
+
+    inline AAsyncFileWriter::SBuffer* AAsyncFileWriter::acquire() noexcept
+    {
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(_freeMutex);
+                if (!_free.empty()) {
+                    auto buffer{ _free.back() };
+                    _free.pop_back();
+                    return buffer;
+                }
+            }
+            waitCompletion();
+        }
+    }
+
+    inline void AAsyncFileWriter::release(SBuffer* buffer) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(_freeMutex);
+            _free.push_back(buffer);
+        }
+        _freeCv.notify_one();
+    }
+
+    inline void AAsyncFileWriter::waitCompletion() noexcept
+    {
+        std::unique_lock<std::mutex> lock(_freeMutex);
+        _freeCv.wait(lock, [this] { return !_free.empty(); });
+    }
+
+    inline std::unique_ptr<AAsyncFileWriter> AAsyncFileWriter::create(int fd, const SAsyncFileOptions& options) noexcept
+    {
+#ifdef AVN_LOGGER_URING
+        if (options._uring) {
+            auto writer{ std::make_unique<AUringFileWriter>(fd, options) };
+            if (writer->isValid())
+                return writer;
+            if (writer->buffers() == 0)
+                return nullptr;
+        }
+#endif // AVN_LOGGER_URING
+
+        std::unique_ptr<AAsyncFileWriter> writer{ std::make_unique<APwriteFileWriter>(fd, options) };
+        if (writer->buffers() == 0)
+            writer.reset();
+
+        return writer;
+    }
+
+    inline APwriteFileWriter::APwriteFileWriter(int fd, const SAsyncFileOptions& options) noexcept :
+            AAsyncFileWriter(fd, options)
+    {
+        _thread = std::thread(&APwriteFileWriter::worker, this);
+    }
+
+    inline APwriteFileWriter::~APwriteFileWriter() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cv.notify_all();
+        _thread.join();
+    }
+
+    inline void APwriteFileWriter::submit(SBuffer* buffer, std::size_t size, std::uint64_t offset) noexcept
+    {
+        buffer->_size = size;
+        buffer->_offset = offset;
+        buffer->_done = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.push_back(buffer);
+            ++_inFlight;
+        }
+        _cv.notify_all();
+    }
+
+    inline void APwriteFileWriter::drain() noexcept
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this] { return _inFlight == 0; });
+    }
+
+    inline void APwriteFileWriter::worker() noexcept
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (true) {
+            _cv.wait(lock, [this] { return _stop || !_queue.empty(); });
+            if (_queue.empty())
+                break;
+
+            auto buffer{ _queue.front() };
+            _queue.pop_front();
+            lock.unlock();
+
+            while (buffer->_done < buffer->_size) {
+                const auto res{ ::pwrite(_fd, buffer->_data + buffer->_done, buffer->_size - buffer->_done,
+                                         static_cast<off_t>(buffer->_offset + buffer->_done)) };
+                if (res > 0) {
+                    buffer->_done += static_cast<std::size_t>(res);
+                } else if (res < 0 && errno == EINTR) {
+                    continue;
+                } else {
+                    ++_errors;
+                    break;
+                }
+            }
+            release(buffer);
+
+            lock.lock();
+            --_inFlight;
+            _cv.notify_all();
+        }
+    }
+
+#ifdef AVN_LOGGER_URING
+    inline AUringFileWriter::AUringFileWriter(int fd, const SAsyncFileOptions& options) noexcept :
+            AAsyncFileWriter(fd, options)
+    {
+        if (_buffers.empty())
+            return;
+
+        io_uring_params params{};
+        const int ring_fd{ static_cast<int>(::syscall(__NR_io_uring_setup, static_cast<unsigned>(_buffers.size()), &params)) };
+        if (ring_fd < 0)
+            return;
+
+        _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+            _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+
+        _sqRing = ::mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+        if (_sqRing != MAP_FAILED) {
+            _cqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? _sqRing :
+                      ::mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+        }
+
+        _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes{ MAP_FAILED };
+        if (_cqRing != MAP_FAILED)
+            sqes = ::mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+
+        if (sqes == MAP_FAILED) {
+            if (_cqRing != MAP_FAILED && _cqRing != _sqRing)
+                ::munmap(_cqRing, _cqRingSize);
+            if (_sqRing != MAP_FAILED)
+                ::munmap(_sqRing, _sqRingSize);
+            _sqRing = _cqRing = MAP_FAILED;
+            ::close(ring_fd);
+            return;
+        }
+
+        auto sq{ static_cast<char*>(_sqRing) };
+        auto cq{ static_cast<char*>(_cqRing) };
+
+        _sqes = static_cast<io_uring_sqe*>(sqes);
+        _sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        _sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        _sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        _cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        _cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        _cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        std::vector<iovec> iovecs(_buffers.size());
+        for (std::size_t index = 0; index < _buffers.size(); ++index)
+            iovecs[index] = { _buffers[index]._data, _bufferSize };
+
+        _fixed = ::syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_BUFFERS, iovecs.data(), static_cast<unsigned>(iovecs.size())) == 0;
+        _ringFd = ring_fd;
+    }
+
+    inline AUringFileWriter::~AUringFileWriter() noexcept
+    {
+        if (_ringFd < 0)
+            return;
+
+        drain();
+
+        ::munmap(_sqes, _sqesSize);
+        if (_cqRing != _sqRing)
+            ::munmap(_cqRing, _cqRingSize);
+        ::munmap(_sqRing, _sqRingSize);
+        ::close(_ringFd);
+    }
+
+    inline int AUringFileWriter::enter(unsigned to_submit, unsigned min_complete, unsigned flags) noexcept
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, _ringFd, to_submit, min_complete, flags, nullptr, _NSIG / 8));
+    }
+
+    inline void AUringFileWriter::push(SBuffer* buffer) noexcept
+    {
+        // Entry is only queued, so completions reaped during submission can requeue short writes without recursion
+        const unsigned tail{ *_sqTail };
+        const unsigned index{ tail & *_sqMask };
+        auto& sqe{ _sqes[index] };
+
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = _fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        sqe.fd = _fd;
+        sqe.addr = reinterpret_cast<std::uint64_t>(buffer->_data + buffer->_done);
+        sqe.len = static_cast<std::uint32_t>(buffer->_size - buffer->_done);
+        sqe.off = buffer->_offset + buffer->_done;
+        sqe.buf_index = static_cast<std::uint16_t>(_fixed ? buffer->_index : 0);
+        sqe.user_data = buffer->_index;
+
+        _sqArray[index] = index;
+        __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+        ++_queued;
+    }
+
+    inline void AUringFileWriter::submitQueued() noexcept
+    {
+        while (_queued != 0) {
+            const int res{ enter(_queued, 0, 0) };
+
+            if (res > 0) {
+                _queued -= static_cast<unsigned>(res);
+                continue;
+            }
+
+            if (res < 0 && (errno == EINTR || errno == EAGAIN || errno == EBUSY)) {
+                complete(false);
+                continue;
+            }
+
+            // Entries not consumed by io_uring_enter(2) are taken back and written synchronously
+            const unsigned tail{ *_sqTail - _queued };
+            std::vector<SBuffer*> buffers;
+            for (unsigned entry = tail; entry != *_sqTail; ++entry)
+                buffers.push_back(&_buffers[_sqes[_sqArray[entry & *_sqMask]].user_data]);
+
+            __atomic_store_n(_sqTail, tail, __ATOMIC_RELEASE);
+            _queued = 0;
+
+            for (auto buffer : buffers) {
+                ++_errors;
+                writeSync(buffer);
+            }
+        }
+    }
+
+    inline void AUringFileWriter::writeSync(SBuffer* buffer) noexcept
+    {
+        while (buffer->_done < buffer->_size) {
+            const auto res{ ::pwrite(_fd, buffer->_data + buffer->_done, buffer->_size - buffer->_done,
+                                     static_cast<off_t>(buffer->_offset + buffer->_done)) };
+            if (res > 0) {
+                buffer->_done += static_cast<std::size_t>(res);
+            } else if (res < 0 && errno == EINTR) {
+                continue;
+            } else {
+                ++_errors;
+                break;
+            }
+        }
+
+        --_inFlight;
+        release(buffer);
+    }
+
+    inline void AUringFileWriter::submit(SBuffer* buffer, std::size_t size, std::uint64_t offset) noexcept
+    {
+        buffer->_size = size;
+        buffer->_offset = offset;
+        buffer->_done = 0;
+
+        ++_inFlight;
+        push(buffer);
+        submitQueued();
+        reap(false);
+    }
+
+    inline void AUringFileWriter::reap(bool wait) noexcept
+    {
+        complete(wait);
+        submitQueued();
+    }
+
+    inline void AUringFileWriter::complete(bool wait) noexcept
+    {
+        unsigned head{ *_cqHead };
+
+        if (wait && _inFlight != 0 && head == __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE))
+            enter(0, 1, IORING_ENTER_GETEVENTS);
+
+        while (head != __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE)) {
+            const auto& cqe{ _cqes[head & *_cqMask] };
+            auto& buffer{ _buffers[cqe.user_data] };
+            const auto res{ cqe.res };
+
+            ++head;
+            __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+
+            if (res == -EINTR || res == -EAGAIN) {
+                push(&buffer);
+                continue;
+            }
+
+            if (res > 0) {
+                buffer._done += static_cast<std::size_t>(res);
+                if (buffer._done < buffer._size) {
+                    push(&buffer);
+                    continue;
+                }
+            } else {
+                ++_errors;
+            }
+
+            --_inFlight;
+            release(&buffer);
+        }
+    }
+
+    inline void AUringFileWriter::drain() noexcept
+    {
+        while (_inFlight != 0)
+            reap(true);
+    }
+#endif // AVN_LOGGER_URING
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_ASYNC_WRITER_H_
@@ -0,0 +1,355 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_txt_async_file.h
+ * \brief ALoggerTxtAsyncFile class implements text logging to a file with asynchronous writes.
+ *
+ * As #ALogger::ALoggerBase child this class has features listed below :
+ * - multithreading or single thread mode.
+ * - enable or disable logger levels. If current output message has level that is enabled now, it will be output. Also it
+ * is possible to output regardless of current logger level by using #forceAddToLog call.
+ * - add logger tasks and automatically finish them.
+ *
+ * Messages are collected into the fixed pool buffers. Filled buffer is handed to #ALogger::AAsyncFileWriter that
+ * writes it by io_uring or by dedicated pwrite(2) thread if io_uring is not available. Message producer never waits
+ * for write syscall completion except the case when all pool buffers are in flight.
+ *
+ * Partially filled buffer is handed to the writer only by #ALogger::ALoggerTxtAsyncFile::flushFile call or by the flush
+ * policy, see #ALogger::ALoggerFlushPolicy class description. No policy is set by default, so messages of the partially
+ * filled buffer are lost if the process crashes. Set the flush interval to limit this loss :
+ *
+ * \code
+
+    logger.setFlushPolicy({ 0, std::chrono::milliseconds(200) });  // Hand the buffer to the writer each 200 ms
+
+ * \endcode
+ *
+ * O_DIRECT mode can be enabled by #ALogger::SAsyncFileOptions::_directIO option. In this mode only aligned part of
+ * the current buffer is written by #ALogger::ALoggerTxtAsyncFile::flushFile call, the rest is written at file closing.
+ *
+ * \code
+
+    constexpr auto WARNING = 0;     // WARNING identifier
+
+    ALogger::ALoggerTxtAsyncFile<true, char> logger("/tmp/test.txt"s);
+
+    logger.addLevelDescr(WARNING, "WARNING");
+    logger.enableLevel(WARNING);
+    logger.addString(WARNING, "This is test string : integer = ", 10);
+
+ * \endcode
+ *
+ * \warning Only POSIX systems are supported.
+ */
+
+#ifndef _AVN_LOGGER_TXT_ASYNC_FILE_H_
+#define _AVN_LOGGER_TXT_ASYNC_FILE_H_
+
+#include <cstring>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <avn/logger/logger_txt_base.h>
+#include <avn/logger/logger_async_writer.h>
+#include <avn/logger/logger_flush_policy.h>
+
+namespace ALogger {
+
+    /** Text file logger with asynchronous writes
+     *
+     * \tparam _ThrSafe Thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated.
+     * \tparam _TChar Character type. Only char is currently supported.
+     */
+    template<bool _ThrSafe, typename _TChar>
+    class ALoggerTxtAsyncFile : public ALoggerTxtBase<_ThrSafe, _TChar> {
+    public:
+        /** Current thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated */
+        constexpr static bool ThrSafe{ _ThrSafe };
+
+        /** Character type for text logger messages */
+        using TChar = _TChar;
+
+        static_assert(std::is_same_v<TChar, char>, "Only char is currently supported by asynchronous file logger");
+
+        /** String type for text logger messages */
+        using TString = std::basic_string<_TChar>;
+
+        /** Default constructor
+         *
+         * \param[in] local_time Use local time instead of GMT one. True by default
+         */
+        ALoggerTxtAsyncFile(bool local_time = true) noexcept :
+                ALoggerTxtBase<_ThrSafe, _TChar>(local_time),
+                _flush([this](bool) { flushBuffer(); return -1; })    {}
+
+        /** Constructor with output file configuration
+         *
+         * #openFile is called after object construction
+         *
+         * \param[in] filename Output file name and path
+         * \param[in] append Append messages to the existing file. False by default
+         * \param[in] options Asynchronous writer options
+         * \param[in] local_time Use local time instead of GMT one. True by default
+         */
+        ALoggerTxtAsyncFile(const std::filesystem::path& filename, bool append = false, const SAsyncFileOptions& options = {}, bool local_time = true) noexcept :
+                ALoggerTxtAsyncFile(local_time)
+        {
+            openFile(filename, append, options);
+        }
+
+        ALoggerTxtAsyncFile(const ALoggerTxtAsyncFile&) = delete;
+
+        ~ALoggerTxtAsyncFile() noexcept override { closeFile(); }
+
+        /** Open file
+         *
+         * \param[in] filename Output file name and path
+         * \param[in] append Append messages to the existing file. False by default
+         * \param[in] options Asynchronous writer options
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtAsyncFile& openFile(const std::filesystem::path& filename, bool append = false, const SAsyncFileOptions& options = {}) noexcept;
+
+        /** Close currently opened file
+         *
+         * All pending writes are finished.
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtAsyncFile& closeFile() noexcept;
+
+        /** Hand current buffer to the writer
+         *
+         * This call does not wait for write completion.
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtAsyncFile& flushFile() noexcept                           { auto lock{ _flush.lock() }; flushBuffer(); _flush.flushed(); return *this; }
+
+        /** Set flush policy
+         *
+         * Flush hands the current buffer to the writer. fdatasync(2) option is not supported and is ignored.
+         *
+         * \param[in] policy Flush policy
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtAsyncFile& setFlushPolicy(const SFlushPolicy& policy) noexcept    { _flush.setPolicy(policy); return *this; }
+
+        /** Get flush policy engine
+         *
+         * \return Flush policy engine
+         */
+        const ALoggerFlushPolicy& flushPolicy() const noexcept              { return _flush; }
+
+        /** Check that output file is opened
+         *
+         * \return True if file is opened
+         */
+        bool IsOpenedFile() const noexcept                                 { return _fd >= 0; }
+
+        /** Check that output file is opened
+         *
+         * \return True if file is opened
+         */
+        operator bool () const noexcept                                    { return IsOpenedFile(); }
+
+        /** Check io_uring usage
+         *
+         * \return True if io_uring is used for writing
+         */
+        bool usesUring() const noexcept                                    { return _writer && _writer->uring(); }
+
+        /** Check O_DIRECT usage
+         *
+         * \return True if file is opened with O_DIRECT flag
+         */
+        bool usesDirectIO() const noexcept                                 { return _directIO; }
+
+        /** Failed writes amount
+         *
+         * \return Failed writes amount
+         */
+        std::size_t writeErrors() const noexcept                           { return _writer ? _writer->errors() : 0; }
+
+    private:
+        using TBuffer = AAsyncFileWriter::SBuffer;
+
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept override;
+        void append(const char* data, std::size_t size) noexcept;
+        void submit(std::size_t size) noexcept;
+        void flushBuffer() noexcept;
+
+        TString _line;      // Reusable message buffer
+        int _fd{-1};
+        bool _directIO{false};
+        std::unique_ptr<AAsyncFileWriter> _writer;
+        TBuffer* _buffer{nullptr};
+        std::size_t _filled{0};
+        std::uint64_t _offset{0};       // File offset of the current buffer
+        ALoggerFlushPolicy _flush;      // The last member, so its thread is stopped first
+    };
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtAsyncFile<_ThrSafe, _TChar>& ALoggerTxtAsyncFile<_ThrSafe, _TChar>::openFile(const std::filesystem::path& filename, bool append, const SAsyncFileOptions& options) noexcept
+    {
+        closeFile();
+
+        auto lock{ _flush.lock() };
+
+        const int flags{ O_WRONLY | O_CREAT | O_CLOEXEC | (append ? 0 : O_TRUNC) };
+
+        _directIO = false;
+#ifdef O_DIRECT
+        if (options._directIO) {
+            std::error_code ec;
+            const auto size{ append ? std::filesystem::file_size(filename, ec) : 0 };
+
+            // O_DIRECT writes must start from the aligned offset
+            if (ec || size % AAsyncFileWriter::Alignment == 0) {
+                _fd = ::open(filename.c_str(), flags | O_DIRECT, 0644);
+                _directIO = _fd >= 0;
+            }
+        }
+#endif // O_DIRECT
+        if (_fd < 0)
+            _fd = ::open(filename.c_str(), flags, 0644);
+        if (_fd < 0)
+            return *this;
+
+        struct stat st{};
+        _offset = ::fstat(_fd, &st) == 0 ? static_cast<std::uint64_t>(st.st_size) : 0;
+        _filled = 0;
+
+        _writer = AAsyncFileWriter::create(_fd, options);
+        if (!_writer) {
+            // Buffers memory is not allocated, so the file is not opened
+            ::close(_fd);
+            _fd = -1;
+            return *this;
+        }
+
+        _buffer = _writer->acquire();
+
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtAsyncFile<_ThrSafe, _TChar>& ALoggerTxtAsyncFile<_ThrSafe, _TChar>::closeFile() noexcept
+    {
+        auto lock{ _flush.lock() };
+
+        if (_fd < 0)
+            return *this;
+
+        const auto size{ _offset + _filled };
+
+        if (_filled != 0) {
+            if (_directIO) {
+                const auto aligned{ (_filled + AAsyncFileWriter::Alignment - 1) / AAsyncFileWriter::Alignment * AAsyncFileWriter::Alignment };
+                std::memset(_buffer->_data + _filled, 0, aligned - _filled);
+                submit(aligned);
+            } else {
+                submit(_filled);
+            }
+        }
+
+        _writer->drain();
+        _writer.reset();
+        _buffer = nullptr;
+
+        if (_directIO) {
+            [[maybe_unused]] const auto res{ ::ftruncate(_fd, static_cast<off_t>(size)) };
+        }
+
+        ::close(_fd);
+        _fd = -1;
+
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtAsyncFile<_ThrSafe, _TChar>::flushBuffer() noexcept
+    {
+        if (_fd < 0 || _filled == 0)
+            return;
+
+        if (!_directIO) {
+            submit(_filled);
+            _buffer = _writer->acquire();
+            return;
+        }
+
+        const auto aligned{ _filled / AAsyncFileWriter::Alignment * AAsyncFileWriter::Alignment };
+        if (aligned == 0)
+            return;
+
+        auto prev{ _buffer };
+        const auto tail{ _filled - aligned };
+
+        _buffer = _writer->acquire();
+        std::memcpy(_buffer->_data, prev->_data + aligned, tail);
+        _writer->submit(prev, aligned, _offset);
+        _offset += aligned;
+        _filled = tail;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtAsyncFile<_ThrSafe, _TChar>::submit(std::size_t size) noexcept
+    {
+        _writer->submit(_buffer, size, _offset);
+        _offset += size;
+        _filled = 0;
+        _buffer = nullptr;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtAsyncFile<_ThrSafe, _TChar>::append(const char* data, std::size_t size) noexcept
+    {
+        const auto capacity{ _writer->bufferSize() };
+
+        while (size != 0) {
+            const auto part{ std::min(size, capacity - _filled) };
+            std::memcpy(_buffer->_data + _filled, data, part);
+            _filled += part;
+            data += part;
+            size -= part;
+
+            if (_filled == capacity) {
+                submit(capacity);
+                _buffer = _writer->acquire();
+            }
+        }
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    bool ALoggerTxtAsyncFile<_ThrSafe, _TChar>::outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept
+    {
+        assert(_fd >= 0);
+
+        auto lock{ _flush.lock() };
+
+        if (_fd < 0)
+            return false;
+
+        auto& str{ _line };
+        str.clear();
+        ALoggerTxtBase<_ThrSafe, _TChar>::prepareString(str, level, time, data);
+        append(str.data(), str.size());
+        append("\n", 1);
+
+        if (_flush.written(level, str.size() + 1)) {
+            flushBuffer();
+            _flush.flushed();
+        }
+
+        return true;
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_TXT_ASYNC_FILE_H_
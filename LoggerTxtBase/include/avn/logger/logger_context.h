@@ -0,0 +1,154 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_context.h
+ * \brief ALoggerContext class implements thread-local context fields.
+ *
+ * Context is the list of fields, say, request identifier, tenant and worker name, that is attached to all records
+ * added by the current thread. It is pushed by #ALogger::ALoggerContext constructor or by
+ * #ALogger::ALoggerTxtBase::addContext call and popped at the object destruction, like tasks are.
+ *
+ * Each push makes the immutable #ALogger::SLogContext snapshot. It contains fields of all pushed contexts in the
+ * binary form, see logger_fields.h, and the text prefix rendered once at the push. Wide loggers decode the prefix once
+ * per character type too. Records hold the shared pointer to the snapshot, so they keep the context even if they are
+ * output at the task end. Records added without any context do not hold anything.
+ *
+ * Text loggers insert the cached prefix before the message, structured loggers output context fields as record
+ * fields.
+ *
+ * \code
+
+    {
+        auto context{ logger.addContext(ALogger::field("request", request_id), ALogger::field("tenant", tenant)) };
+
+        logger.addString(INFO, "Request started");      // [INFO] request=42 tenant=acme Request started
+    }
+
+ * \endcode
+ */
+
+#ifndef _AVN_LOGGER_CONTEXT_H_
+#define _AVN_LOGGER_CONTEXT_H_
+
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include <avn/logger/logger_fields.h>
+#include <avn/logger/logger_utf8.h>
+
+namespace ALogger {
+
+    /** Context snapshot */
+    struct SLogContext {
+        std::string _fields;        ///< Fields block of all pushed contexts
+        std::string _text;          ///< UTF-8 text prefix, "key=value " pairs
+
+        /** Text prefix
+         *
+         * Prefix of wide characters is decoded from #_text at the first call for the character type and is cached, so
+         * wide loggers do not decode it for each record.
+         *
+         * \tparam _TChar Character type
+         *
+         * \return Text prefix
+         */
+        template<typename _TChar>
+        std::basic_string_view<_TChar> text() const noexcept;
+
+    private:
+        // Snapshot is shared by threads, so the decoded prefix is made once
+        template<typename _TChar>
+        struct SDecoded {
+            std::once_flag _once;
+            std::basic_string<_TChar> _text;
+        };
+
+        mutable std::tuple<SDecoded<wchar_t>, SDecoded<char16_t>, SDecoded<char32_t>> _decoded;
+    };
+
+    /** Thread-local context frame
+     *
+     * Frame pushes fields to the current thread context at construction and pops them at destruction. Frames have to
+     * be destroyed in the reverse order.
+     */
+    class ALoggerContext {
+    public:
+        /** Context snapshot pointer */
+        using TContext = std::shared_ptr<const SLogContext>;
+
+        /** Push fields
+         *
+         * \tparam TFields Fields values types
+         *
+         * \param[in] fields Fields made by #ALogger::field calls
+         */
+        template<typename... TFields>
+        explicit ALoggerContext(const SField<TFields>&... fields) noexcept;
+
+        ALoggerContext(const ALoggerContext&) = delete;
+        ALoggerContext(ALoggerContext&&) = delete;
+        ALoggerContext& operator=(const ALoggerContext&) = delete;
+        ALoggerContext& operator=(ALoggerContext&&) = delete;
+
+        ~ALoggerContext() noexcept;
+
+        /** Current thread context
+         *
+         * \return Context snapshot or null pointer if no context is pushed
+         */
+        static const TContext& current() noexcept                          { return top(); }
+
+    private:
+        TContext _previous;
+        const SLogContext* _pushed;
+
+        static TContext& top() noexcept                                     { thread_local TContext context; return context; }
+    };
+
+    template<typename... TFields>
+    ALoggerContext::ALoggerContext(const SField<TFields>&... fields) noexcept :
+            _previous(top())
+    {
+        auto context{ std::make_shared<SLogContext>() };
+
+        if (_previous)
+            context->_fields = _previous->_fields;
+        (Fields::encode(context->_fields, fields), ...);
+
+        Fields::appendPairs(context->_text, context->_fields);
+        if (!context->_text.empty()) {
+            // " key=value" pairs are turned into the "key=value " prefix
+            context->_text.erase(0, 1);
+            context->_text.push_back(' ');
+        }
+
+        _pushed = context.get();
+        top() = std::move(context);
+    }
+
+    template<typename _TChar>
+    std::basic_string_view<_TChar> SLogContext::text() const noexcept
+    {
+        if constexpr (std::is_same_v<_TChar, char>) {
+            return _text;
+        } else {
+            auto& decoded{ std::get<SDecoded<_TChar>>(_decoded) };
+            std::call_once(decoded._once, [this, &decoded] { Utf8::decode(decoded._text, _text); });
+            return decoded._text;
+        }
+    }
+
+    inline ALoggerContext::~ALoggerContext() noexcept
+    {
+        assert(top().get() == _pushed);
+        top() = std::move(_previous);
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_CONTEXT_H_
@@ -0,0 +1,257 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_fields.h
+ * \brief Typed key-value fields of text logger records.
+ *
+ * Fields are created by #ALogger::field call and added to the record by #ALogger::ALoggerTxtBase::addFields call.
+ * Integers, floating point numbers, booleans, durations and strings are supported. Fields are not converted to text
+ * while the record is added. They are stored in the compact binary block of #ALogger::ALoggerTxtRecord and rendered
+ * only when the record is output, so fields of records dropped by level checks or by succeeded tasks are never
+ * stringified.
+ *
+ * Block is a sequence of entries, each entry is :
+ * - value type, 1 byte, see #ALogger::EFieldType ;
+ * - key size, 1 byte, and key ;
+ * - value : 8 bytes for numbers and durations in the native byte order, 1 byte for booleans, 4 bytes size and bytes
+ * for strings.
+ *
+ * Block lives only in memory, so it is not portable. Keys longer than 255 bytes are truncated.
+ *
+ * \code
+
+    using namespace std::chrono_literals;
+
+    logger.addFields(INFO, "Request finished", ALogger::field("status", 200), ALogger::field("elapsed", 15ms),
+                     ALogger::field("user", user_name));
+
+ * \endcode
+ */
+
+#ifndef _AVN_LOGGER_FIELDS_H_
+#define _AVN_LOGGER_FIELDS_H_
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <avn/logger/logger_json_escape.h>
+
+namespace ALogger {
+
+    /** Field value type */
+    enum class EFieldType : std::uint8_t {
+        INT,            ///< Signed integer
+        UINT,           ///< Unsigned integer
+        DOUBLE,         ///< Floating point number
+        BOOL,           ///< Boolean
+        STRING,         ///< UTF-8 string
+        DURATION        ///< Duration in nanoseconds
+    };
+
+    /** Field to be added to the record
+     *
+     * \tparam T Stored value type
+     */
+    template<typename T>
+    struct SField {
+        std::string_view _key;      ///< Field key
+        T _value;                   ///< Field value
+    };
+
+    /** Decoded field */
+    struct SFieldValue {
+        std::string_view _key;      ///< Field key
+        EFieldType _type;           ///< Value type
+        std::int64_t _int{0};       ///< Signed integer, boolean or duration value
+        std::uint64_t _uint{0};     ///< Unsigned integer value
+        double _double{0};          ///< Floating point value
+        std::string_view _string;   ///< String value
+    };
+
+    /** Make field
+     *
+     * \tparam T Value type. Integers, floating point numbers, booleans, std::chrono::duration and types convertible to
+     * std::string_view are supported
+     *
+     * \param[in] key Field key. It has to be valid until the field is added to the record
+     * \param[in] value Field value. Strings have to be valid until the field is added to the record
+     *
+     * \return Field
+     */
+    template<typename T>
+    auto field(std::string_view key, const T& value) noexcept
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return SField<bool>{ key, value };
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            return SField<std::int64_t>{ key, static_cast<std::int64_t>(value) };
+        else if constexpr (std::is_integral_v<T>)
+            return SField<std::uint64_t>{ key, static_cast<std::uint64_t>(value) };
+        else if constexpr (std::is_floating_point_v<T>)
+            return SField<double>{ key, static_cast<double>(value) };
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            return SField<std::string_view>{ key, std::string_view(value) };
+        else
+            return SField<std::chrono::nanoseconds>{ key, std::chrono::duration_cast<std::chrono::nanoseconds>(value) };
+    }
+
+    namespace Fields {
+
+        /** Field value type for stored value type
+         *
+         * \tparam T Stored value type
+         */
+        template<typename T>
+        constexpr EFieldType type() noexcept
+        {
+            if constexpr (std::is_same_v<T, bool>)                              return EFieldType::BOOL;
+            else if constexpr (std::is_same_v<T, std::int64_t>)                 return EFieldType::INT;
+            else if constexpr (std::is_same_v<T, std::uint64_t>)                return EFieldType::UINT;
+            else if constexpr (std::is_same_v<T, double>)                       return EFieldType::DOUBLE;
+            else if constexpr (std::is_same_v<T, std::string_view>)             return EFieldType::STRING;
+            else                                                                return EFieldType::DURATION;
+        }
+
+        /** Append field to the block
+         *
+         * \tparam T Stored value type
+         * \param[out] block Fields block
+         * \param[in] field Field
+         */
+        template<typename T>
+        void encode(std::string& block, const SField<T>& field) noexcept
+        {
+            const auto key_size{ std::min<std::size_t>(field._key.size(), 255) };
+
+            block.push_back(static_cast<char>(type<T>()));
+            block.push_back(static_cast<char>(key_size));
+            block.append(field._key.data(), key_size);
+
+            if constexpr (std::is_same_v<T, bool>) {
+                block.push_back(field._value ? 1 : 0);
+            } else if constexpr (std::is_same_v<T, std::string_view>) {
+                const auto size{ static_cast<std::uint32_t>(field._value.size()) };
+                block.append(reinterpret_cast<const char*>(&size), sizeof(size));
+                block.append(field._value.data(), size);
+            } else {
+                std::int64_t bits;
+                if constexpr (std::is_same_v<T, std::chrono::nanoseconds>)
+                    bits = field._value.count();
+                else
+                    std::memcpy(&bits, &field._value, sizeof(bits));
+                block.append(reinterpret_cast<const char*>(&bits), sizeof(bits));
+            }
+        }
+
+        /** Call function for each field of the block
+         *
+         * \tparam TFunc Function type with const #ALogger::SFieldValue& argument
+         * \param[in] block Fields block
+         * \param[in] func Function
+         */
+        template<typename TFunc>
+        void forEach(std::string_view block, TFunc&& func) noexcept
+        {
+            std::size_t pos{0};
+
+            while (pos + 2 <= block.size()) {
+                SFieldValue value;
+                value._type = static_cast<EFieldType>(block[pos]);
+                const auto key_size{ static_cast<unsigned char>(block[pos + 1]) };
+                value._key = block.substr(pos + 2, key_size);
+                pos += 2 + key_size;
+
+                switch (value._type) {
+                case EFieldType::BOOL :
+                    value._int = block[pos] != 0;
+                    pos += 1;
+                    break;
+                case EFieldType::STRING : {
+                    std::uint32_t size;
+                    std::memcpy(&size, block.data() + pos, sizeof(size));
+                    value._string = block.substr(pos + sizeof(size), size);
+                    pos += sizeof(size) + size;
+                    break;
+                }
+                default :
+                    std::memcpy(&value._int, block.data() + pos, sizeof(value._int));
+                    std::memcpy(&value._uint, block.data() + pos, sizeof(value._uint));
+                    std::memcpy(&value._double, block.data() + pos, sizeof(value._double));
+                    pos += sizeof(std::int64_t);
+                    break;
+                }
+
+                func(value);
+            }
+        }
+
+        /** Append number
+         *
+         * \tparam T Number type
+         * \param[out] out Output buffer
+         * \param[in] value Number
+         */
+        template<typename T>
+        void appendNumber(std::string& out, T value) noexcept
+        {
+            char buffer[32];
+            const auto res{ std::to_chars(buffer, buffer + sizeof(buffer), value) };
+            out.append(buffer, res.ptr);
+        }
+
+        /** Duration in seconds
+         *
+         * \param[in] value Decoded duration field
+         *
+         * \return Seconds
+         */
+        inline double seconds(const SFieldValue& value) noexcept   { return static_cast<double>(value._int) / 1e9; }
+
+        /** Append value as text
+         *
+         * Strings are written as logfmt values, see #ALogger::JsonEscape::appendLogfmt, durations are written in seconds
+         * with "s" suffix.
+         *
+         * \param[out] out Output buffer
+         * \param[in] value Decoded field
+         */
+        inline void appendText(std::string& out, const SFieldValue& value) noexcept
+        {
+            switch (value._type) {
+            case EFieldType::INT :      appendNumber(out, value._int); break;
+            case EFieldType::UINT :     appendNumber(out, value._uint); break;
+            case EFieldType::DOUBLE :   appendNumber(out, value._double); break;
+            case EFieldType::BOOL :     out.append(value._int != 0 ? "true" : "false"); break;
+            case EFieldType::DURATION : appendNumber(out, seconds(value)); out.push_back('s'); break;
+            case EFieldType::STRING :   JsonEscape::appendLogfmt(out, value._string); break;
+            }
+        }
+
+        /** Append fields block as text
+         *
+         * Each field is appended as " key=value" pair, see #appendText.
+         *
+         * \param[out] out Output buffer
+         * \param[in] block Fields block
+         */
+        inline void appendPairs(std::string& out, std::string_view block) noexcept
+        {
+            forEach(block, [&out](const SFieldValue& value) {
+                out.push_back(' ');
+                JsonEscape::appendLogfmtKey(out, value._key);
+                out.push_back('=');
+                appendText(out, value);
+            });
+        }
+
+    } // namespace Fields
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_FIELDS_H_
@@ -0,0 +1,291 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_flush_policy.h
+ * \brief ALoggerFlushPolicy class decides when text stream loggers flush their output.
+ *
+ * Text stream loggers end each message by the new line character and do not flush the stream. Output is flushed
+ * according to #ALogger::SFlushPolicy :
+ * - when unflushed data size reaches specified characters amount ;
+ * - by the timer each specified milliseconds amount if there is unflushed data ;
+ * - instantly for listed levels or for each message ;
+ * - optional fdatasync(2) group commit. Each flush by the timer is followed by fdatasync(2). Messages with listed
+ * levels wait for fdatasync(2) completion after output, and one fdatasync(2) call covers all messages accepted
+ * before it, so simultaneous producers share the same call.
+ *
+ * Timer and fdatasync(2) calls are performed by the background thread that is started only if needed. Output is always
+ * protected by #ALogger::ALoggerFlushPolicy::lock mutex, even in single thread mode, because the thread can be started
+ * by #ALogger::ALoggerFlushPolicy::setPolicy call at any moment. The mutex is not contended without the thread.
+ *
+ * \warning #ALogger::ALoggerFlushPolicy::setPolicy calls must not be made simultaneously by different threads.
+ *
+ * \code
+
+    ALogger::ALoggerTxtFile<true, char> logger("/tmp/test.txt"s);
+
+    logger.setFlushPolicy({ 64 * 1024,                          // Flush after 64 KB
+                            std::chrono::milliseconds(200),     // or each 200 ms
+                            { CRITICAL },                       // or instantly for CRITICAL messages
+                            false,                              // Do not flush each message
+                            true });                            // Wait for CRITICAL messages to be on the disk
+
+ * \endcode
+ */
+
+#ifndef _AVN_LOGGER_FLUSH_POLICY_H_
+#define _AVN_LOGGER_FLUSH_POLICY_H_
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <avn/logger/data_types.h>
+
+namespace ALogger {
+
+    /** Output flush policy */
+    struct SFlushPolicy {
+        /** Flush when unflushed characters amount reaches this value. Zero disables this criterion */
+        std::size_t _bytes{0};
+
+        /** Flush unflushed data each interval. Zero disables the timer */
+        std::chrono::milliseconds _interval{0};
+
+        /** Levels to be flushed instantly. If #_datasync is enabled, they also wait for fdatasync(2) group commit */
+        TLevels _levels;
+
+        /** Flush each message */
+        bool _always{false};
+
+        /** Use fdatasync(2) for timer flushes and group commit for #_levels */
+        bool _datasync{false};
+    };
+
+    /** Output flush policy engine */
+    class ALoggerFlushPolicy {
+    public:
+        /** Flush function type
+         *
+         * This function flushes output stream. If \a datasync is true, it returns file descriptor duplicate to be
+         * synchronized by fdatasync(2) and closed by the caller, or -1 if synchronization is not possible.
+         *
+         * \param[in] datasync Return file descriptor duplicate
+         *
+         * \return File descriptor duplicate or -1
+         */
+        using TFlush = std::function<int (bool datasync)>;
+
+        /** Constructor
+         *
+         * \param[in] flush Flush function that is called by the background thread
+         * \param[in] policy Initial policy
+         */
+        ALoggerFlushPolicy(TFlush flush, SFlushPolicy policy = {}) noexcept : _flush(std::move(flush))  { setPolicy(std::move(policy)); }
+
+        ALoggerFlushPolicy(const ALoggerFlushPolicy&) = delete;
+        ALoggerFlushPolicy& operator=(const ALoggerFlushPolicy&) = delete;
+
+        ~ALoggerFlushPolicy() noexcept                                      { stop(); }
+
+        /** Set new policy
+         *
+         * Background thread is restarted if needed.
+         *
+         * \param[in] policy New policy
+         */
+        void setPolicy(SFlushPolicy policy) noexcept;
+
+        /** Get current policy
+         *
+         * \return Current policy
+         */
+        const SFlushPolicy& policy() const noexcept                          { return _policy; }
+
+        /** Lock output
+         *
+         * Output has to be locked during the whole message output.
+         *
+         * \return Output lock
+         */
+        std::unique_lock<std::mutex> lock() noexcept                        { return std::unique_lock<std::mutex>(_mutex); }
+
+        /** Register written message
+         *
+         * This function has to be called under #lock after message output.
+         *
+         * \param[in] level Message level
+         * \param[in] size Characters amount written
+         *
+         * \return True if output has to be flushed now
+         */
+        bool written(std::size_t level, std::size_t size) noexcept
+        {
+            ++_accepted;
+            _pending += size;
+            return _policy._always || (_policy._bytes != 0 && _pending >= _policy._bytes) || _policy._levels.count(level) != 0;
+        }
+
+        /** Register output flush
+         *
+         * This function has to be called under #lock after output flush.
+         */
+        void flushed() noexcept                                             { _pending = 0; ++_flushes; }
+
+        /** Wait for message durability
+         *
+         * If fdatasync(2) group commit is enabled and \a level is listed in the policy, this call waits until
+         * fdatasync(2) covering all messages accepted so far is finished. It must be called without #lock.
+         *
+         * \param[in] level Message level
+         */
+        void commit(std::size_t level) noexcept;
+
+        /** Flushes amount
+         *
+         * \return Output flushes amount performed both by producers and by the background thread
+         */
+        std::size_t flushes() const noexcept                                { return _flushes; }
+
+        /** fdatasync(2) calls amount
+         *
+         * \return fdatasync(2) calls amount
+         */
+        std::size_t datasyncs() const noexcept                              { return _datasyncs; }
+
+    private:
+        TFlush _flush;
+        SFlushPolicy _policy;
+
+        std::size_t _pending{0};
+        std::uint64_t _accepted{0};
+        std::uint64_t _committed{0};
+        std::uint64_t _commitRequested{0};
+        std::size_t _flushes{0};
+        std::size_t _datasyncs{0};
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::condition_variable _committedCv;
+        bool _stop{false};
+        bool _running{false};           // Background thread accepts requests. It is guarded by _mutex
+        std::thread _thread;
+
+        void stop() noexcept;
+        void worker() noexcept;
+    };
+
+    inline void ALoggerFlushPolicy::stop() noexcept
+    {
+        if (!_thread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cv.notify_one();
+        _thread.join();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = false;
+    }
+
+    inline void ALoggerFlushPolicy::setPolicy(SFlushPolicy policy) noexcept
+    {
+        stop();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _policy = std::move(policy);
+        _committed = _commitRequested = _accepted;
+
+        if (_policy._interval.count() != 0 || _policy._datasync) {
+            _running = true;
+            _thread = std::thread(&ALoggerFlushPolicy::worker, this);
+        }
+    }
+
+    inline void ALoggerFlushPolicy::commit(std::size_t level) noexcept
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        if (!_running || !_policy._datasync || _policy._levels.count(level) == 0)
+            return;
+
+        const auto target{ _accepted };
+
+        if (_committed >= target)
+            return;
+
+        if (_commitRequested < target) {
+            _commitRequested = target;
+            _cv.notify_one();
+        }
+
+        _committedCv.wait(lock, [this, target] { return _committed >= target; });
+    }
+
+    inline void ALoggerFlushPolicy::worker() noexcept
+    {
+        using TClock = std::chrono::steady_clock;
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        auto next_timer{ TClock::now() + _policy._interval };
+
+        while (!_stop) {
+            const auto wake_up = [this] { return _stop || _commitRequested > _committed; };
+
+            if (_policy._interval.count() == 0)
+                _cv.wait(lock, wake_up);
+            else if (!_cv.wait_until(lock, next_timer, wake_up))
+                next_timer = TClock::now() + _policy._interval;
+
+            if (_stop)
+                break;
+
+            const bool to_commit{ _commitRequested > _committed };
+            if (!to_commit && _pending == 0)
+                continue;
+
+            const auto target{ _accepted };
+            const int fd{ _flush(_policy._datasync) };
+            flushed();
+
+            if (fd < 0) {
+                _committed = target;
+                _committedCv.notify_all();
+                continue;
+            }
+
+            lock.unlock();
+#if __has_include(<unistd.h>)
+#if defined(_POSIX_SYNCHRONIZED_IO) && _POSIX_SYNCHRONIZED_IO > 0
+            ::fdatasync(fd);
+#else
+            ::fsync(fd);
+#endif
+            ::close(fd);
+#endif
+            lock.lock();
+
+            ++_datasyncs;
+            _committed = std::max(_committed, target);
+            _committedCv.notify_all();
+        }
+
+        _running = false;
+        _committed = _accepted;
+        _committedCv.notify_all();
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_FLUSH_POLICY_H_
@@ -0,0 +1,403 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_format.h
+ * \brief Compile-time checked format strings.
+ *
+ * Format string is passed to #ALogger::ALoggerTxtBase::addFormat by #AVN_FMT macro. Macro makes the unique type
+ * that holds the string, so the string is parsed at compile time into the fixed operations array. Placeholders
+ * amount and types are checked against arguments by static_assert, and the message is built by unrolled operations
+ * without any runtime parsing.
+ *
+ * Replacement field syntax is the subset of std::format one :
+ * \code{.unparsed}
+    {[:[[fill]align][0][width][.precision][type]]}
+ * \endcode
+ * - fill : any character except braces, space by default ;
+ * - align : '<' left, '>' right, '^' center. Numbers are aligned right by default, other values left ;
+ * - 0 : pad numbers by zeroes after the sign ;
+ * - width : minimum field width in code units ;
+ * - precision : digits after the decimal point for floating point numbers, maximum size for strings ;
+ * - type : 'd', 'x', 'X', 'o', 'b' for integers, 'f', 'e', 'g' for floating point numbers, 's' for strings and
+ * booleans, 'c' for characters. Default representation is used if type is omitted.
+ *
+ * Arguments are used in order, positional arguments are not supported. "{{" and "}}" output braces. Arguments of other
+ * types are output by #ALogger::toStrStream or #ALogger::toStrBuffer calls as in #ALogger::ALoggerTxtBase::addString.
+ *
+ * \code
+
+    logger.addFormat(INFO, AVN_FMT("x={} y={:.3f} id={:08x}"), x, y, id);
+    wlogger.addFormat(INFO, AVN_FMT(L"name={:>10}"), name);
+
+ * \endcode
+ */
+
+#ifndef _AVN_LOGGER_FORMAT_H_
+#define _AVN_LOGGER_FORMAT_H_
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/** Compile-time format string
+ *
+ * \param[in] str Format string literal of the logger character type
+ */
+#define AVN_FMT(str)                                                                                                    \
+    [] {                                                                                                                \
+        struct SFormatString {                                                                                          \
+            static constexpr auto value() noexcept { return std::basic_string_view(str); }                              \
+        };                                                                                                              \
+        return SFormatString{};                                                                                         \
+    }()
+
+namespace ALogger {
+
+    namespace Format {
+
+        /** Field alignment */
+        enum class EAlign : std::uint8_t {
+            DEFAULT, LEFT, RIGHT, CENTER
+        };
+
+        /** Argument kind used for compile-time type checks */
+        enum class EKind : std::uint8_t {
+            INT, FLOAT, BOOL, CHAR, STRING, OTHER
+        };
+
+        /** Format operation */
+        struct SOp {
+            bool _arg{false};                   ///< Argument or literal text
+            std::size_t _offset{0};             ///< Literal text position in the format string
+            std::size_t _size{0};               ///< Literal text size
+            std::size_t _index{0};              ///< Argument index
+            EAlign _align{ EAlign::DEFAULT };   ///< Alignment
+            char32_t _fill{' '};                ///< Fill character
+            bool _zero{false};                  ///< Pad numbers by zeroes
+            std::size_t _width{0};              ///< Minimum width
+            int _precision{-1};                 ///< Precision, -1 if it is not set
+            char _type{0};                      ///< Presentation type, 0 if it is not set
+        };
+
+        /** Parsing result */
+        struct SParsed {
+            bool _valid{true};          ///< Format string is valid
+            std::size_t _ops{0};        ///< Operations amount
+            std::size_t _args{0};       ///< Placeholders amount
+        };
+
+        /** Parse format string
+         *
+         * \tparam _TChar Character type
+         * \param[in] fmt Format string
+         * \param[out] ops Operations array. If it is null, operations are only counted
+         *
+         * \return Parsing result
+         */
+        template<typename _TChar>
+        constexpr SParsed parse(std::basic_string_view<_TChar> fmt, SOp* ops) noexcept
+        {
+            SParsed res;
+            std::size_t text{0};
+
+            const auto add = [&](const SOp& op) {
+                if (ops != nullptr)
+                    ops[res._ops] = op;
+                ++res._ops;
+            };
+            const auto add_text = [&](std::size_t end) {
+                if (end > text) {
+                    SOp op;
+                    op._offset = text;
+                    op._size = end - text;
+                    add(op);
+                }
+            };
+            const auto digit = [](_TChar ch) { return ch >= '0' && ch <= '9'; };
+            const auto align = [](_TChar ch) {
+                return ch == '<' ? EAlign::LEFT : ch == '>' ? EAlign::RIGHT : ch == '^' ? EAlign::CENTER : EAlign::DEFAULT;
+            };
+
+            std::size_t pos{0};
+
+            while (pos < fmt.size()) {
+                const auto ch{ fmt[pos] };
+
+                if (ch == '}') {
+                    if (pos + 1 == fmt.size() || fmt[pos + 1] != '}')
+                        return { false, 0, 0 };
+                    add_text(pos + 1);
+                    pos += 2;
+                    text = pos;
+                    continue;
+                }
+
+                if (ch != '{') {
+                    ++pos;
+                    continue;
+                }
+
+                if (pos + 1 < fmt.size() && fmt[pos + 1] == '{') {
+                    add_text(pos + 1);
+                    pos += 2;
+                    text = pos;
+                    continue;
+                }
+
+                add_text(pos);
+                ++pos;
+
+                SOp op;
+                op._arg = true;
+                op._index = res._args++;
+
+                if (pos < fmt.size() && fmt[pos] == ':') {
+                    ++pos;
+
+                    if (pos + 1 < fmt.size() && align(fmt[pos + 1]) != EAlign::DEFAULT && fmt[pos] != '{' && fmt[pos] != '}') {
+                        op._fill = static_cast<char32_t>(fmt[pos]);
+                        op._align = align(fmt[pos + 1]);
+                        pos += 2;
+                    } else if (pos < fmt.size() && align(fmt[pos]) != EAlign::DEFAULT) {
+                        op._align = align(fmt[pos]);
+                        ++pos;
+                    }
+
+                    if (pos < fmt.size() && fmt[pos] == '0') {
+                        op._zero = true;
+                        ++pos;
+                    }
+
+                    for (; pos < fmt.size() && digit(fmt[pos]); ++pos)
+                        op._width = op._width * 10 + static_cast<std::size_t>(fmt[pos] - '0');
+
+                    if (pos < fmt.size() && fmt[pos] == '.') {
+                        ++pos;
+                        if (pos == fmt.size() || !digit(fmt[pos]))
+                            return { false, 0, 0 };
+                        op._precision = 0;
+                        for (; pos < fmt.size() && digit(fmt[pos]); ++pos)
+                            op._precision = op._precision * 10 + static_cast<int>(fmt[pos] - '0');
+                    }
+
+                    if (pos < fmt.size() && fmt[pos] != '}') {
+                        switch (fmt[pos]) {
+                        case 'd' : case 'x' : case 'X' : case 'o' : case 'b' :
+                        case 'f' : case 'e' : case 'g' : case 's' : case 'c' :
+                            op._type = static_cast<char>(fmt[pos]);
+                            ++pos;
+                            break;
+                        default :
+                            return { false, 0, 0 };
+                        }
+                    }
+                }
+
+                if (pos == fmt.size() || fmt[pos] != '}')
+                    return { false, 0, 0 };
+
+                add(op);
+                ++pos;
+                text = pos;
+            }
+
+            add_text(pos);
+
+            return res;
+        }
+
+        /** Compiled format string
+         *
+         * \tparam TFormat Format string type made by #AVN_FMT macro
+         */
+        template<typename TFormat>
+        struct SCompiled {
+            /** Format string */
+            static constexpr auto Text{ TFormat::value() };
+
+            /** Character type */
+            using TChar = typename decltype(Text)::value_type;
+
+            /** Parsing result */
+            static constexpr SParsed Parsed{ parse(Text, nullptr) };
+
+            static_assert(Parsed._valid, "Invalid format string");
+
+            /** Operations */
+            static constexpr auto Ops{ [] {
+                std::array<SOp, Parsed._ops> ops{};
+                parse(Text, ops.data());
+                return ops;
+            }() };
+        };
+
+        /** Argument kind
+         *
+         * \tparam _TChar Message character type
+         * \tparam T Argument type
+         */
+        template<typename _TChar, typename T>
+        constexpr EKind kind() noexcept
+        {
+            using TArg = std::decay_t<T>;
+
+            if constexpr (std::is_same_v<TArg, bool>)
+                return EKind::BOOL;
+            else if constexpr (std::is_same_v<TArg, char> || std::is_same_v<TArg, _TChar>)
+                return EKind::CHAR;
+            else if constexpr (std::is_integral_v<TArg>)
+                return EKind::INT;
+            else if constexpr (std::is_floating_point_v<TArg>)
+                return EKind::FLOAT;
+            else if constexpr (std::is_convertible_v<const TArg&, std::basic_string_view<_TChar>> || std::is_convertible_v<const TArg&, std::string_view>)
+                return EKind::STRING;
+            else
+                return EKind::OTHER;
+        }
+
+        /** Check that presentation type fits the argument kind
+         *
+         * \param[in] type Presentation type
+         * \param[in] kind Argument kind
+         *
+         * \return True if type is allowed
+         */
+        constexpr bool allowed(char type, EKind kind) noexcept
+        {
+            switch (type) {
+            case 0 :    return true;
+            case 'd' : case 'x' : case 'X' : case 'o' : case 'b' :
+                        return kind == EKind::INT || kind == EKind::CHAR;
+            case 'f' : case 'e' : case 'g' :
+                        return kind == EKind::FLOAT;
+            case 's' :  return kind == EKind::STRING || kind == EKind::BOOL;
+            case 'c' :  return kind == EKind::CHAR || kind == EKind::INT;
+            default :   return false;
+            }
+        }
+
+        /** Check arguments against compiled format string
+         *
+         * \tparam TFormat Format string type
+         * \tparam T Arguments types
+         *
+         * \return True if all presentation types fit arguments
+         */
+        template<typename TFormat, typename... T>
+        constexpr bool check() noexcept
+        {
+            using TCompiled = SCompiled<TFormat>;
+            constexpr EKind kinds[]{ kind<typename TCompiled::TChar, T>()..., EKind::OTHER };
+
+            for (const auto& op : TCompiled::Ops)
+                if (op._arg && !allowed(op._type, kinds[op._index]))
+                    return false;
+
+            return true;
+        }
+
+        /** Append padding and align the field
+         *
+         * \tparam _TChar Character type
+         * \param[in,out] out Output buffer
+         * \param[in] start Field start position
+         * \param[in] op Format operation
+         * \param[in] number Field is a number
+         */
+        template<typename _TChar>
+        void pad(std::basic_string<_TChar>& out, std::size_t start, const SOp& op, bool number) noexcept
+        {
+            const auto size{ out.size() - start };
+            if (size >= op._width)
+                return;
+
+            const auto fill{ op._width - size };
+
+            if (op._zero && number && op._align == EAlign::DEFAULT) {
+                const auto sign{ start < out.size() && (out[start] == '-' || out[start] == '+') ? 1u : 0u };
+                out.insert(start + sign, fill, static_cast<_TChar>('0'));
+                return;
+            }
+
+            auto align{ op._align };
+            if (align == EAlign::DEFAULT)
+                align = number ? EAlign::RIGHT : EAlign::LEFT;
+
+            const auto ch{ static_cast<_TChar>(op._fill) };
+            const std::size_t before{ align == EAlign::RIGHT ? fill : align == EAlign::CENTER ? fill / 2 : 0 };
+
+            out.insert(start, before, ch);
+            out.append(fill - before, ch);
+        }
+
+        /** Append integer
+         *
+         * \tparam _TChar Character type
+         * \tparam T Integer type
+         * \param[out] out Output buffer
+         * \param[in] value Value
+         * \param[in] type Presentation type
+         */
+        template<typename _TChar, typename T>
+        void appendInt(std::basic_string<_TChar>& out, T value, char type) noexcept
+        {
+            const int base{ type == 'x' || type == 'X' ? 16 : type == 'o' ? 8 : type == 'b' ? 2 : 10 };
+
+            char buffer[72];
+            const auto res{ std::to_chars(buffer, buffer + sizeof(buffer), value, base) };
+
+            if (type == 'X')
+                for (auto* ch = buffer; ch != res.ptr; ++ch)
+                    if (*ch >= 'a' && *ch <= 'f')
+                        *ch = static_cast<char>(*ch - 'a' + 'A');
+
+            out.append(buffer, res.ptr);
+        }
+
+        /** Append floating point number
+         *
+         * \tparam _TChar Character type
+         * \tparam T Floating point type
+         * \param[out] out Output buffer
+         * \param[in] value Value
+         * \param[in] op Format operation
+         */
+        template<typename _TChar, typename T>
+        void appendFloat(std::basic_string<_TChar>& out, T value, const SOp& op) noexcept
+        {
+            const auto convert = [&](char* first, char* last) {
+                if (op._type == 0 && op._precision < 0)
+                    return std::to_chars(first, last, value);
+                const auto format{ op._type == 'f' ? std::chars_format::fixed : op._type == 'e' ? std::chars_format::scientific : std::chars_format::general };
+                return std::to_chars(first, last, value, format, op._precision < 0 ? 6 : op._precision);
+            };
+
+            char buffer[512];
+            auto res{ convert(buffer, buffer + sizeof(buffer)) };
+
+            if (res.ec == std::errc()) {
+                out.append(buffer, res.ptr);
+                return;
+            }
+
+            // Large precision or huge value in fixed format does not fit the stack buffer
+            std::string large(sizeof(buffer), '\0');
+            while (res.ec == std::errc::value_too_large) {
+                large.resize(large.size() * 2);
+                res = convert(large.data(), large.data() + large.size());
+            }
+
+            if (res.ec == std::errc())
+                out.append(large.data(), res.ptr);
+        }
+
+    } // namespace Format
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_FORMAT_H_
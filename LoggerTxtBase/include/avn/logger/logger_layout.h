@@ -0,0 +1,309 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_layout.h
+ * \brief ALoggerLayout class implements precompiled output layout patterns.
+ *
+ * Layout pattern is parsed once into the compact operations list. Each message is formatted by executing this list
+ * straight into the output buffer, without string streams and std::put_time calls. Supported specifiers are :
+ * - %Y, %m, %d, %H, %M, %S : year, month, day, hours, minutes and seconds ;
+ * - %F, %T : "%Y-%m-%d" and "%H:%M:%S" ;
+ * - %f, %e : microseconds and milliseconds ;
+ * - %L : preformatted level decoration, i.e. level description with the level prefix and postfix ;
+ * - %t : identifier of the thread that outputs the message ;
+ * - %v : message, it is preceded by the thread context prefix if any, see logger_context.h ;
+ * - %% : percent sign.
+ *
+ * Other specifiers are formatted by std::strftime or std::wcsftime, result is widened for char16_t and char32_t. Broken down time is calculated once per second.
+ *
+ * \code
+
+    logger.setLayout("%Y-%m-%d %H:%M:%S.%f %L %t %v");
+
+ * \endcode
+ */
+
+#ifndef _AVN_LOGGER_LAYOUT_H_
+#define _AVN_LOGGER_LAYOUT_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <cwchar>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ALogger {
+
+    /** Precompiled output layout
+     *
+     * \tparam _TChar Character type
+     */
+    template<typename _TChar>
+    class ALoggerLayout {
+    public:
+        /** String type */
+        using TString = std::basic_string<_TChar>;
+
+        /** Default layout that produces "2020-01-01 00:00:00 [LEVEL] message" output */
+        static const _TChar* defaultLayout() noexcept;
+
+        /** Constructor
+         *
+         * \param[in] local_time Use local time instead of GMT one
+         */
+        explicit ALoggerLayout(bool local_time = true) noexcept : _localTime(local_time)    { compile(defaultLayout()); }
+
+        /** Parse layout pattern
+         *
+         * \param[in] pattern Layout pattern
+         */
+        void compile(const TString& pattern) noexcept;
+
+        /** Format message
+         *
+         * \tparam _TOut Output buffer type. It has to provide append(const _TChar*, std::size_t) and push_back(_TChar)
+         * calls, so the message can be formatted into a string or directly into the destination memory
+         *
+         * \param[out] out Output buffer. Formatted message is appended to it
+         * \param[in] level Preformatted level decoration. It is copied as is
+         * \param[in] time Message timestamp
+         * \param[in] data Message
+         * \param[in] context Text to be inserted before the message. Empty by default
+         */
+        template<typename _TOut>
+        void format(_TOut& out, const TString& level, std::chrono::system_clock::time_point time, const TString& data,
+                    std::basic_string_view<_TChar> context = {}) const noexcept;
+
+        /** Broken down time
+         *
+         * Result is cached until the next second is requested.
+         *
+         * \param[in] second Seconds since epoch
+         *
+         * \return Local or GMT broken down time
+         */
+        const std::tm& brokenDown(std::time_t second) const noexcept;
+
+        /** Identifier of the current thread
+         *
+         * \return Kernel thread identifier if it is available, thread identifier hash otherwise
+         */
+        static unsigned long threadId() noexcept;
+
+    private:
+        enum class EOp : std::uint8_t {
+            TEXT, YEAR, MONTH, DAY, HOUR, MINUTE, SECOND, MICRO, MILLI, LEVEL, THREAD, MESSAGE, STRFTIME
+        };
+
+        struct SOp {
+            EOp _op;
+            std::uint32_t _offset;      // Text position in _literals, or specifier position in _specs for STRFTIME
+            std::uint32_t _size;        // Text size
+        };
+
+        // strftime specifiers are passed to std::strftime or std::wcsftime as is
+        using TSpecChar = std::conditional_t<std::is_same_v<_TChar, wchar_t>, wchar_t, char>;
+
+        bool _localTime;
+        std::vector<SOp> _ops;
+        TString _literals;
+        std::basic_string<TSpecChar> _specs;    // Null-terminated strftime specifiers
+
+        mutable std::time_t _cachedSecond{ -1 };
+        mutable std::tm _cachedTm{};
+
+        void addText(const _TChar* text, std::size_t size);
+        void addOp(EOp op)                                                  { _ops.push_back({ op, 0, 0 }); }
+        template<typename _TOut>
+        static void appendNumber(_TOut& out, unsigned long value, int digits) noexcept;
+    };
+
+    template<typename _TChar>
+    /* static */ const _TChar* ALoggerLayout<_TChar>::defaultLayout() noexcept
+    {
+        static const _TChar layout[]{ '%', 'F', ' ', '%', 'T', ' ', '%', 'L', ' ', '%', 'v', 0 };
+        return layout;
+    }
+
+    template<typename _TChar>
+    void ALoggerLayout<_TChar>::addText(const _TChar* text, std::size_t size)
+    {
+        if (!_ops.empty() && _ops.back()._op == EOp::TEXT && _ops.back()._offset + _ops.back()._size == _literals.size())
+            _ops.back()._size += static_cast<std::uint32_t>(size);
+        else
+            _ops.push_back({ EOp::TEXT, static_cast<std::uint32_t>(_literals.size()), static_cast<std::uint32_t>(size) });
+
+        _literals.append(text, size);
+    }
+
+    template<typename _TChar>
+    void ALoggerLayout<_TChar>::compile(const TString& pattern) noexcept
+    {
+        _ops.clear();
+        _literals.clear();
+        _specs.clear();
+
+        for (std::size_t pos = 0; pos < pattern.size(); ++pos) {
+            const auto ch{ pattern[pos] };
+
+            if (ch != '%' || pos + 1 == pattern.size()) {
+                addText(&pattern[pos], 1);
+                continue;
+            }
+
+            const auto spec{ pattern[++pos] };
+            const _TChar dash{'-'}, colon{':'};
+
+            switch (spec) {
+            case 'Y' : addOp(EOp::YEAR); break;
+            case 'm' : addOp(EOp::MONTH); break;
+            case 'd' : addOp(EOp::DAY); break;
+            case 'H' : addOp(EOp::HOUR); break;
+            case 'M' : addOp(EOp::MINUTE); break;
+            case 'S' : addOp(EOp::SECOND); break;
+            case 'F' : addOp(EOp::YEAR); addText(&dash, 1); addOp(EOp::MONTH); addText(&dash, 1); addOp(EOp::DAY); break;
+            case 'T' : addOp(EOp::HOUR); addText(&colon, 1); addOp(EOp::MINUTE); addText(&colon, 1); addOp(EOp::SECOND); break;
+            case 'f' : addOp(EOp::MICRO); break;
+            case 'e' : addOp(EOp::MILLI); break;
+            case 'L' : addOp(EOp::LEVEL); break;
+            case 't' : addOp(EOp::THREAD); break;
+            case 'v' : addOp(EOp::MESSAGE); break;
+            case '%' : addText(&pattern[pos], 1); break;
+            default :
+                // Specifier with optional E or O modifier is formatted by strftime
+                const auto begin{ pos - 1 };
+                if ((spec == 'E' || spec == 'O') && pos + 1 < pattern.size())
+                    ++pos;
+                _ops.push_back({ EOp::STRFTIME, static_cast<std::uint32_t>(_specs.size()), static_cast<std::uint32_t>(pos + 1 - begin) });
+                for (auto ind = begin; ind <= pos; ++ind)
+                    _specs.push_back(static_cast<TSpecChar>(pattern[ind]));
+                _specs.push_back(0);
+                break;
+            }
+        }
+    }
+
+    template<typename _TChar>
+    const std::tm& ALoggerLayout<_TChar>::brokenDown(std::time_t second) const noexcept
+    {
+        if (second != _cachedSecond) {
+#if __has_include(<unistd.h>)
+            if (_localTime)
+                ::localtime_r(&second, &_cachedTm);
+            else
+                ::gmtime_r(&second, &_cachedTm);
+#else
+            _cachedTm = _localTime ? *std::localtime(&second) : *std::gmtime(&second);
+#endif
+            _cachedSecond = second;
+        }
+
+        return _cachedTm;
+    }
+
+    template<typename _TChar>
+    template<typename _TOut>
+    /* static */ void ALoggerLayout<_TChar>::appendNumber(_TOut& out, unsigned long value, int digits) noexcept
+    {
+        _TChar buffer[24];
+        auto pos{ std::end(buffer) };
+
+        do {
+            *--pos = static_cast<_TChar>('0' + value % 10);
+            value /= 10;
+        } while (value != 0 || std::end(buffer) - pos < digits);
+
+        out.append(pos, static_cast<std::size_t>(std::end(buffer) - pos));
+    }
+
+    template<typename _TChar>
+    /* static */ unsigned long ALoggerLayout<_TChar>::threadId() noexcept
+    {
+        thread_local const unsigned long id{
+#if __has_include(<unistd.h>) && defined(SYS_gettid)
+            static_cast<unsigned long>(::syscall(SYS_gettid))
+#else
+            static_cast<unsigned long>(std::hash<std::thread::id>()(std::this_thread::get_id()))
+#endif
+        };
+
+        return id;
+    }
+
+    template<typename _TChar>
+    template<typename _TOut>
+    void ALoggerLayout<_TChar>::format(_TOut& out, const TString& level, std::chrono::system_clock::time_point time, const TString& data,
+                                       std::basic_string_view<_TChar> context) const noexcept
+    {
+        using namespace std::chrono;
+
+        const auto since_epoch{ duration_cast<microseconds>(time.time_since_epoch()) };
+        auto second{ duration_cast<seconds>(since_epoch) };
+        if (second > since_epoch)
+            second -= seconds(1);
+        const auto micro{ static_cast<unsigned long>((since_epoch - second).count()) };
+
+        const std::tm* tm{ nullptr };
+        const auto broken_down = [&]() -> const std::tm& {
+            if (tm == nullptr)
+                tm = &brokenDown(static_cast<std::time_t>(second.count()));
+            return *tm;
+        };
+
+        for (const auto& op : _ops) {
+            switch (op._op) {
+            case EOp::TEXT :        out.append(_literals.data() + op._offset, op._size); break;
+            case EOp::YEAR :        appendNumber(out, static_cast<unsigned long>(broken_down().tm_year + 1900), 4); break;
+            case EOp::MONTH :       appendNumber(out, static_cast<unsigned long>(broken_down().tm_mon + 1), 2); break;
+            case EOp::DAY :         appendNumber(out, static_cast<unsigned long>(broken_down().tm_mday), 2); break;
+            case EOp::HOUR :        appendNumber(out, static_cast<unsigned long>(broken_down().tm_hour), 2); break;
+            case EOp::MINUTE :      appendNumber(out, static_cast<unsigned long>(broken_down().tm_min), 2); break;
+            case EOp::SECOND :      appendNumber(out, static_cast<unsigned long>(broken_down().tm_sec), 2); break;
+            case EOp::MICRO :       appendNumber(out, micro, 6); break;
+            case EOp::MILLI :       appendNumber(out, micro / 1000, 3); break;
+            case EOp::LEVEL :       out.append(level.data(), level.size()); break;
+            case EOp::THREAD :      appendNumber(out, threadId(), 1); break;
+            case EOp::MESSAGE :     out.append(context.data(), context.size()); out.append(data.data(), data.size()); break;
+            case EOp::STRFTIME : {
+                const auto* spec{ _specs.c_str() + op._offset };
+
+                if constexpr (std::is_same_v<_TChar, char> || std::is_same_v<_TChar, wchar_t>) {
+                    _TChar buffer[128];
+                    std::size_t size;
+
+                    if constexpr (std::is_same_v<_TChar, char>)
+                        size = std::strftime(buffer, sizeof(buffer) / sizeof(buffer[0]), spec, &broken_down());
+                    else
+                        size = std::wcsftime(buffer, sizeof(buffer) / sizeof(buffer[0]), spec, &broken_down());
+
+                    out.append(buffer, size);
+                } else {
+                    // Specifiers are ASCII, result is in the C locale
+                    char buffer[128];
+                    const auto size{ std::strftime(buffer, sizeof(buffer), spec, &broken_down()) };
+                    _TChar wide[128];
+
+                    std::copy(buffer, buffer + size, wide);
+                    out.append(wide, size);
+                }
+                break;
+            }
+            }
+        }
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_LAYOUT_H_
@@ -6,25 +6,56 @@
  *
  * #ALogger::ALoggerTxtBase class is the #ALogger::ALoggerBase child that implements text messages logging. It introduces logger level
  * description map that will be used for logger message prefix. You have to specify multithreading security mode (see
- * #ALogger::ALoggerBase class description) and character type. It could be char, wchar_t etc.
+ * #ALogger::ALoggerBase class description) and character type. It could be char, wchar_t, char16_t or char32_t.
  *
- * You can tune output format by specifying logger message maker by #ALogger::ALoggerBase::setStringMaker call. This function
- * sets #ALogger::ALoggerBase::TStringMaker message maker function. By default #ALogger::defaultStringMakerChar,
- * #ALogger::defaultStringMakerWChar etc. implementations are used.
+ * char16_t and char32_t loggers hold UTF-16 and UTF-32 messages. There are no standard string streams for these types,
+ * so message arguments are appended to the message buffer by #ALogger::toStrBuffer calls : string views of the logger
+ * character type are copied as is, numbers are formatted by std::to_chars, narrow strings are decoded from UTF-8. Byte
+ * sinks transcode such messages to UTF-8 once, while writing them to the output buffer.
  *
- * \warning If you implement not supported character type, no text decoration will be used. Set string maker in your child
- * class by #ALogger::ALoggerBase::setStringMaker call.
+ * Output format is defined by the precompiled layout, see #ALogger::ALoggerLayout class description. By default
+ * "2020-01-01 00:00:00 [LEVEL] message" output is produced. Layout is built from the timestamp format, level prefix and
+ * postfix and space text that are set by #setDateOutputFormat, #setLevelPrefix, #setLevelPostfix and #setSpace calls.
+ * Also the whole layout pattern can be set by #setLayout call.
+ *
+ * Level decorations, i.e. level descriptions with the prefix and postfix, are preformatted into the dense table
+ * indexed by level identifier, so each message copies its decoration without any lookup. Levels without description
+ * are decorated by the level number, e.g. "[7]".
+ *
+ * Records can carry typed key-value fields added by #ALogger::ALoggerTxtBase::addFields call, see logger_fields.h.
+ * Fields are rendered only when the record is output. Text output appends them to the formatted message as
+ * " key=value" pairs, structured loggers can iterate them by #ALogger::ALoggerTxtBase::recordFields call.
+ *
+ * Thread context fields pushed by #ALogger::ALoggerTxtBase::addContext call are attached to all records of the
+ * current thread, see logger_context.h. Text output inserts their cached prefix before the message, structured
+ * loggers get them by #ALogger::ALoggerTxtBase::recordContext call.
+ *
+ * Children classes still can override output format by #ALogger::ALoggerTxtBase::setStringMaker call. In this case
+ * #ALogger::ALoggerTxtBase::TStringMaker function is called for each message instead of the layout.
  *
  */
 
 #ifndef _AVN_LOGGER_TXT_BASE_H_
 #define _AVN_LOGGER_TXT_BASE_H_
 
+#include <charconv>
+#include <functional>
 #include <iomanip>
 #include <sstream>
+#include <iterator>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <avn/logger/logger_base.h>
+#include <avn/logger/logger_context.h>
+#include <avn/logger/logger_fields.h>
+#include <avn/logger/logger_format.h>
+#include <avn/logger/logger_layout.h>
+#include <avn/logger/logger_txt_record.h>
+#include <avn/logger/logger_utf8.h>
 
 namespace ALogger {
 
@@ -40,6 +71,49 @@ namespace ALogger {
     template<typename _TChar, typename T>
     inline void toStrStream(std::basic_stringstream<_TChar>& stream, T&& arg) noexcept { stream << std::forward<T>(arg); }
 
+    /** Unspecialized template to append argument to UTF-16 or UTF-32 message buffer
+     *
+     * It is used by char16_t and char32_t loggers instead of #ALogger::toStrStream.
+     *
+     * \note You can overload this function for your type
+     *
+     * \tparam _TChar Message character type
+     * \tparam T Argument type
+     * \param[out] out Message buffer
+     * \param[in] arg Argument
+     */
+    template<typename _TChar, typename T>
+    inline void toStrBuffer(std::basic_string<_TChar>& out, T&& arg) noexcept
+    {
+        using TArg = std::decay_t<T>;
+
+        if constexpr (std::is_convertible_v<const T&, std::basic_string_view<_TChar>>)
+            out.append(std::basic_string_view<_TChar>(arg));
+        else if constexpr (std::is_same_v<TArg, _TChar> || std::is_same_v<TArg, char>)
+            out.push_back(static_cast<_TChar>(arg));
+        else if constexpr (std::is_same_v<TArg, bool>)
+            out.push_back(static_cast<_TChar>(arg ? '1' : '0'));
+        else if constexpr (std::is_arithmetic_v<TArg>) {
+            char buffer[64];
+            std::to_chars_result res;
+
+            // Floating point numbers precision is the same as the default stream one
+            if constexpr (std::is_floating_point_v<TArg>)
+                res = std::to_chars(buffer, buffer + sizeof(buffer), arg, std::chars_format::general, 6);
+            else
+                res = std::to_chars(buffer, buffer + sizeof(buffer), arg);
+
+            out.append(buffer, res.ptr);
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            Utf8::decode(out, std::string_view(arg));
+        else {
+            std::stringstream stream;
+            stream << std::forward<T>(arg);
+            Utf8::decode(out, stream.str());
+        }
+    }
+
 // Qt Objects
 #ifdef QT_VERSION
     /** QString argument for char based text logger
@@ -55,6 +129,22 @@ namespace ALogger {
      * \param[in] arg QString argument
      */
     inline void toStrStream(std::basic_stringstream<wchar_t>& stream, const QString& arg) { stream << arg.toStdWString(); }
+
+    /** QString argument for char16_t based text logger
+     *
+     * QString UTF-16 data is copied without intermediate string.
+     *
+     * \param[out] out Message buffer
+     * \param[in] arg QString argument
+     */
+    inline void toStrBuffer(std::u16string& out, const QString& arg) { out.append(reinterpret_cast<const char16_t*>(arg.utf16()), static_cast<std::size_t>(arg.size())); }
+
+    /** QString argument for char32_t based text logger
+     *
+     * \param[out] out Message buffer
+     * \param[in] arg QString argument
+     */
+    inline void toStrBuffer(std::u32string& out, const QString& arg) { const auto ucs4{ arg.toUcs4() }; out.append(reinterpret_cast<const char32_t*>(ucs4.data()), static_cast<std::size_t>(ucs4.size())); }
 #endif // QT_VERSION
 
     /** Base class for text loggers
@@ -63,7 +153,7 @@ namespace ALogger {
      * \tparam _TChar Character data type. Can be char, wchar_t etc.
      */
     template<bool _ThrSafe, typename _TChar>
-    class ALoggerTxtBase : public ALoggerBase<_ThrSafe, std::basic_string<_TChar>> {
+    class ALoggerTxtBase : public ALoggerBase<_ThrSafe, ALoggerTxtRecord<_TChar>> {
     public :
         /** Current thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated */
         constexpr static bool ThrSafe{ _ThrSafe };
@@ -71,16 +161,23 @@ namespace ALogger {
         /** Character type for text logger messages */
         using TChar = _TChar;
 
-        static_assert(std::is_same_v<TChar,char> || std::is_same_v<TChar,wchar_t>, "Only char and wchar_t are currently supported");
+        static_assert(std::is_same_v<TChar,char> || std::is_same_v<TChar,wchar_t> || std::is_same_v<TChar,char16_t> || std::is_same_v<TChar,char32_t>,
+                      "Only char, wchar_t, char16_t and char32_t are currently supported");
 
         /** String type for text logger messages */
         using TString = std::basic_string<TChar>;
 
+        /** Record type. It is message with optional fields */
+        using TRecord = ALoggerTxtRecord<TChar>;
+
         /** Levels mapping type */
         using TlevelsMap = std::map<size_t, TString>;
 
+        /** Levels amount in the preformatted decorations table. Decorations of greater levels are kept in the hash table */
+        constexpr static std::size_t DenseLevels{ 256 };
+
     private :
-        using TBase = ALoggerBase<_ThrSafe, TString>;
+        using TBase = ALoggerBase<_ThrSafe, TRecord>;
 
     public :
         /** Default constructor
@@ -96,11 +193,57 @@ namespace ALogger {
          *
          * \return Current instance reference
          */
-        ALoggerTxtBase& addLevelDescr(size_t level, const TString& name) noexcept     { _levelsMap[level] = name; return *this; }
+        ALoggerTxtBase& addLevelDescr(size_t level, const TString& name) noexcept     { _levelsMap[level] = name; rebuildLevel(level); return *this; }
 
         /** Return levels map */
         const TlevelsMap& levelsMap() const noexcept                           { return _levelsMap; }
 
+        /** Set output layout pattern
+         *
+         * See #ALogger::ALoggerLayout class description for supported specifiers.
+         *
+         * \param[in] pattern Layout pattern
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtBase& setLayout(const TString& pattern) noexcept              { _layout.compile(pattern); return *this; }
+
+        /** Set timestamp format
+         *
+         * Default layout is rebuilt with the new timestamp format. Default format is "%F %T".
+         *
+         * \param[in] output_format Timestamp format, see #ALogger::ALoggerLayout class description
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtBase& setDateOutputFormat(const TString& output_format) noexcept  { _dateFormat = output_format; rebuildLayout(); return *this; }
+
+        /** Set text before level descriptor. Default one is "["
+         *
+         * \param[in] level_prefix Level prefix
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtBase& setLevelPrefix(const TString& level_prefix) noexcept    { _levelPrefix = level_prefix; rebuildLevelTable(); return *this; }
+
+        /** Set text after level descriptor. Default one is "]"
+         *
+         * \param[in] level_postfix Level postfix
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtBase& setLevelPostfix(const TString& level_postfix) noexcept  { _levelPostfix = level_postfix; rebuildLevelTable(); return *this; }
+
+        /** Set space text between timestamp, level and message
+         *
+         * Default layout is rebuilt with the new space text. Default one is " ".
+         *
+         * \param[in] space Space text
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtBase& setSpace(const TString& space) noexcept                 { _space = space; rebuildLayout(); return *this; }
+
         /** Output the text message arguments
         *
         * If a task is active, message will be logged. If no task is active, message will be output
@@ -121,6 +264,25 @@ namespace ALogger {
         template<typename... T>
         ALoggerTxtBase& addString(std::size_t level, T&&... args) noexcept;
 
+        /** Output the text message arguments with specified timestamp
+        *
+        * If a task is active, message will be logged. If no task is active, message will be output
+        * only if logger level is enabled.
+        *
+        * \tparam T Message elements types.
+        * \warning Each type must be able to to be used as argument for
+        * std::basic_stringstream<TChar>::operator<<(std::forward<T>(args)) call. If not, specialize #ALogger::toStrStream
+        * function
+        *
+        * \param[in] time Message timestamp
+        * \param[in] level Level identifier
+        * \param[in] args Arguments
+        *
+        * \return Current instance reference
+        */
+        template<typename... T>
+        ALoggerTxtBase& addString(std::chrono::system_clock::time_point time, std::size_t level, T&&... args) noexcept;
+
         /** Output the text message arguments
         *
         * If a task is active, message will be logged. If no task is active, message will be output
@@ -141,6 +303,62 @@ namespace ALogger {
         template<typename... T>
         ALoggerTxtBase& operator() (std::size_t level, T&&... args) noexcept    { return addString(level, std::forward<T...>(args...)); }
 
+        /** Output the message made by the compile-time checked format string
+        *
+        * If a task is active, message will be logged. If no task is active, message will be output
+        * only if logger level is enabled.
+        *
+        * Format string is parsed at compile time, see logger_format.h. Placeholders amount and types are checked
+        * against arguments by static_assert.
+        *
+        * Message will be output with the current timestamp.
+        *
+        * \tparam TFormat Format string type made by #AVN_FMT macro
+        * \tparam T Arguments types
+        *
+        * \param[in] level Level identifier
+        * \param[in] format Format string made by #AVN_FMT macro
+        * \param[in] args Arguments
+        *
+        * \return Current instance reference
+        */
+        template<typename TFormat, typename... T>
+        ALoggerTxtBase& addFormat(std::size_t level, TFormat format, const T&... args) noexcept;
+
+        /** Output the message with typed fields
+        *
+        * If a task is active, message will be logged. If no task is active, message will be output
+        * only if logger level is enabled. Fields are stored in the binary form and are converted to text only
+        * when the record is output.
+        *
+        * Message will be output with the current timestamp.
+        *
+        * \tparam TMessage Message type. It has to be convertible to #TString
+        * \tparam TFields Fields values types
+        *
+        * \param[in] level Level identifier
+        * \param[in] message Message
+        * \param[in] fields Fields made by #ALogger::field calls
+        *
+        * \return Current instance reference
+        */
+        template<typename TMessage, typename... TFields>
+        ALoggerTxtBase& addFields(std::size_t level, TMessage&& message, const SField<TFields>&... fields) noexcept;
+
+        /** Push thread context fields
+        *
+        * Fields are attached to all records added by the current thread until the returned object is destroyed.
+        * Context is shared by all loggers, see logger_context.h.
+        *
+        * \tparam TFields Fields values types
+        *
+        * \param[in] fields Fields made by #ALogger::field calls
+        *
+        * \return Context frame object
+        */
+        template<typename... TFields>
+        static ALoggerContext addContext(const SField<TFields>&... fields) noexcept      { return ALoggerContext(fields...); }
+
         /** Set the associated locale of the stream to the given one
          *
          * \param[in] loc New locale to associate the stream to
@@ -148,6 +366,42 @@ namespace ALogger {
         virtual void imbue(const std::locale& loc) noexcept { }
 
     protected:
+        /** Output message
+         *
+         * This function is called for each output record. Fields and context of the record are available by
+         * #recordFields and #recordContext calls during this call.
+         *
+         * \param[in] level Level identifier
+         * \param[in] time Message timestamp
+         * \param[in] data Message string
+         *
+         * \return true if data was output successfully or false otherwise.
+         */
+        virtual bool outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept = 0;
+
+        /** Fields block of the record that is being output
+         *
+         * \return Fields block to be iterated by #ALogger::Fields::forEach call. It is empty out of #outData call
+         */
+        std::string_view recordFields() const noexcept                          { return _recordFields; }
+
+        /** Thread context of the record that is being output
+         *
+         * \return Context snapshot or null pointer if the record has no context. It is null out of #outData call
+         */
+        const SLogContext* recordContext() const noexcept                       { return _recordContext; }
+
+        /** Level decoration
+         *
+         * Decorations of levels below #DenseLevels and of described levels are preformatted. Decorations of other levels
+         * are made at the first use and cached, so this function is called under the output lock like #prepareString.
+         *
+         * \param[in] level Level identifier
+         *
+         * \return Level description or level number with the level prefix and postfix
+         */
+        const TString& levelDecoration(size_t level) const noexcept;
+
         /** Decorate string
          *
          * This function decorates string by using prefix, postfix, timestamp format and space string. It is intentent
@@ -161,6 +415,22 @@ namespace ALogger {
          */
         TString prepareString(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) const noexcept;
 
+        /** Decorate string into the output buffer
+         *
+         * This function appends decorated string to \a out buffer, so children classes can reuse the buffer. Context
+         * prefix of the record that is being output is inserted before the message, its fields are appended as
+         * " key=value" pairs.
+         *
+         * \tparam _TOut Output buffer type, see #ALogger::ALoggerLayout::format. It is TString usually
+         *
+         * \param[out] out Output buffer
+         * \param[in] level Level identifier
+         * \param[in] time Message timestamp
+         * \param[in] data Message string
+         */
+        template<typename _TOut>
+        void prepareString(_TOut& out, std::size_t level, std::chrono::system_clock::time_point time, const TString& data) const noexcept;
+
         /** Function type to make string
          *
          * This function type is used to make string by using level title, timestamp and data. It is used as
@@ -176,26 +446,128 @@ namespace ALogger {
 
         /** Set child implementation for string maker
          *
-         * Default string maker is initialized during class initialization. You can replace it in your child class.
+         * By default string maker is not set and output layout is used. You can set it in your child class.
          *
          * \param[in] stringMaker String maker implementation
          * \return Current instance reference
          */
         ALoggerTxtBase& setStringMaker(TStringMaker stringMaker) { _stringMaker = stringMaker; return *this; }
 
+        /** Default string maker
+         *
+         * \return Default string maker for the current character type. It produces the same output as default layout
+         */
+        static TStringMaker selectDefaultStringMaker() noexcept;
+
+        /** Level description
+         *
+         * \param[in] level Level identifier
+         *
+         * \return Level description or level number if description is not set
+         */
+        TString levelName(size_t level) const noexcept;
+
     private:
+        template<typename TFormat, typename TArgs, std::size_t... I>
+        static void formatOps(TString& out, const TArgs& args, std::index_sequence<I...>) noexcept;
+        template<typename T>
+        static void formatArg(TString& out, const Format::SOp& op, const T& arg) noexcept;
+
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const TRecord& record) noexcept override;
+        template<typename _TOut>
+        void appendFields(_TOut& out) const noexcept;
+        std::basic_string_view<_TChar> contextPrefix() const noexcept;
+
         TlevelsMap _levelsMap;
-        std::function<std::tm* (const std::time_t*)> _timeConverter;
+        std::vector<TString> _levelTable;       // Preformatted decorations of levels below DenseLevels
+        mutable std::unordered_map<size_t, TString> _sparseTable;  // Decorations of greater levels
+        ALoggerLayout<_TChar> _layout;
+        TString _dateFormat;
+        TString _levelPrefix;
+        TString _levelPostfix;
+        TString _space;
         TStringMaker _stringMaker;
-
-        TStringMaker selectDefaultStringMaker() noexcept;
+        std::string_view _recordFields;
+        const SLogContext* _recordContext{ nullptr };
+        mutable std::string _fieldsText;    // Reusable buffer for fields of wide records and not string outputs
+
+        void rebuildLayout() noexcept;
+        void rebuildLevelTable() noexcept;
+        void rebuildLevel(size_t level) noexcept;
+        TString decorate(size_t level) const noexcept                           { return _levelPrefix + levelName(level) + _levelPostfix; }
     };
 
     template<bool _ThrSafe, typename _TChar>
     ALoggerTxtBase<_ThrSafe, _TChar>::ALoggerTxtBase(bool local_time) noexcept:
-            _timeConverter{local_time ? std::localtime : std::gmtime},
-            _stringMaker(selectDefaultStringMaker())
-    { }
+            _layout(local_time),
+            _levelPrefix(1, _TChar('[')),
+            _levelPostfix(1, _TChar(']')),
+            _space(1, _TChar(' '))
+    {
+        const _TChar date_format[]{ '%', 'F', ' ', '%', 'T', 0 };
+        _dateFormat = date_format;
+        rebuildLevelTable();
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtBase<_ThrSafe, _TChar>::rebuildLayout() noexcept
+    {
+        const _TChar level[]{ '%', 'L', 0 };
+        const _TChar message[]{ '%', 'v', 0 };
+
+        _layout.compile(_dateFormat + _space + level + _space + message);
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtBase<_ThrSafe, _TChar>::rebuildLevelTable() noexcept
+    {
+        // Levels without description are decorated by their numbers
+        _levelTable.resize(DenseLevels);
+        for (std::size_t level = 0; level < DenseLevels; ++level)
+            _levelTable[level] = decorate(level);
+
+        _sparseTable.clear();
+        for (auto level_it = _levelsMap.lower_bound(DenseLevels); level_it != _levelsMap.cend(); ++level_it)
+            _sparseTable.emplace(level_it->first, decorate(level_it->first));
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtBase<_ThrSafe, _TChar>::rebuildLevel(size_t level) noexcept
+    {
+        if (level < DenseLevels)
+            _levelTable[level] = decorate(level);
+        else
+            _sparseTable.insert_or_assign(level, decorate(level));
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    const typename ALoggerTxtBase<_ThrSafe, _TChar>::TString& ALoggerTxtBase<_ThrSafe, _TChar>::levelDecoration(size_t level) const noexcept
+    {
+        if (level < DenseLevels)
+            return _levelTable[level];
+
+        auto level_it{ _sparseTable.find(level) };
+        if (level_it == _sparseTable.end())
+            level_it = _sparseTable.emplace(level, decorate(level)).first;
+
+        return level_it->second;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    typename ALoggerTxtBase<_ThrSafe, _TChar>::TString ALoggerTxtBase<_ThrSafe, _TChar>::levelName(size_t level) const noexcept
+    {
+        const auto level_it{ _levelsMap.find(level) };
+
+        if (level_it != _levelsMap.cend())
+            return level_it->second;
+
+        const auto number{ std::to_string(level) };
+
+        if constexpr (std::is_same_v<_TChar, char>)
+            return number;
+        else
+            return TString(number.cbegin(), number.cend());
+    }
 
     inline std::string defaultStringMakerChar(const std::string& level, const std::tm* time, const std::string& data) noexcept
     {
@@ -214,7 +586,7 @@ namespace ALogger {
     }
 
     template<bool _ThrSafe, typename _TChar>
-    typename ALoggerTxtBase<_ThrSafe, _TChar>::TStringMaker ALoggerTxtBase<_ThrSafe, _TChar>::selectDefaultStringMaker() noexcept
+    /* static */ typename ALoggerTxtBase<_ThrSafe, _TChar>::TStringMaker ALoggerTxtBase<_ThrSafe, _TChar>::selectDefaultStringMaker() noexcept
     {
         if constexpr (std::is_same_v<_TChar, char>)
             return defaultStringMakerChar;
@@ -229,25 +601,192 @@ namespace ALogger {
     template<bool _ThrSafe, typename _TChar>
     template<typename... T>
     ALoggerTxtBase<_ThrSafe, _TChar>& ALoggerTxtBase<_ThrSafe, _TChar>::addString(std::size_t level, T&&... args) noexcept
+    {
+        return addString(std::chrono::system_clock::now(), level, std::forward<T>(args)...);
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    template<typename... T>
+    ALoggerTxtBase<_ThrSafe, _TChar>& ALoggerTxtBase<_ThrSafe, _TChar>::addString(std::chrono::system_clock::time_point time, std::size_t level, T&&... args) noexcept
+    {
+        if (!TBase::taskOrToBeAdded(level))
+            return *this;
+        if constexpr (std::is_same_v<_TChar, char> || std::is_same_v<_TChar, wchar_t>) {
+            std::basic_stringstream<_TChar> stream;
+            (toStrStream(stream, std::forward<T>(args)), ...);
+            TBase::addToLog(level, stream.str(), time);
+        } else {
+            TString message;
+            (toStrBuffer(message, std::forward<T>(args)), ...);
+            TBase::addToLog(level, std::move(message), time);
+        }
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    template<typename TFormat, typename... T>
+    ALoggerTxtBase<_ThrSafe, _TChar>& ALoggerTxtBase<_ThrSafe, _TChar>::addFormat(std::size_t level, TFormat /* format */, const T&... args) noexcept
+    {
+        using TCompiled = Format::SCompiled<TFormat>;
+
+        static_assert(std::is_same_v<typename TCompiled::TChar, _TChar>, "Format string character type differs from the logger one");
+        static_assert(TCompiled::Parsed._args == sizeof...(T), "Format string placeholders amount differs from arguments amount");
+        static_assert(Format::check<TFormat, T...>(), "Format string presentation type does not fit argument type");
+
+        std::chrono::system_clock::time_point time = std::chrono::system_clock::now();
+        if (!TBase::taskOrToBeAdded(level))
+            return *this;
+
+        // Message is built in the reusable thread buffer, so only the record copy allocates. Buffer is taken out while
+        // it is used, so an argument output that logs again gets an empty one
+        thread_local TString buffer;
+        TString message{ std::move(buffer) };
+        message.clear();
+        formatOps<TFormat>(message, std::forward_as_tuple(args...), std::make_index_sequence<TCompiled::Ops.size()>());
+        TBase::addToLog(level, message, time);
+        buffer = std::move(message);
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    template<typename TFormat, typename TArgs, std::size_t... I>
+    /* static */ void ALoggerTxtBase<_ThrSafe, _TChar>::formatOps(TString& out, const TArgs& args, std::index_sequence<I...>) noexcept
+    {
+        using TCompiled = Format::SCompiled<TFormat>;
+
+        // Operations are unrolled, each one is a compile-time constant
+        const auto execute = [&](auto index) {
+            constexpr auto op{ TCompiled::Ops[decltype(index)::value] };
+            if constexpr (op._arg)
+                formatArg(out, op, std::get<op._index>(args));
+            else
+                out.append(TCompiled::Text.data() + op._offset, op._size);
+        };
+
+        (execute(std::integral_constant<std::size_t, I>()), ...);
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    template<typename T>
+    /* static */ void ALoggerTxtBase<_ThrSafe, _TChar>::formatArg(TString& out, const Format::SOp& op, const T& arg) noexcept
+    {
+        using Format::EKind;
+
+        constexpr auto kind{ Format::kind<_TChar, T>() };
+        const auto start{ out.size() };
+        bool number{false};
+
+        if constexpr (kind == EKind::BOOL) {
+            static const _TChar text[]{ 't', 'r', 'u', 'e', 'f', 'a', 'l', 's', 'e' };
+            out.append(arg ? text : text + 4, arg ? 4 : 5);
+        } else if constexpr (kind == EKind::CHAR || kind == EKind::INT) {
+            if (op._type == 'c' || (kind == EKind::CHAR && op._type == 0)) {
+                out.push_back(static_cast<_TChar>(arg));
+            } else if constexpr (kind == EKind::CHAR) {
+                // std::to_chars does not take character types, code unit is output as unsigned integer
+                Format::appendInt(out, static_cast<std::make_unsigned_t<std::decay_t<T>>>(arg), op._type);
+                number = true;
+            } else {
+                Format::appendInt(out, arg, op._type);
+                number = true;
+            }
+        } else if constexpr (kind == EKind::FLOAT) {
+            Format::appendFloat(out, arg, op);
+            number = true;
+        } else if constexpr (kind == EKind::STRING) {
+            if constexpr (std::is_convertible_v<const T&, std::basic_string_view<_TChar>>)
+                out.append(std::basic_string_view<_TChar>(arg));
+            else
+                Utf8::decode(out, std::string_view(arg));
+
+            if (op._precision >= 0 && out.size() - start > static_cast<std::size_t>(op._precision))
+                out.resize(start + static_cast<std::size_t>(op._precision));
+        } else if constexpr (std::is_same_v<_TChar, char> || std::is_same_v<_TChar, wchar_t>) {
+            std::basic_stringstream<_TChar> stream;
+            toStrStream(stream, arg);
+            out.append(stream.str());
+        } else {
+            toStrBuffer(out, arg);
+        }
+
+        Format::pad(out, start, op, number);
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    template<typename TMessage, typename... TFields>
+    ALoggerTxtBase<_ThrSafe, _TChar>& ALoggerTxtBase<_ThrSafe, _TChar>::addFields(std::size_t level, TMessage&& message, const SField<TFields>&... fields) noexcept
     {
         std::chrono::system_clock::time_point time = std::chrono::system_clock::now();
         if (!TBase::taskOrToBeAdded(level))
             return *this;
-        std::basic_stringstream<_TChar> stream;
-        (toStrStream(stream, std::forward<T>(args)), ...);
-        TBase::addToLog(level, stream.str(), time);
+        TRecord record(std::forward<TMessage>(message));
+        (Fields::encode(record._fields, fields), ...);
+        TBase::addToLog(level, std::move(record), time);
         return *this;
     }
 
+    template<bool _ThrSafe, typename _TChar>
+    bool ALoggerTxtBase<_ThrSafe, _TChar>::outData(std::size_t level, std::chrono::system_clock::time_point time, const TRecord& record) noexcept
+    {
+        _recordFields = record._fields;
+        _recordContext = record._context.get();
+        const auto res{ outData(level, time, record._message) };
+        _recordFields = {};
+        _recordContext = nullptr;
+        return res;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    template<typename _TOut>
+    void ALoggerTxtBase<_ThrSafe, _TChar>::appendFields(_TOut& out) const noexcept
+    {
+        // Fields are rendered as UTF-8, wide records decode them
+        if constexpr (std::is_same_v<_TOut, std::string>) {
+            Fields::appendPairs(out, _recordFields);
+        } else {
+            _fieldsText.clear();
+            Fields::appendPairs(_fieldsText, _recordFields);
+
+            if constexpr (std::is_same_v<_TChar, char>)
+                out.append(_fieldsText.data(), _fieldsText.size());
+            else
+                Utf8::decode(out, _fieldsText);
+        }
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    std::basic_string_view<_TChar> ALoggerTxtBase<_ThrSafe, _TChar>::contextPrefix() const noexcept
+    {
+        if (_recordContext == nullptr)
+            return {};
+
+        return _recordContext->text<_TChar>();
+    }
+
     template<bool _ThrSafe, typename _TChar>
     typename ALoggerTxtBase<_ThrSafe, _TChar>::TString ALoggerTxtBase<_ThrSafe, _TChar>::prepareString(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) const noexcept
     {
-        const auto level_it{ _levelsMap.find(level) };
-        assert(level_it != _levelsMap.cend());
+        TString out;
+        prepareString(out, level, time, data);
+        return out;
+    }
 
-        std::time_t time_moment{ std::chrono::system_clock::to_time_t(time) };
+    template<bool _ThrSafe, typename _TChar>
+    template<typename _TOut>
+    void ALoggerTxtBase<_ThrSafe, _TChar>::prepareString(_TOut& out, std::size_t level, std::chrono::system_clock::time_point time, const TString& data) const noexcept
+    {
+        const auto context{ contextPrefix() };
+
+        if (_stringMaker) {
+            const auto& tm{ _layout.brokenDown(std::chrono::system_clock::to_time_t(time)) };
+            const auto str{ _stringMaker(levelName(level), &tm, context.empty() ? data : TString(context).append(data)) };
+            out.append(str.data(), str.size());
+        } else {
+            _layout.format(out, levelDecoration(level), time, data, context);
+        }
 
-        return _stringMaker(level_it->second, _timeConverter(&time_moment), data);
+        if (!_recordFields.empty())
+            appendFields(out);
     }
 
 } // namespace ALogger
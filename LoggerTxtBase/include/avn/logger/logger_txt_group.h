@@ -111,11 +111,47 @@ namespace ALogger {
         template<typename... T>
         void addString(std::chrono::system_clock::time_point time, std::size_t level, const T&... args) noexcept;
 
+        /** Output the message made by the compile-time checked format string for all container elements simultaneously
+        *
+        * This function calls #ALogger::ALoggerTxtBase::addFormat for each container element.
+        *
+        * \tparam TFormat Format string type made by #AVN_FMT macro
+        * \tparam T Arguments types
+        *
+        * \param[in] level Level identifier
+        * \param[in] format Format string made by #AVN_FMT macro
+        * \param[in] args Arguments
+        */
+        template<typename TFormat, typename... T>
+        void addFormat(std::size_t level, TFormat format, const T&... args) noexcept;
+
+        /** Output the message with typed fields for all container elements simultaneously
+        *
+        * This function calls #ALogger::ALoggerTxtBase::addFields for each container element.
+        *
+        * \tparam TMessage Message type
+        * \tparam TFields Fields values types
+        *
+        * \param[in] level Level identifier
+        * \param[in] message Message
+        * \param[in] fields Fields made by #ALogger::field calls
+        */
+        template<typename TMessage, typename... TFields>
+        void addFields(std::size_t level, const TMessage& message, const SField<TFields>&... fields) noexcept;
+
+        /** Set output layout pattern
+         *
+         * This function calls #ALogger::ALoggerTxtBase::setLayout for each container element.
+         *
+         * \param[in] pattern Layout pattern, see #ALogger::ALoggerLayout class description
+         */
+        void setLayout(const TString& pattern) noexcept;
+
         /** Set timestamp to string format
          *
          * This function calls #ALogger::ALoggerTxtBase::setDateOutputFormat for each container element.
          *
-         * \param[in] output_format std::put_time timestamp format
+         * \param[in] output_format Timestamp format, see #ALogger::ALoggerLayout class description
          */
         void setDateOutputFormat(const TString& output_format) noexcept;
 
@@ -202,14 +238,48 @@ namespace ALogger {
     template<typename... T>
     void ALoggerTxtGroup<_TLogger...>::addString(std::size_t level, const T&... args) noexcept
     {
-        std::apply([level,args...] (auto&... logger) { (logger.addString(level, args...), ...); }, TBase::_logger);
+        if (!TBase::mayOutput(level))
+            return;
+
+        // All loggers get the same timestamp
+        const auto time{ std::chrono::system_clock::now() };
+        std::apply([&] (auto&... logger) { (logger.addString(time, level, args...), ...); }, TBase::_logger);
     }
 
     template< typename... _TLogger >
     template<typename... T>
     void ALoggerTxtGroup<_TLogger...>::addString(std::chrono::system_clock::time_point time, std::size_t level, const T&... args) noexcept
     {
-        std::apply([time,level,args...] (auto&... logger) { (logger.addString(time, level, args...), ...); }, TBase::_logger);
+        if (!TBase::mayOutput(level))
+            return;
+
+        std::apply([&] (auto&... logger) { (logger.addString(time, level, args...), ...); }, TBase::_logger);
+    }
+
+    template< typename... _TLogger >
+    template<typename TFormat, typename... T>
+    void ALoggerTxtGroup<_TLogger...>::addFormat(std::size_t level, TFormat format, const T&... args) noexcept
+    {
+        if (!TBase::mayOutput(level))
+            return;
+
+        std::apply([&] (auto&... logger) { (logger.addFormat(level, format, args...), ...); }, TBase::_logger);
+    }
+
+    template< typename... _TLogger >
+    template<typename TMessage, typename... TFields>
+    void ALoggerTxtGroup<_TLogger...>::addFields(std::size_t level, const TMessage& message, const SField<TFields>&... fields) noexcept
+    {
+        if (!TBase::mayOutput(level))
+            return;
+
+        std::apply([&] (auto&... logger) { (logger.addFields(level, message, fields...), ...); }, TBase::_logger);
+    }
+
+    template< typename... _TLogger >
+    void ALoggerTxtGroup<_TLogger...>::setLayout(const TString& pattern) noexcept
+    {
+        std::apply([&pattern] (auto&... logger) { (logger.setLayout(pattern), ...); }, TBase::_logger);
     }
 
     template< typename... _TLogger >
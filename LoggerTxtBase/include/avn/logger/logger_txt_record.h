@@ -0,0 +1,154 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_txt_record.h
+ * \brief ALoggerTxtRecord class is the record type of text loggers.
+ *
+ * Record is the message, the binary block of typed fields, see logger_fields.h, and the thread context snapshot that
+ * was active when the record was made, see logger_context.h.
+ */
+
+#ifndef _AVN_LOGGER_TXT_RECORD_H_
+#define _AVN_LOGGER_TXT_RECORD_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <avn/logger/logger_context.h>
+#include <avn/logger/logger_fields.h>
+#include <avn/logger/logger_task_spill.h>
+
+namespace ALogger {
+
+    /** Text logger record
+     *
+     * Record is implicitly constructed from the message, so records without fields are added by strings as before.
+     * Current thread context is captured at the construction.
+     *
+     * \tparam _TChar Character type
+     */
+    template<typename _TChar>
+    class ALoggerTxtRecord {
+    public:
+        /** String type */
+        using TString = std::basic_string<_TChar>;
+
+        /** Message */
+        TString _message;
+
+        /** Fields block */
+        std::string _fields;
+
+        /** Thread context snapshot. Null pointer if no context was pushed */
+        ALoggerContext::TContext _context;
+
+        ALoggerTxtRecord() = default;
+
+        /** Constructor from message
+         *
+         * \tparam T Any type the message can be constructed from
+         * \param[in] message Message
+         */
+        template<typename T, typename = std::enable_if_t<std::is_constructible_v<TString, T&&>>>
+        ALoggerTxtRecord(T&& message) noexcept :
+                _message(std::forward<T>(message)), _context(ALoggerContext::current())
+        {}
+    };
+
+    /** Spill codec of text logger records
+     *
+     * Message, fields block and context are written as size prefixed parts. Context snapshot is restored as the new
+     * snapshot with the same fields and prefix.
+     *
+     * \tparam _TChar Character type
+     */
+    template<typename _TChar>
+    struct SSpillCodec<ALoggerTxtRecord<_TChar>> {
+        /** Record type */
+        using TRecord = ALoggerTxtRecord<_TChar>;
+
+        /** Records are supported */
+        constexpr static bool Supported{ true };
+
+        /** Heap memory held by record
+         *
+         * Context snapshot is shared, so it is not taken into account.
+         *
+         * \param[in] data Record
+         *
+         * \return Memory in bytes
+         */
+        static std::size_t memory(const TRecord& data) noexcept
+        {
+            return data._message.capacity() * sizeof(_TChar) + data._fields.capacity();
+        }
+
+        /** Append record bytes
+         *
+         * \param[out] out Output buffer
+         * \param[in] data Record
+         */
+        static void encode(std::string& out, const TRecord& data) noexcept
+        {
+            appendPart(out, std::string_view(reinterpret_cast<const char*>(data._message.data()), data._message.size() * sizeof(_TChar)));
+            appendPart(out, data._fields);
+            if (data._context) {
+                appendPart(out, data._context->_fields);
+                appendPart(out, data._context->_text);
+            }
+        }
+
+        /** Make record from bytes
+         *
+         * \param[in] in Bytes
+         *
+         * \return Record
+         */
+        static TRecord decode(std::string_view in) noexcept
+        {
+            TRecord data;
+
+            const auto message{ readPart(in) };
+            data._message.resize(message.size() / sizeof(_TChar));
+            std::memcpy(data._message.data(), message.data(), data._message.size() * sizeof(_TChar));
+            data._fields = readPart(in);
+
+            if (!in.empty()) {
+                auto context{ std::make_shared<SLogContext>() };
+                context->_fields = readPart(in);
+                context->_text = readPart(in);
+                data._context = std::move(context);
+            }
+
+            return data;
+        }
+
+    private:
+        static void appendPart(std::string& out, std::string_view part) noexcept
+        {
+            const auto size{ static_cast<std::uint32_t>(part.size()) };
+            out.append(reinterpret_cast<const char*>(&size), sizeof(size));
+            out.append(part);
+        }
+
+        static std::string_view readPart(std::string_view& in) noexcept
+        {
+            std::uint32_t size{0};
+            if (in.size() < sizeof(size))
+                return {};
+
+            std::memcpy(&size, in.data(), sizeof(size));
+            const auto part{ in.substr(sizeof(size), size) };
+            in.remove_prefix(std::min<std::size_t>(in.size(), sizeof(size) + size));
+            return part;
+        }
+    };
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_TXT_RECORD_H_
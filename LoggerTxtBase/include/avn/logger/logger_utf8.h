@@ -0,0 +1,245 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_utf8.h
+ * \brief UTF-8 transcoding of wide text logger messages.
+ *
+ * #ALogger::Utf8::append converts UTF-16 or UTF-32 code units to UTF-8 in bulk straight into the output byte buffer.
+ * Code unit width is defined by the character type size, so wchar_t is UTF-16 on Windows and UTF-32 on other systems.
+ *
+ * ASCII runs are the most frequent case for logger messages. If SSE2 is available, they are checked and narrowed by
+ * 16 code units at once. Other characters are encoded one by one. Unpaired surrogates and code points out of the
+ * Unicode range are replaced by U+FFFD.
+ *
+ * #ALogger::Utf8::decode makes the reverse conversion. It is used to append narrow arguments to UTF-16 and UTF-32
+ * logger messages.
+ *
+ * \code
+
+    std::string bytes;
+    ALogger::Utf8::append(bytes, L"Wide message", 12);
+
+ * \endcode
+ */
+
+#ifndef _AVN_LOGGER_UTF8_H_
+#define _AVN_LOGGER_UTF8_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AVN_LOGGER_UTF8_SSE2
+#endif
+
+namespace ALogger {
+
+    namespace Utf8 {
+
+        /** Maximum UTF-8 bytes amount per code unit
+         *
+         * \tparam _TChar Character type
+         */
+        template<typename _TChar>
+        constexpr std::size_t MaxBytes{ sizeof(_TChar) == 1 ? 1 : sizeof(_TChar) == 2 ? 3 : 4 };
+
+        /** Encode code point
+         *
+         * \param[out] out Output position, at least 4 bytes must be available
+         * \param[in] code Code point
+         *
+         * \return Position after the encoded character
+         */
+        inline char* encode(char* out, std::uint32_t code) noexcept
+        {
+            if (code < 0x80) {
+                *out++ = static_cast<char>(code);
+            } else if (code < 0x800) {
+                *out++ = static_cast<char>(0xC0 | (code >> 6));
+                *out++ = static_cast<char>(0x80 | (code & 0x3F));
+            } else if (code < 0x10000) {
+                *out++ = static_cast<char>(0xE0 | (code >> 12));
+                *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (code & 0x3F));
+            } else {
+                *out++ = static_cast<char>(0xF0 | (code >> 18));
+                *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (code & 0x3F));
+            }
+
+            return out;
+        }
+
+#ifdef AVN_LOGGER_UTF8_SSE2
+        /** Narrow ASCII run
+         *
+         * Code units are narrowed by 16 until the block with non-ASCII one is found.
+         *
+         * \tparam _TChar Character type, its size must be 2 or 4 bytes
+         * \param[in,out] in Input position
+         * \param[in] end Input end
+         * \param[in,out] out Output position
+         */
+        template<typename _TChar>
+        inline void asciiRun(const _TChar*& in, const _TChar* end, char*& out) noexcept
+        {
+            const auto zero{ _mm_setzero_si128() };
+
+            while (end - in >= 16) {
+                const auto* src{ reinterpret_cast<const __m128i*>(in) };
+                __m128i bytes;
+
+                if constexpr (sizeof(_TChar) == 2) {
+                    const auto a{ _mm_loadu_si128(src) };
+                    const auto b{ _mm_loadu_si128(src + 1) };
+                    const auto high{ _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(static_cast<short>(0xFF80))) };
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(high, zero)) != 0xFFFF)
+                        return;
+                    bytes = _mm_packus_epi16(a, b);
+                } else {
+                    const auto a{ _mm_loadu_si128(src) };
+                    const auto b{ _mm_loadu_si128(src + 1) };
+                    const auto c{ _mm_loadu_si128(src + 2) };
+                    const auto d{ _mm_loadu_si128(src + 3) };
+                    const auto high{ _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), _mm_set1_epi32(static_cast<int>(0xFFFFFF80))) };
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(high, zero)) != 0xFFFF)
+                        return;
+                    bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), bytes);
+                in += 16;
+                out += 16;
+            }
+        }
+#endif // AVN_LOGGER_UTF8_SSE2
+
+        /** Append UTF-8 encoded text
+         *
+         * \tparam _TChar Character type. 1 byte characters are copied as is, 2 bytes ones are treated as UTF-16 and
+         * 4 bytes ones as UTF-32
+         *
+         * \param[out] out Output buffer. Encoded text is appended to it
+         * \param[in] data Text
+         * \param[in] size Text size in code units
+         */
+        template<typename _TChar>
+        void append(std::string& out, const _TChar* data, std::size_t size) noexcept
+        {
+            if constexpr (sizeof(_TChar) == 1) {
+                out.append(reinterpret_cast<const char*>(data), size);
+                return;
+            } else {
+                const auto start{ out.size() };
+                out.resize(start + size * MaxBytes<_TChar>);
+
+                char* pos{ out.data() + start };
+                const _TChar* end{ data + size };
+
+                while (data != end) {
+#ifdef AVN_LOGGER_UTF8_SSE2
+                    asciiRun(data, end, pos);
+                    if (data == end)
+                        break;
+#endif
+                    auto code{ static_cast<std::uint32_t>(data[0]) };
+
+                    if (code < 0x80) {
+                        *pos++ = static_cast<char>(code);
+                        ++data;
+                        continue;
+                    }
+
+                    ++data;
+
+                    if constexpr (sizeof(_TChar) == 2) {
+                        code &= 0xFFFF;
+                        if (code >= 0xD800 && code < 0xE000) {
+                            const auto low{ data != end ? static_cast<std::uint32_t>(data[0]) & 0xFFFF : 0 };
+                            if (code < 0xDC00 && low >= 0xDC00 && low < 0xE000) {
+                                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                                ++data;
+                            } else {
+                                code = 0xFFFD;
+                            }
+                        }
+                    } else {
+                        if ((code >= 0xD800 && code < 0xE000) || code > 0x10FFFF)
+                            code = 0xFFFD;
+                    }
+
+                    pos = encode(pos, code);
+                }
+
+                out.resize(static_cast<std::size_t>(pos - out.data()));
+            }
+        }
+
+        /** Append UTF-8 encoded text
+         *
+         * \tparam _TChar Character type
+         *
+         * \param[out] out Output buffer. Encoded text is appended to it
+         * \param[in] str Text
+         */
+        template<typename _TChar>
+        void append(std::string& out, const std::basic_string<_TChar>& str) noexcept    { append(out, str.data(), str.size()); }
+
+        /** Append UTF-8 decoded text
+         *
+         * Invalid sequences are replaced by U+FFFD.
+         *
+         * \tparam _TChar Character type. 2 bytes characters are treated as UTF-16, 4 bytes ones as UTF-32
+         *
+         * \param[out] out Output buffer. Decoded text is appended to it
+         * \param[in] str UTF-8 text
+         */
+        template<typename _TChar>
+        void decode(std::basic_string<_TChar>& out, std::string_view str) noexcept
+        {
+            static_assert(sizeof(_TChar) == 2 || sizeof(_TChar) == 4, "UTF-16 or UTF-32 character type is required");
+
+            const auto* data{ reinterpret_cast<const unsigned char*>(str.data()) };
+            const auto* end{ data + str.size() };
+
+            while (data != end) {
+                std::uint32_t code{ *data++ };
+
+                if (code >= 0x80) {
+                    const std::size_t extra{ code >= 0xF0 ? 3u : code >= 0xE0 ? 2u : code >= 0xC0 ? 1u : 0u };
+                    const std::uint32_t min{ extra == 3 ? 0x10000u : extra == 2 ? 0x800u : 0x80u };
+                    bool valid{ extra != 0 && code < 0xF8 && static_cast<std::size_t>(end - data) >= extra };
+
+                    if (valid) {
+                        code &= 0x3F >> extra;
+                        for (std::size_t i = 0; i < extra && valid; ++i) {
+                            valid = (data[i] & 0xC0) == 0x80;
+                            code = (code << 6) | (data[i] & 0x3F);
+                        }
+                        valid = valid && code >= min && code <= 0x10FFFF && (code < 0xD800 || code >= 0xE000);
+                    }
+
+                    if (valid)
+                        data += extra;
+                    else
+                        code = 0xFFFD;
+                }
+
+                if (sizeof(_TChar) == 2 && code >= 0x10000) {
+                    code -= 0x10000;
+                    out.push_back(static_cast<_TChar>(0xD800 + (code >> 10)));
+                    out.push_back(static_cast<_TChar>(0xDC00 + (code & 0x3FF)));
+                } else {
+                    out.push_back(static_cast<_TChar>(code));
+                }
+            }
+        }
+
+    } // namespace Utf8
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_UTF8_H_
@@ -0,0 +1,257 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_txt_console.h
+ * \brief ALoggerTxtConsole class implements text logging to the standard output and error file descriptors.
+ *
+ * As #ALogger::ALoggerBase child this class has features listed below :
+ * - multithreading or single thread mode.
+ * - enable or disable logger levels. If current output message has level that is enabled now, it will be output. Also it
+ * is possible to output regardless of current logger level by using #forceAddToLog call.
+ * - add logger tasks and automatically finish them.
+ *
+ * Unlike #ALogger::ALoggerTxtCOut this class does not use iostreams. Messages are formatted into the own buffer and
+ * written to the file descriptors 1 and 2 by writev(2), so there are no stream sentries, no stdio synchronization and
+ * no per-character codecvt calls. wchar_t, char16_t and char32_t strings are encoded to UTF-8 by #ALogger::Utf8::append.
+ *
+ * Messages with levels specified by #ALogger::ALoggerTxtConsole::setErrorLevels call are written to the standard
+ * error, other ones to the standard output. Both are batched in the same buffer; the buffer is written before the
+ * output descriptor change, so messages order is kept.
+ *
+ * If the descriptor is a terminal, each message is written instantly. Otherwise messages are batched according to
+ * the flush policy, by default up to #ALogger::ALoggerTxtConsole::MaxBatch bytes. See \a setFlushPolicy call and
+ * #ALogger::ALoggerFlushPolicy class description.
+ *
+ * \code
+
+    constexpr auto INFO = 0;        // INFO identifier
+    constexpr auto ERROR = 1;       // ERROR identifier
+
+    ALogger::ALoggerTxtConsole<true, char> logger;
+
+    logger.addLevelDescr(INFO, "INFO");
+    logger.addLevelDescr(ERROR, "ERROR");
+    logger.setLevels({ INFO, ERROR });
+    logger.setErrorLevels({ ERROR });
+
+    logger.addString(INFO, "This is test string : integer = ", 10);
+    logger.addString(ERROR, "This is error string");
+
+ * \endcode
+ *
+ * \warning Only POSIX systems are supported.
+ */
+
+#ifndef _AVN_LOGGER_TXT_CONSOLE_H_
+#define _AVN_LOGGER_TXT_CONSOLE_H_
+
+#include <cerrno>
+#include <string>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <avn/logger/logger_txt_base.h>
+#include <avn/logger/logger_flush_policy.h>
+#include <avn/logger/logger_utf8.h>
+
+namespace ALogger {
+
+    /** Console logger with raw file descriptors output
+     *
+     * \tparam _ThrSafe Thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated.
+     * \tparam _TChar Character type. char, wchar_t, char16_t and char32_t are supported.
+     */
+    template<bool _ThrSafe, typename _TChar>
+    class ALoggerTxtConsole : public ALoggerTxtBase<_ThrSafe, _TChar> {
+    public:
+        /** Current thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated */
+        constexpr static bool ThrSafe{ _ThrSafe };
+
+        /** Character type for text logger messages */
+        using TChar = _TChar;
+
+        static_assert(std::is_same_v<TChar, char> || std::is_same_v<TChar, wchar_t> || std::is_same_v<TChar, char16_t> || std::is_same_v<TChar, char32_t>,
+                      "Unsupported character type");
+
+        /** String type for text logger messages */
+        using TString = std::basic_string<_TChar>;
+
+        /** Maximum batch size */
+        constexpr static std::size_t MaxBatch{ 64 * 1024 };
+
+        /** Default constructor with time zone selector
+         *
+         * \param[in] local_time Local time or GMT will be used as time zone. Loca time is selected by default
+         * \param[in] out_fd Standard output file descriptor
+         * \param[in] err_fd Standard error file descriptor
+         */
+        ALoggerTxtConsole(bool local_time = true, int out_fd = STDOUT_FILENO, int err_fd = STDERR_FILENO) noexcept;
+
+        ALoggerTxtConsole(const ALoggerTxtConsole&) = delete;
+
+        ~ALoggerTxtConsole() noexcept override                             { flush(); }
+
+        /** Write all batched messages
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtConsole& flush() noexcept                                 { auto lock{ _flush.lock() }; writeBatch(false); _flush.flushed(); return *this; }
+
+        /** Set levels to be written to the standard error
+         *
+         * \param[in] levels Levels list
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtConsole& setErrorLevels(const TLevels& levels) noexcept   { auto lock{ _flush.lock() }; _errorLevels = levels; return *this; }
+
+        /** Get levels to be written to the standard error
+         *
+         * \return Levels list
+         */
+        const TLevels& errorLevels() const noexcept                         { return _errorLevels; }
+
+        /** Set flush policy
+         *
+         * Messages to the terminal are always written instantly. fdatasync(2) option is ignored.
+         *
+         * \param[in] policy Flush policy
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtConsole& setFlushPolicy(const SFlushPolicy& policy) noexcept    { _flush.setPolicy(policy); return *this; }
+
+        /** Get flush policy engine
+         *
+         * \return Flush policy engine
+         */
+        const ALoggerFlushPolicy& flushPolicy() const noexcept              { return _flush; }
+
+        /** Check that output file descriptor is a terminal
+         *
+         * \param[in] error Check standard error instead of standard output
+         *
+         * \return True if descriptor is a terminal
+         */
+        bool isTerminal(bool error = false) const noexcept                  { return _tty[error ? 1 : 0]; }
+
+        /** Failed writes amount
+         *
+         * \return Failed writes amount
+         */
+        std::size_t writeErrors() const noexcept                           { return _errors; }
+
+    private:
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept override;
+        int writeBatch(bool datasync) noexcept;
+        void writeAll(int fd, iovec* iov, int count) noexcept;
+
+        TString _line;      // Reusable message buffer
+        int _fds[2];
+        bool _tty[2];
+        TLevels _errorLevels;
+
+        std::string _batch;
+        std::size_t _batchFd{0};
+        std::string _encoded;
+        std::size_t _errors{0};
+
+        ALoggerFlushPolicy _flush;
+    };
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtConsole<_ThrSafe, _TChar>::ALoggerTxtConsole(bool local_time, int out_fd, int err_fd) noexcept :
+            ALoggerTxtBase<_ThrSafe, _TChar>(local_time),
+            _fds{ out_fd, err_fd },
+            _tty{ ::isatty(out_fd) == 1, ::isatty(err_fd) == 1 },
+            _flush([this](bool datasync) { return writeBatch(datasync); }, SFlushPolicy{ MaxBatch, std::chrono::milliseconds(0), {} })
+    {
+        _batch.reserve(MaxBatch);
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtConsole<_ThrSafe, _TChar>::writeAll(int fd, iovec* iov, int count) noexcept
+    {
+        while (count != 0) {
+            const auto res{ ::writev(fd, iov, count) };
+
+            if (res < 0) {
+                if (errno == EINTR)
+                    continue;
+                ++_errors;
+                return;
+            }
+
+            // Skip written part, pipes and terminals can accept data partially
+            auto written{ static_cast<std::size_t>(res) };
+            while (count != 0 && written >= iov->iov_len) {
+                written -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+
+            if (count != 0) {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+                iov->iov_len -= written;
+            }
+        }
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    int ALoggerTxtConsole<_ThrSafe, _TChar>::writeBatch(bool /* datasync */) noexcept
+    {
+        if (!_batch.empty()) {
+            iovec iov{ _batch.data(), _batch.size() };
+            writeAll(_fds[_batchFd], &iov, 1);
+            _batch.clear();
+        }
+
+        return -1;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    bool ALoggerTxtConsole<_ThrSafe, _TChar>::outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept
+    {
+        auto lock{ _flush.lock() };
+
+        auto& str{ _line };
+        str.clear();
+        ALoggerTxtBase<_ThrSafe, _TChar>::prepareString(str, level, time, data);
+        const std::string* bytes;
+
+        if constexpr (std::is_same_v<_TChar, char>)
+            bytes = &str;
+        else {
+            _encoded.clear();
+            Utf8::append(_encoded, str);
+            bytes = &_encoded;
+        }
+
+        const std::size_t target{ _errorLevels.count(level) != 0 ? 1u : 0u };
+
+        if (!_batch.empty() && (_batchFd != target || _batch.size() + bytes->size() + 1 > MaxBatch)) {
+            writeBatch(false);
+            _flush.flushed();
+        }
+        _batchFd = target;
+
+        if (_flush.written(level, bytes->size() + 1) || _tty[target]) {
+            // Batch, message and new line are written by one call without copying the message
+            char new_line{'\n'};
+            iovec iov[3]{ { _batch.data(), _batch.size() }, { const_cast<char*>(bytes->data()), bytes->size() }, { &new_line, 1 } };
+
+            writeAll(_fds[target], _batch.empty() ? iov + 1 : iov, _batch.empty() ? 2 : 3);
+            _batch.clear();
+            _flush.flushed();
+        } else {
+            _batch.append(*bytes);
+            _batch.push_back('\n');
+        }
+
+        return true;
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_TXT_CONSOLE_H_
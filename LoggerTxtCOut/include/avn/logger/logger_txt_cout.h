@@ -17,6 +17,9 @@
  * you enable some logger levels. After you output messages with logger level. Like this you can disable, say, debug
  * messages for normal operation mode.
  *
+ * By default each message is flushed. You can change it by \a setFlushPolicy call, see #ALogger::ALoggerFlushPolicy
+ * class description.
+ *
  * Its usage is obvious :
  * \code
 
@@ -42,6 +45,7 @@
 #include <iostream>
 
 #include <avn/logger/logger_txt_base.h>
+#include <avn/logger/logger_flush_policy.h>
 
 namespace ALogger {
 
@@ -66,7 +70,31 @@ namespace ALogger {
          *
          * \param[in] local_time Local time or GMT will be used as time zone. Loca time is selected by default
          */
-        ALoggerTxtCOut(bool local_time = true) noexcept : ALoggerTxtBase<_ThrSafe, _TChar>(local_time)    {}
+        ALoggerTxtCOut(bool local_time = true) noexcept :
+                ALoggerTxtBase<_ThrSafe, _TChar>(local_time),
+                _flush([](bool) { outStream().flush(); return -1; }, SFlushPolicy{ 0, std::chrono::milliseconds(0), {}, true })    {}
+
+        /** Flush all output messages
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtCOut& flush() noexcept                                    { auto lock{ _flush.lock() }; outStream().flush(); _flush.flushed(); return *this; }
+
+        /** Set flush policy
+         *
+         * fdatasync(2) option is ignored.
+         *
+         * \param[in] policy Flush policy
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtCOut& setFlushPolicy(const SFlushPolicy& policy) noexcept  { _flush.setPolicy(policy); return *this; }
+
+        /** Get flush policy engine
+         *
+         * \return Flush policy engine
+         */
+        const ALoggerFlushPolicy& flushPolicy() const noexcept              { return _flush; }
 
         /** Set the associated locale of the stream to the given one
          *
@@ -77,12 +105,26 @@ namespace ALogger {
     private:
         bool outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept override;
         static std::basic_ostream<_TChar>& outStream() noexcept;
+
+        TString _line;      // Reusable message buffer
+        ALoggerFlushPolicy _flush;
     };
 
     template<bool _ThrSafe, typename _TChar>
     bool ALoggerTxtCOut<_ThrSafe, _TChar>::outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept
     {
-        outStream() << ALoggerTxtBase<_ThrSafe, _TChar>::prepareString(level, time, data) << std::endl;
+        auto lock{ _flush.lock() };
+        auto& str{ _line };
+        str.clear();
+        ALoggerTxtBase<_ThrSafe, _TChar>::prepareString(str, level, time, data);
+
+        outStream() << str << outStream().widen('\n');
+
+        if (_flush.written(level, str.size() + 1)) {
+            outStream().flush();
+            _flush.flushed();
+        }
+
         return true;
     }
 
@@ -0,0 +1,289 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_file_index.h
+ * \brief ALoggerFileIndex and ALoggerFileIndexReader classes implement sparse time index of the log file.
+ *
+ * Time index is the sidecar file "<file>.idx" that is written together with the log file. It consists of fixed size
+ * entries, each entry is :
+ * - maximum time of all records written before the entry offset as microseconds since epoch, signed 64 bit ;
+ * - record offset in the log file, unsigned 64 bit ;
+ * - maximum lateness of records written so far in microseconds, signed 64 bit.
+ *
+ * All integers are stored in little-endian byte order. Entry is added before the record that is written after
+ * #ALogger::SIndexPolicy::_bytes bytes or #ALogger::SIndexPolicy::_records records since the previous entry.
+ *
+ * Records are not ordered by time : task outputs its records with their original timestamps at the task end. Record
+ * lateness is the difference between the maximum time of records written before it and its own time. Entry times are
+ * the running maximum, so they are non-decreasing, and #ALogger::ALoggerFileIndexReader finds time range borders by
+ * the binary search with O(log n) seeks :
+ * - records before the start offset are earlier than the range start, because their maximum time is ;
+ * - records after the end offset are later than the range end, because the end entry time exceeds the range end by
+ * more than the maximum lateness. Entry is added as soon as the record lateness exceeds the one of the previous entry,
+ * so the last entry lateness covers all written records.
+ *
+ * Offsets are byte offsets in the log file.
+ *
+ * \code
+
+    ALogger::ALoggerTxtFile<true, char> logger("/tmp/test.txt"s);
+
+    logger.setIndex({ 64 * 1024,        // Add index entry each 64 KB
+                      0 });             // Do not add index entries by records amount
+
+ * \endcode
+ */
+
+#ifndef _AVN_LOGGER_FILE_INDEX_H_
+#define _AVN_LOGGER_FILE_INDEX_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+namespace ALogger {
+
+    /** Time index policy */
+    struct SIndexPolicy {
+        /** Add index entry after this bytes amount. Zero disables this criterion */
+        std::size_t _bytes{0};
+
+        /** Add index entry after this records amount. Zero disables this criterion */
+        std::size_t _records{0};
+
+        /** Check that any index criterion is specified
+         *
+         * \return True if index is enabled
+         */
+        bool enabled() const noexcept { return _bytes != 0 || _records != 0; }
+    };
+
+    /** Time index sidecar file writer */
+    class ALoggerFileIndex {
+    public:
+        /** Index file name suffix */
+        constexpr static const char* Suffix{ ".idx" };
+
+        /** Index entry size */
+        constexpr static std::size_t EntrySize{ 24 };
+
+        /** Index file name
+         *
+         * \param[in] filename Log file name and path
+         *
+         * \return Index file name and path
+         */
+        static std::filesystem::path indexPath(std::filesystem::path filename)   { filename += Suffix; return filename; }
+
+        /** Constructor
+         *
+         * \param[in] policy Index policy
+         */
+        explicit ALoggerFileIndex(SIndexPolicy policy) noexcept : _policy(policy)     {}
+
+        /** Open index file
+         *
+         * \param[in] filename Log file name and path
+         * \param[in] offset Current log file size. Entries are appended to the existing index if it is not zero
+         */
+        void open(const std::filesystem::path& filename, std::uintmax_t offset);
+
+        /** Close index file */
+        void close()                                                        { _file.close(); }
+
+        /** Flush index file */
+        void flush()                                                        { _file.flush(); }
+
+        /** Register record
+         *
+         * This function has to be called before the record output. Index entry is added if needed.
+         *
+         * \param[in] time Record time
+         * \param[in] offset Record offset in the log file
+         */
+        void record(std::chrono::system_clock::time_point time, std::uintmax_t offset);
+
+    private:
+        SIndexPolicy _policy;
+        std::ofstream _file;
+
+        std::int64_t _maxTime{ std::numeric_limits<std::int64_t>::min() };
+        std::int64_t _lateness{0};
+        std::int64_t _entryLateness{0};     // Lateness written to the last entry
+        std::uintmax_t _lastOffset{0};
+        std::size_t _records{0};
+        bool _first{true};
+    };
+
+    /** Time index sidecar file reader */
+    class ALoggerFileIndexReader {
+    public:
+        /** Constructor
+         *
+         * \param[in] filename Log file name and path
+         */
+        explicit ALoggerFileIndexReader(const std::filesystem::path& filename);
+
+        /** Check that index file is opened
+         *
+         * \return True if index file is opened
+         */
+        operator bool () const noexcept                                     { return _file.is_open(); }
+
+        /** Index entries amount
+         *
+         * \return Index entries amount
+         */
+        std::uint64_t entries() const noexcept                              { return _entries; }
+
+        /** Find log file range containing records within time window
+         *
+         * Range is found with index granularity, so it can contain records out of the window.
+         *
+         * \param[in] from Window start
+         * \param[in] to Window end
+         *
+         * \return Start offset and end offset. End offset is max value if range is not limited by the index
+         */
+        std::pair<std::uint64_t, std::uint64_t> range(std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to);
+
+    private:
+        std::ifstream _file;
+        std::uint64_t _entries{0};
+
+        struct SEntry {
+            std::int64_t _time;
+            std::uint64_t _offset;
+            std::int64_t _lateness;
+        };
+
+        SEntry entry(std::uint64_t index);
+        std::uint64_t upperBound(std::int64_t time);
+    };
+
+    namespace FileIndex {
+
+        inline std::int64_t microseconds(std::chrono::system_clock::time_point time) noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+        }
+
+    } // namespace FileIndex
+
+    inline void ALoggerFileIndex::open(const std::filesystem::path& filename, std::uintmax_t offset)
+    {
+        _file.open(indexPath(filename), std::ios_base::binary | (offset != 0 ? std::ios_base::app : std::ios_base::trunc));
+        _records = 0;
+        _lastOffset = offset;
+        _first = offset == 0;
+        _lateness = _entryLateness = 0;
+
+        // Existing records times are unknown, but they are earlier than now
+        _maxTime = _first ? std::numeric_limits<std::int64_t>::min() : FileIndex::microseconds(std::chrono::system_clock::now());
+    }
+
+    inline void ALoggerFileIndex::record(std::chrono::system_clock::time_point time, std::uintmax_t offset)
+    {
+        if (!_file.is_open())
+            return;
+
+        const auto time_us{ FileIndex::microseconds(time) };
+        if (!_first && time_us < _maxTime)
+            _lateness = std::max(_lateness, _maxTime - time_us);
+
+        if (_first || _lateness > _entryLateness ||
+                (_policy._bytes != 0 && offset - _lastOffset >= _policy._bytes) || (_policy._records != 0 && _records >= _policy._records)) {
+            unsigned char data[EntrySize];
+            const auto time_bits{ static_cast<std::uint64_t>(_maxTime) };
+            const auto offset_bits{ static_cast<std::uint64_t>(offset) };
+            const auto lateness_bits{ static_cast<std::uint64_t>(_lateness) };
+
+            for (int i = 0; i < 8; ++i) {
+                data[i] = static_cast<unsigned char>(time_bits >> (8 * i));
+                data[8 + i] = static_cast<unsigned char>(offset_bits >> (8 * i));
+                data[16 + i] = static_cast<unsigned char>(lateness_bits >> (8 * i));
+            }
+
+            _file.write(reinterpret_cast<const char*>(data), sizeof(data));
+            _lastOffset = offset;
+            _entryLateness = _lateness;
+            _records = 0;
+            _first = false;
+        }
+
+        _maxTime = std::max(_maxTime, time_us);
+        ++_records;
+    }
+
+    inline ALoggerFileIndexReader::ALoggerFileIndexReader(const std::filesystem::path& filename) :
+            _file(ALoggerFileIndex::indexPath(filename), std::ios_base::binary)
+    {
+        std::error_code ec;
+        const auto size{ std::filesystem::file_size(ALoggerFileIndex::indexPath(filename), ec) };
+        _entries = ec ? 0 : size / ALoggerFileIndex::EntrySize;
+    }
+
+    inline ALoggerFileIndexReader::SEntry ALoggerFileIndexReader::entry(std::uint64_t index)
+    {
+        unsigned char data[ALoggerFileIndex::EntrySize]{};
+
+        _file.clear();
+        _file.seekg(static_cast<std::streamoff>(index * ALoggerFileIndex::EntrySize));
+        _file.read(reinterpret_cast<char*>(data), sizeof(data));
+
+        std::uint64_t time{0}, offset{0}, lateness{0};
+        for (int i = 7; i >= 0; --i) {
+            time = (time << 8) | data[i];
+            offset = (offset << 8) | data[8 + i];
+            lateness = (lateness << 8) | data[16 + i];
+        }
+
+        return { static_cast<std::int64_t>(time), offset, static_cast<std::int64_t>(lateness) };
+    }
+
+    inline std::uint64_t ALoggerFileIndexReader::upperBound(std::int64_t time)
+    {
+        // First entry with time greater than specified one
+        std::uint64_t first{0}, count{ _entries };
+
+        while (count > 0) {
+            const auto step{ count / 2 };
+            const auto middle{ first + step };
+
+            if (entry(middle)._time <= time) {
+                first = middle + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+
+        return first;
+    }
+
+    inline std::pair<std::uint64_t, std::uint64_t> ALoggerFileIndexReader::range(std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to)
+    {
+        const auto from_us{ FileIndex::microseconds(from) };
+        const auto to_us{ FileIndex::microseconds(to) };
+
+        if (_entries == 0)
+            return { 0, std::numeric_limits<std::uint64_t>::max() };
+
+        // All records before the entry with time less than window start are earlier than the window
+        const auto start{ from_us == std::numeric_limits<std::int64_t>::min() ? 0 : upperBound(from_us - 1) };
+
+        // Records after the end entry are not later than the maximum lateness
+        const auto lateness{ entry(_entries - 1)._lateness };
+        const auto end{ to_us > std::numeric_limits<std::int64_t>::max() - lateness ? _entries : upperBound(to_us + lateness) };
+
+        return { start == 0 ? 0 : entry(start - 1)._offset,
+                 end == _entries ? std::numeric_limits<std::uint64_t>::max() : entry(end)._offset };
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_FILE_INDEX_H_
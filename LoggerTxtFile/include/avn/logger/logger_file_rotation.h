@@ -0,0 +1,325 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_file_rotation.h
+ * \brief ALoggerFileRotation class implements background file segments rotation.
+ *
+ * #ALogger::ALoggerFileRotation class is used by #ALogger::ALoggerTxtFile to switch output file segments without
+ * stalling message producers. All slow file system operations are performed by the background thread :
+ * - the next segment is pre-opened in advance as "<file>.next" ;
+ * - retired segment is closed (flushed) ;
+ * - rotated segments are renamed as "<file>.1", "<file>.2" etc., the oldest ones are deleted. Sidecar files like
+ * "<file>.idx" are renamed together with their segments.
+ *
+ * Output thread only swaps stream pointers, see #ALogger::ALoggerFileRotation::rotate call. If the next segment is not
+ * ready yet, rotation is postponed till the next message instead of waiting for the background thread.
+ *
+ * Rotation is configured by #ALogger::SRotationPolicy structure :
+ *
+ * \code
+
+    ALogger::ALoggerTxtFile<true, char> logger(L"/tmp/test.txt"s);
+
+    logger.setRotation({ 10 * 1024 * 1024,          // Switch segment after 10 MB
+                         std::chrono::hours(24),    // or at the midnight (UTC)
+                         7 });                      // Keep 7 rotated segments
+
+ * \endcode
+ */
+
+#ifndef _AVN_LOGGER_FILE_ROTATION_H_
+#define _AVN_LOGGER_FILE_ROTATION_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <locale>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ALogger {
+
+    /** File rotation policy */
+    struct SRotationPolicy {
+        /** Maximum segment size. It is counted in bytes written. Zero disables size based rotation */
+        std::uintmax_t _maxSize{0};
+
+        /** Wall-clock rotation interval. Segments are switched on interval boundaries counted from the epoch (UTC),
+         * i. e. one hour interval switches segments at the beginning of each hour. Zero disables time based rotation */
+        std::chrono::seconds _interval{0};
+
+        /** Rotated segments amount to be kept. Zero keeps all of them */
+        std::size_t _keepFiles{0};
+
+        /** Check that any rotation criterion is specified
+         *
+         * \return True if rotation is enabled
+         */
+        bool enabled() const noexcept { return _maxSize != 0 || _interval.count() != 0; }
+    };
+
+    /** Background segments rotation for file stream based loggers
+     *
+     * \tparam _TStream File stream type
+     */
+    template<typename _TStream>
+    class ALoggerFileRotation {
+    public:
+        /** File stream type */
+        using TStream = _TStream;
+
+        /** File stream pointer type */
+        using TStreamPtr = std::unique_ptr<TStream>;
+
+        /** New segment stream setup function type. It is called before the stream opening */
+        using TSetup = std::function<void (TStream& stream)>;
+
+        /** Constructor
+         *
+         * Background thread is started and the next segment is pre-opened immediately.
+         *
+         * \param[in] filename Active segment file name and path
+         * \param[in] policy Rotation policy
+         * \param[in] loc Locale to be associated with new segments
+         * \param[in] setup New segment stream setup function
+         * \param[in] sidecars Suffixes of the files to be rotated together with segments
+         */
+        ALoggerFileRotation(std::filesystem::path filename, SRotationPolicy policy, std::locale loc, TSetup setup = {},
+                            std::vector<std::string> sidecars = {}) noexcept;
+
+        ALoggerFileRotation(const ALoggerFileRotation&) = delete;
+        ALoggerFileRotation& operator=(const ALoggerFileRotation&) = delete;
+
+        /** Destructor
+         *
+         * Pending renaming is finished, pre-opened segment is removed.
+         */
+        ~ALoggerFileRotation() noexcept;
+
+        /** Check that active segment has to be switched
+         *
+         * \param[in] written Bytes amount written to the active segment
+         * \param[in] time Current message timestamp
+         *
+         * \return True if rotation is needed
+         */
+        bool rotationDue(std::uintmax_t written, std::chrono::system_clock::time_point time) const noexcept
+        {
+            return (_policy._maxSize != 0 && written >= _policy._maxSize) || time >= _deadline;
+        }
+
+        /** Switch active segment
+         *
+         * This function swaps \a stream with pre-opened one. Retired stream is closed and renamed by the background
+         * thread. The call never waits for the background thread; if the next segment is not ready yet, \a stream is
+         * left untouched.
+         *
+         * \param[in,out] stream Active segment stream
+         * \param[in] time Current message timestamp
+         *
+         * \return True if segment is switched
+         */
+        bool rotate(TStreamPtr& stream, std::chrono::system_clock::time_point time) noexcept;
+
+        /** Set the associated locale for new segments
+         *
+         * \param[in] loc New locale
+         */
+        void imbue(const std::locale& loc) noexcept;
+
+    private:
+        using TClock = std::chrono::system_clock;
+
+        std::filesystem::path _filename;
+        std::filesystem::path _nextFilename;
+        SRotationPolicy _policy;
+        std::locale _locale;
+        TSetup _setup;
+        std::vector<std::string> _sidecars;
+        TClock::time_point _deadline;
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        TStreamPtr _next;
+        std::vector<TStreamPtr> _retired;
+        bool _openFailed{false};
+        bool _stop{false};
+        std::thread _thread;
+
+        TClock::time_point nextDeadline(TClock::time_point time) const noexcept;
+        std::filesystem::path segmentPath(std::size_t index, const std::string& suffix = {}) const;
+        void shiftSegments() noexcept;
+        void worker() noexcept;
+    };
+
+    template<typename _TStream>
+    ALoggerFileRotation<_TStream>::ALoggerFileRotation(std::filesystem::path filename, SRotationPolicy policy, std::locale loc, TSetup setup,
+                                                       std::vector<std::string> sidecars) noexcept :
+            _filename(std::move(filename)), _policy(policy), _locale(std::move(loc)), _setup(std::move(setup)), _sidecars(std::move(sidecars)),
+            _deadline(nextDeadline(TClock::now()))
+    {
+        _nextFilename = _filename;
+        _nextFilename += ".next";
+        _thread = std::thread(&ALoggerFileRotation::worker, this);
+    }
+
+    template<typename _TStream>
+    ALoggerFileRotation<_TStream>::~ALoggerFileRotation() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cv.notify_one();
+        _thread.join();
+
+        if (_next) {
+            _next->close();
+            std::error_code ec;
+            std::filesystem::remove(_nextFilename, ec);
+            for (const auto& suffix : _sidecars)
+                std::filesystem::remove(std::filesystem::path(_nextFilename) += suffix, ec);
+        }
+    }
+
+    template<typename _TStream>
+    typename ALoggerFileRotation<_TStream>::TClock::time_point ALoggerFileRotation<_TStream>::nextDeadline(TClock::time_point time) const noexcept
+    {
+        if (_policy._interval.count() == 0)
+            return TClock::time_point::max();
+
+        const auto since_epoch{ std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()) };
+        return TClock::time_point((since_epoch / _policy._interval + 1) * _policy._interval);
+    }
+
+    template<typename _TStream>
+    bool ALoggerFileRotation<_TStream>::rotate(TStreamPtr& stream, TClock::time_point time) noexcept
+    {
+        std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+        if (!lock.owns_lock())
+            return false;
+
+        if (!_next) {
+            _openFailed = false;
+            lock.unlock();
+            _cv.notify_one();
+            return false;
+        }
+
+        std::swap(stream, _next);
+        _retired.emplace_back(std::move(_next));
+        _deadline = nextDeadline(time);
+
+        lock.unlock();
+        _cv.notify_one();
+        return true;
+    }
+
+    template<typename _TStream>
+    void ALoggerFileRotation<_TStream>::imbue(const std::locale& loc) noexcept
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _locale = loc;
+        if (_next)
+            _next->imbue(loc);
+    }
+
+    template<typename _TStream>
+    std::filesystem::path ALoggerFileRotation<_TStream>::segmentPath(std::size_t index, const std::string& suffix) const
+    {
+        auto path{ _filename };
+        path += "." + std::to_string(index) + suffix;
+        return path;
+    }
+
+    template<typename _TStream>
+    void ALoggerFileRotation<_TStream>::shiftSegments() noexcept
+    {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+
+        std::size_t last{ _policy._keepFiles };
+        if (last == 0) {
+            last = 1;
+            while (fs::exists(segmentPath(last), ec))
+                ++last;
+        } else {
+            fs::remove(segmentPath(last), ec);
+        }
+
+        for (std::size_t index = last; index > 1; --index)
+            fs::rename(segmentPath(index - 1), segmentPath(index), ec);
+
+        fs::rename(_filename, segmentPath(1), ec);
+        fs::rename(_nextFilename, _filename, ec);
+
+        // Missing sidecar must not leave the stale one of another segment
+        const auto move = [&ec](const fs::path& from, const fs::path& to) {
+            fs::rename(from, to, ec);
+            if (ec)
+                fs::remove(to, ec);
+        };
+
+        for (const auto& suffix : _sidecars) {
+            if (_policy._keepFiles != 0)
+                fs::remove(segmentPath(last, suffix), ec);
+
+            for (std::size_t index = last; index > 1; --index)
+                move(segmentPath(index - 1, suffix), segmentPath(index, suffix));
+
+            move(fs::path(_filename) += suffix, segmentPath(1, suffix));
+            move(fs::path(_nextFilename) += suffix, fs::path(_filename) += suffix);
+        }
+    }
+
+    template<typename _TStream>
+    void ALoggerFileRotation<_TStream>::worker() noexcept
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (true) {
+            _cv.wait(lock, [this] { return _stop || !_retired.empty() || (!_next && !_openFailed); });
+
+            auto retired{ std::move(_retired) };
+            _retired.clear();
+            const bool to_prepare{ !_stop && !_next && !_openFailed };
+            const auto loc{ _locale };
+            lock.unlock();
+
+            for (auto& stream : retired) {
+                stream->close();
+                shiftSegments();
+            }
+            retired.clear();
+
+            TStreamPtr next;
+            if (to_prepare) {
+                next = std::make_unique<TStream>();
+                next->imbue(loc);
+                if (_setup)
+                    _setup(*next);
+                next->open(_nextFilename, std::ios_base::out | std::ios_base::trunc);
+            }
+
+            lock.lock();
+
+            if (next) {
+                if (next->is_open())
+                    _next = std::move(next);
+                else
+                    _openFailed = true;
+            }
+
+            if (_stop && _retired.empty())
+                break;
+        }
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_FILE_ROTATION_H_
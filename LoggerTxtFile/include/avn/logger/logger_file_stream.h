@@ -0,0 +1,150 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_file_stream.h
+ * \brief ALoggerFileStream class is the output file stream that can be synchronized with the disk.
+ *
+ * std::basic_ofstream does not provide its file descriptor. #ALogger::ALoggerFileStream keeps additional read-only
+ * descriptor of the same file that is opened together with the stream. It is used for fdatasync(2) calls because
+ * synchronization is performed for the file, not for the descriptor.
+ *
+ * Also the stream can write the time index sidecar file together with the log file, see logger_file_index.h.
+ */
+
+#ifndef _AVN_LOGGER_FILE_STREAM_H_
+#define _AVN_LOGGER_FILE_STREAM_H_
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#if __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <unistd.h>
+#define AVN_LOGGER_FILE_STREAM_FD
+#endif
+
+#include <avn/logger/logger_file_index.h>
+
+namespace ALogger {
+
+    /** Output file stream with file descriptor for synchronization
+     *
+     * \tparam _TChar Character type
+     */
+    template<typename _TChar>
+    class ALoggerFileStream : public std::basic_ofstream<_TChar> {
+    private:
+        using TBase = std::basic_ofstream<_TChar>;
+
+    public:
+        ALoggerFileStream() = default;
+        ALoggerFileStream(const ALoggerFileStream&) = delete;
+
+        ~ALoggerFileStream()                                                 { closeFd(); }
+
+        /** Open file
+         *
+         * \param[in] filename File name and path
+         * \param[in] mode File mode as std::ios_base::openmode mask
+         */
+        void open(const std::filesystem::path& filename, std::ios_base::openmode mode = std::ios_base::out);
+
+        /** Close file */
+        void close()                                                        { TBase::close(); closeFd(); _index.reset(); }
+
+        /** Flush file and its time index
+         *
+         * \return Current instance reference
+         */
+        ALoggerFileStream& flush()                                          { TBase::flush(); if (_index) _index->flush(); return *this; }
+
+        /** Set time index policy
+         *
+         * If the file is opened, its index is started immediately. Otherwise policy is applied by the next #open call.
+         *
+         * \param[in] policy Time index policy
+         * \param[in] offset Current file size
+         */
+        void setIndex(const SIndexPolicy& policy, std::uintmax_t offset = 0);
+
+        /** Current file size
+         *
+         * \return Bytes amount in the file after opening
+         */
+        std::uintmax_t openedSize() const noexcept                          { return _openedSize; }
+
+        /** Register record in the time index
+         *
+         * \param[in] time Record time
+         * \param[in] offset Record offset in the file
+         */
+        void indexRecord(std::chrono::system_clock::time_point time, std::uintmax_t offset)    { if (_index) _index->record(time, offset); }
+
+        /** Duplicate file descriptor
+         *
+         * \return File descriptor duplicate to be closed by caller or -1 if it is not available
+         */
+        int duplicateFd() const noexcept
+        {
+#ifdef AVN_LOGGER_FILE_STREAM_FD
+            return _fd >= 0 ? ::dup(_fd) : -1;
+#else
+            return -1;
+#endif
+        }
+
+    private:
+        int _fd{-1};
+        std::filesystem::path _filename;
+        std::uintmax_t _openedSize{0};
+        SIndexPolicy _indexPolicy;
+        std::unique_ptr<ALoggerFileIndex> _index;
+
+        void closeFd() noexcept
+        {
+#ifdef AVN_LOGGER_FILE_STREAM_FD
+            if (_fd >= 0)
+                ::close(_fd);
+#endif
+            _fd = -1;
+        }
+    };
+
+    template<typename _TChar>
+    void ALoggerFileStream<_TChar>::open(const std::filesystem::path& filename, std::ios_base::openmode mode)
+    {
+        closeFd();
+        _index.reset();
+        TBase::open(filename, mode);
+
+        if (!TBase::is_open())
+            return;
+
+#ifdef AVN_LOGGER_FILE_STREAM_FD
+        _fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+
+        std::error_code ec;
+        const auto size{ (mode & std::ios_base::app) ? std::filesystem::file_size(filename, ec) : 0 };
+        _openedSize = ec ? 0 : size;
+        _filename = filename;
+
+        setIndex(_indexPolicy, _openedSize);
+    }
+
+    template<typename _TChar>
+    void ALoggerFileStream<_TChar>::setIndex(const SIndexPolicy& policy, std::uintmax_t offset)
+    {
+        _indexPolicy = policy;
+        _index.reset();
+
+        if (_indexPolicy.enabled() && TBase::is_open()) {
+            _index = std::make_unique<ALoggerFileIndex>(_indexPolicy);
+            _index->open(_filename, offset);
+        }
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_FILE_STREAM_H_
@@ -17,9 +17,22 @@
  * you enable some logger levels. After you output messages with logger level. Like this you can disable, say, debug
  * messages for normal operation mode.
  *
- * You can call \a flushFile to flush currently added logger message. Also you can call \a SetFlushAlways
- * to enable or disable instant flushing for each new logger message. Or you can specify specific logger levels to be flushed
- * instantly by \a setFlushlevels call. Flushing feature can be useful in debug mode.
+ * Messages are not flushed one by one. You can call \a flushFile to flush currently added logger message. Also you can call
+ * \a SetFlushAlways to enable or disable instant flushing for each new logger message. Or you can specify specific logger
+ * levels to be flushed instantly by \a setFlushlevels call. Flushing by size, by timer and fdatasync(2) group commit are
+ * configured by \a setFlushPolicy call, see #ALogger::ALoggerFlushPolicy class description.
+ *
+ * Output file can be rotated by size or by wall-clock interval, see #ALogger::ALoggerTxtFile::setRotation call and
+ * #ALogger::ALoggerFileRotation class description. Rotation does not stall message producers because next segment is
+ * pre-opened and old segments are renamed or deleted by the background thread.
+ *
+ * Sparse time index sidecar file can be written together with the output file, see #ALogger::ALoggerTxtFile::setIndex
+ * call and logger_file_index.h description. Index is rotated together with file segments. logger_query utility uses it
+ * to extract time range from the file with O(log n) seeks.
+ *
+ * File is always written as bytes. wchar_t, char16_t and char32_t messages are transcoded to UTF-8 by
+ * #ALogger::Utf8::append in bulk, so no std::basic_ofstream<wchar_t> and codecvt locale are needed. Offsets and sizes
+ * used by rotation and time index are byte ones.
  *
  * #ALogger::ALoggerTxtFile usage is obvious :
  *
@@ -28,9 +41,7 @@
     constexpr auto WARNING = 0;     // WARNING identifier
 
     ALogger::ALoggerTxtFile<true, wchar_t> logger(L"/tmp/test.txt"s);
-    const std::locale utf8_locale = locale(locale(), new codecvt_utf8<wchar_t>());
 
-    logger.imbue(utf8_locale);
     logger.addLevelDescr(WARNING, L"WARNING");
     logger.enableLevel(WARNING);
     logger.addString(WARNING, L"This is test string : integer = ", 10);
@@ -43,8 +54,14 @@
 
 #include <filesystem>
 #include <fstream>
+#include <memory>
 
 #include <avn/logger/logger_txt_base.h>
+#include <avn/logger/logger_file_index.h>
+#include <avn/logger/logger_file_rotation.h>
+#include <avn/logger/logger_file_stream.h>
+#include <avn/logger/logger_flush_policy.h>
+#include <avn/logger/logger_utf8.h>
 
 namespace ALogger {
 
@@ -65,14 +82,16 @@ namespace ALogger {
         /** String type for text logger messages */
         using TString = std::basic_string<_TChar>;
 
-        /** File stream type */
-        using TStream = std::basic_ofstream<_TChar>;
+        /** File stream type. Wide messages are written as UTF-8 bytes */
+        using TStream = ALoggerFileStream<char>;
 
         /** Default constructor
          *
          * \param[in] local_time Use local time instead of GMT one. True by default
          */
-        ALoggerTxtFile(bool local_time = true) noexcept : ALoggerTxtBase<_ThrSafe, _TChar>(local_time), _flushAlways(false)    {}
+        ALoggerTxtFile(bool local_time = true) noexcept :
+                ALoggerTxtBase<_ThrSafe, _TChar>(local_time), _fstream(std::make_unique<TStream>()),
+                _flush([this](bool datasync) { return flushStream(datasync); })    {}
 
         /** Constructor with output file configuration
          *
@@ -111,7 +130,7 @@ namespace ALogger {
          *
          * \return Current instance reference
          */
-        ALoggerTxtFile& openFile(const std::filesystem::path& filename, std::ios_base::openmode mode = std::ios_base::out) noexcept    { _fstream.open(filename, mode); return *this; }
+        ALoggerTxtFile& openFile(const std::filesystem::path& filename, std::ios_base::openmode mode = std::ios_base::out) noexcept;
 
 #ifdef QT_VERSION
         /** Open file
@@ -128,13 +147,48 @@ namespace ALogger {
          *
          * \return Current instance reference
          */
-        ALoggerTxtFile& closeFile() noexcept   { _fstream.close(); return *this; }
+        ALoggerTxtFile& closeFile() noexcept   { auto lock{ _flush.lock() }; _rotation.reset(); _fstream->close(); return *this; }
 
         /** Flush all output messages to the output file
          *
          * \return Current instance reference
          */
-        ALoggerTxtFile& flushFile() noexcept                                 { _fstream.flush(); return *this; }
+        ALoggerTxtFile& flushFile() noexcept                                 { auto lock{ _flush.lock() }; _fstream->flush(); _flush.flushed(); return *this; }
+
+        /** Set output file rotation policy
+         *
+         * Rotation starts immediately if the file is already opened. Otherwise it starts on #openFile call. Active segment
+         * always has the file name specified by #openFile, rotated segments have ".1", ".2" etc. suffixes, the newest
+         * one is ".1".
+         *
+         * \param[in] policy Rotation policy. Rotation is disabled if no criterion is specified
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtFile& setRotation(const SRotationPolicy& policy) noexcept;
+
+        /** Get output file rotation policy
+         *
+         * \return Rotation policy
+         */
+        const SRotationPolicy& rotation() const noexcept                    { return _rotationPolicy; }
+
+        /** Set time index policy
+         *
+         * Index sidecar file "<file>.idx" is started immediately if the file is already opened. Otherwise it is started
+         * on #openFile call.
+         *
+         * \param[in] policy Index policy. Index is disabled if no criterion is specified
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtFile& setIndex(const SIndexPolicy& policy) noexcept;
+
+        /** Get time index policy
+         *
+         * \return Index policy
+         */
+        const SIndexPolicy& index() const noexcept                          { return _indexPolicy; }
 
         /** Enable automatic flushing for specific message levels to the output file
          *
@@ -144,7 +198,7 @@ namespace ALogger {
          *
          * \return Current instance reference
          */
-        ALoggerTxtFile& setFlushLevels(const TLevels& levels) noexcept          { _flushLevels = levels; _flushAlways = false; return *this; }
+        ALoggerTxtFile& setFlushLevels(const TLevels& levels) noexcept;
 
         /** Enable or diable automatic flushing for all messages to the output file
          *
@@ -152,31 +206,51 @@ namespace ALogger {
          *
          * \return Current instance reference
          */
-        ALoggerTxtFile& SetFlushAlways(bool flush_always = true) noexcept  { _flushAlways = flush_always; return *this; }
+        ALoggerTxtFile& SetFlushAlways(bool flush_always = true) noexcept;
+
+        /** Set flush policy
+         *
+         * \param[in] policy Flush policy
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtFile& setFlushPolicy(const SFlushPolicy& policy) noexcept    { _flush.setPolicy(policy); return *this; }
+
+        /** Get flush policy engine
+         *
+         * \return Flush policy engine
+         */
+        const ALoggerFlushPolicy& flushPolicy() const noexcept              { return _flush; }
 
         /** Set the associated locale of the file stream to the given one
+         *
+         * Byte stream locale does not change the output encoding, wide messages are always written as UTF-8.
          *
          * \param[in] loc New locale to associate the stream to
          */
-        void imbue(const std::locale& loc) noexcept override               { _fstream.imbue(loc); }
+        void imbue(const std::locale& loc) noexcept override;
 
         /** Get output file stream
+         *
+         * \warning Active segment stream is changed after rotation
          *
          * \return Output file stream
          */
-        TStream& stream() noexcept                                         { return _fstream; }
+        TStream& stream() noexcept                                         { return *_fstream; }
 
         /** Check that output file is opened
          *
          * \return True if file is opened
          */
-        bool IsOpenedFile() const noexcept                                 { return _fstream.is_open(); }
+        bool IsOpenedFile() const noexcept                                 { return _fstream->is_open(); }
 
         /** Get output file stream
+         *
+         * \warning Active segment stream is changed after rotation
          *
          * \return Output file stream
          */
-        const TStream& stream() const noexcept                             { return _fstream; }
+        const TStream& stream() const noexcept                             { return *_fstream; }
 
         /** Get output file stream
          *
@@ -198,23 +272,142 @@ namespace ALogger {
 
     private:
         bool outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept override;
+        void commitData(std::size_t level) noexcept override                { _flush.commit(level); }
+        void startRotation() noexcept;
+        int flushStream(bool datasync) noexcept;
 
-        TStream _fstream;
-        TLevels _flushLevels;
-        bool _flushAlways;
+        TString _line;      // Reusable message buffer
+        std::string _bytes; // Reusable UTF-8 buffer for wide messages
+        std::unique_ptr<TStream> _fstream;
+
+        std::filesystem::path _filename;
+        std::uintmax_t _written{0};
+        SRotationPolicy _rotationPolicy;
+        std::unique_ptr<ALoggerFileRotation<TStream>> _rotation;
+        SIndexPolicy _indexPolicy;
+
+        ALoggerFlushPolicy _flush;
 
     };
 
     template<bool _ThrSafe, typename _TChar>
-    bool ALoggerTxtFile<_ThrSafe, _TChar>::outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept
+    ALoggerTxtFile<_ThrSafe, _TChar>& ALoggerTxtFile<_ThrSafe, _TChar>::setFlushLevels(const TLevels& levels) noexcept
     {
-        assert(_fstream.is_open());
+        auto policy{ _flush.policy() };
+        policy._levels = levels;
+        policy._always = false;
+        _flush.setPolicy(std::move(policy));
+        return *this;
+    }
 
-        if (_fstream.is_open()) {
-            _fstream << ALoggerTxtBase<_ThrSafe, _TChar>::prepareString(level, time, data) << std::endl;
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtFile<_ThrSafe, _TChar>& ALoggerTxtFile<_ThrSafe, _TChar>::SetFlushAlways(bool flush_always) noexcept
+    {
+        auto policy{ _flush.policy() };
+        policy._always = flush_always;
+        _flush.setPolicy(std::move(policy));
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    int ALoggerTxtFile<_ThrSafe, _TChar>::flushStream(bool datasync) noexcept
+    {
+        _fstream->flush();
+        return datasync ? _fstream->duplicateFd() : -1;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtFile<_ThrSafe, _TChar>& ALoggerTxtFile<_ThrSafe, _TChar>::openFile(const std::filesystem::path& filename, std::ios_base::openmode mode) noexcept
+    {
+        auto lock{ _flush.lock() };
+
+        _rotation.reset();
+
+        _fstream->open(filename, mode);
+        _filename = filename;
+        _written = _fstream->openedSize();
+
+        startRotation();
+        return *this;
+    }
 
-            if (_flushAlways || _flushLevels.find(level) != _flushLevels.cend())
-                _fstream.flush();
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtFile<_ThrSafe, _TChar>& ALoggerTxtFile<_ThrSafe, _TChar>::setRotation(const SRotationPolicy& policy) noexcept
+    {
+        // Rotation is used by the output under the lock
+        auto lock{ _flush.lock() };
+
+        _rotation.reset();
+        _rotationPolicy = policy;
+        startRotation();
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtFile<_ThrSafe, _TChar>& ALoggerTxtFile<_ThrSafe, _TChar>::setIndex(const SIndexPolicy& policy) noexcept
+    {
+        auto lock{ _flush.lock() };
+
+        _rotation.reset();
+        _indexPolicy = policy;
+        _fstream->setIndex(policy, _written);
+        startRotation();
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtFile<_ThrSafe, _TChar>::startRotation() noexcept
+    {
+        if (!_rotationPolicy.enabled() || !_fstream->is_open())
+            return;
+
+        if (_indexPolicy.enabled())
+            _rotation = std::make_unique<ALoggerFileRotation<TStream>>(_filename, _rotationPolicy, _fstream->getloc(),
+                    [policy = _indexPolicy](TStream& stream) { stream.setIndex(policy); }, std::vector<std::string>{ ALoggerFileIndex::Suffix });
+        else
+            _rotation = std::make_unique<ALoggerFileRotation<TStream>>(_filename, _rotationPolicy, _fstream->getloc());
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtFile<_ThrSafe, _TChar>::imbue(const std::locale& loc) noexcept
+    {
+        _fstream->imbue(loc);
+        if (_rotation)
+            _rotation->imbue(loc);
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    bool ALoggerTxtFile<_ThrSafe, _TChar>::outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept
+    {
+        assert(_fstream->is_open());
+
+        auto lock{ _flush.lock() };
+
+        if (_rotation && _rotation->rotationDue(_written, time) && _rotation->rotate(_fstream, time))
+            _written = 0;
+
+        if (_fstream->is_open()) {
+            auto& str{ _line };
+            str.clear();
+            ALoggerTxtBase<_ThrSafe, _TChar>::prepareString(str, level, time, data);
+            const std::string* bytes;
+
+            if constexpr (std::is_same_v<_TChar, char>)
+                bytes = &str;
+            else {
+                _bytes.clear();
+                Utf8::append(_bytes, str);
+                bytes = &_bytes;
+            }
+
+            _fstream->indexRecord(time, _written);
+            _fstream->write(bytes->data(), static_cast<std::streamsize>(bytes->size())).put('\n');
+            _written += bytes->size() + 1;
+
+            if (_flush.written(level, bytes->size() + 1)) {
+                _fstream->flush();
+                _flush.flushed();
+            }
 
             return true;
         }
@@ -0,0 +1,341 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_txt_json_file.h
+ * \brief ALoggerTxtJsonFile class implements structured logging to a file.
+ *
+ * As #ALogger::ALoggerBase child this class has features listed below :
+ * - multithreading or single thread mode.
+ * - enable or disable logger levels. If current output message has level that is enabled now, it will be output. Also it
+ * is possible to output regardless of current logger level by using #forceAddToLog call.
+ * - add logger tasks and automatically finish them.
+ *
+ * Each record is written as one line in JSON or logfmt format, see #ALogger::EStructFormat. Record has timestamp in
+ * RFC 3339 format, level description, thread identifier, message, thread context fields, see logger_context.h,
+ * and record fields added by #ALogger::ALoggerTxtBase::addFields call. Fields are written as native JSON values,
+ * durations are written in seconds :
+ *
+ * \code{.unparsed}
+    {"time":"2020-01-01T00:00:00.000000Z","level":"INFO","thread":1234,"message":"Text","status":200}
+    time=2020-01-01T00:00:00.000000Z level=INFO thread=1234 message=Text status=200
+ * \endcode
+ *
+ * Strings are escaped by #ALogger::JsonEscape functions. Layout, level prefix and postfix settings do not affect
+ * output. Flushing is configured by \a setFlushPolicy call, see #ALogger::ALoggerFlushPolicy class description.
+ *
+ * \code
+
+    constexpr auto WARNING = 0;     // WARNING identifier
+
+    ALogger::ALoggerTxtJsonFile<true, char> logger("/tmp/test.json"s);
+
+    logger.addLevelDescr(WARNING, "WARNING");
+    logger.enableLevel(WARNING);
+    logger.addString(WARNING, "This is test string : integer = ", 10);
+
+ * \endcode
+ *
+ * \warning Message bytes are expected to be UTF-8. They are not validated.
+ */
+
+#ifndef _AVN_LOGGER_TXT_JSON_FILE_H_
+#define _AVN_LOGGER_TXT_JSON_FILE_H_
+
+#include <cmath>
+#include <filesystem>
+#include <memory>
+
+#include <avn/logger/logger_txt_base.h>
+#include <avn/logger/logger_fields.h>
+#include <avn/logger/logger_file_stream.h>
+#include <avn/logger/logger_flush_policy.h>
+#include <avn/logger/logger_json_escape.h>
+#include <avn/logger/logger_layout.h>
+
+namespace ALogger {
+
+    /** Structured record format */
+    enum class EStructFormat {
+        JSON,       ///< One JSON object per line
+        LOGFMT      ///< One logfmt line of key=value pairs per record
+    };
+
+    /** Structured text file logger
+     *
+     * \tparam _ThrSafe Thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated.
+     * \tparam _TChar Character type. Only char is currently supported.
+     */
+    template<bool _ThrSafe, typename _TChar>
+    class ALoggerTxtJsonFile : public ALoggerTxtBase<_ThrSafe, _TChar> {
+    public:
+        /** Current thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated */
+        constexpr static bool ThrSafe{ _ThrSafe };
+
+        /** Character type for text logger messages */
+        using TChar = _TChar;
+
+        static_assert(std::is_same_v<TChar, char>, "Only char is currently supported by structured file logger");
+
+        /** String type for text logger messages */
+        using TString = std::basic_string<_TChar>;
+
+        /** File stream type */
+        using TStream = ALoggerFileStream<char>;
+
+        /** Default constructor
+         *
+         * \param[in] local_time Use local time instead of GMT one. True by default
+         */
+        ALoggerTxtJsonFile(bool local_time = true) noexcept;
+
+        /** Constructor with output file configuration
+         *
+         * #openFile is called after object construction
+         *
+         * \param[in] filename Output file name and path
+         * \param[in] format Record format. JSON by default
+         * \param[in] mode File mode as std::ios_base::openmode mask. std::ios_base::out by default
+         * \param[in] local_time Use local time instead of GMT one. True by default
+         */
+        ALoggerTxtJsonFile(const std::filesystem::path& filename, EStructFormat format = EStructFormat::JSON,
+                           std::ios_base::openmode mode = std::ios_base::out, bool local_time = true) noexcept :
+                ALoggerTxtJsonFile(local_time)
+        {
+            _format = format;
+            openFile(filename, mode);
+        }
+
+        ALoggerTxtJsonFile(const ALoggerTxtJsonFile&) = delete;
+
+        ~ALoggerTxtJsonFile() noexcept override                            { closeFile(); }
+
+        /** Open file
+         *
+         * \param[in] filename Output file name and path
+         * \param[in] mode File mode as std::ios_base::openmode mask. std::ios_base::out by default
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtJsonFile& openFile(const std::filesystem::path& filename, std::ios_base::openmode mode = std::ios_base::out) noexcept
+                                                                            { auto lock{ _flush.lock() }; _fstream->open(filename, mode | std::ios_base::binary); return *this; }
+
+        /** Close currently opened file
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtJsonFile& closeFile() noexcept                            { auto lock{ _flush.lock() }; _fstream->close(); return *this; }
+
+        /** Flush all output records to the output file
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtJsonFile& flushFile() noexcept                            { auto lock{ _flush.lock() }; _fstream->flush(); _flush.flushed(); return *this; }
+
+        /** Set record format
+         *
+         * \param[in] format Record format
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtJsonFile& setFormat(EStructFormat format) noexcept        { auto lock{ _flush.lock() }; _format = format; return *this; }
+
+        /** Get record format
+         *
+         * \return Record format
+         */
+        EStructFormat format() const noexcept                               { return _format; }
+
+        /** Set flush policy
+         *
+         * \param[in] policy Flush policy
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtJsonFile& setFlushPolicy(const SFlushPolicy& policy) noexcept    { _flush.setPolicy(policy); return *this; }
+
+        /** Get flush policy engine
+         *
+         * \return Flush policy engine
+         */
+        const ALoggerFlushPolicy& flushPolicy() const noexcept              { return _flush; }
+
+        /** Check that output file is opened
+         *
+         * \return True if file is opened
+         */
+        bool IsOpenedFile() const noexcept                                 { return _fstream->is_open(); }
+
+        /** Check that output file is opened
+         *
+         * \return True if file is opened
+         */
+        operator bool () const noexcept                                    { return IsOpenedFile(); }
+
+    private:
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept override;
+        void commitData(std::size_t level) noexcept override                { _flush.commit(level); }
+        int flushStream(bool datasync) noexcept;
+
+        void beginRecord() noexcept;
+        void appendKey(const char* key, std::size_t size) noexcept;
+        void appendString(const char* key, std::size_t size, std::string_view value) noexcept;
+        void appendNumber(const char* key, std::size_t size, unsigned long value) noexcept;
+        void appendField(const SFieldValue& value) noexcept;
+        void endRecord() noexcept;
+
+        std::string _line;      // Reusable record buffer
+        std::unique_ptr<TStream> _fstream;
+        EStructFormat _format{ EStructFormat::JSON };
+        ALoggerLayout<char> _timeLayout;
+        bool _first{true};
+
+        ALoggerFlushPolicy _flush;
+    };
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtJsonFile<_ThrSafe, _TChar>::ALoggerTxtJsonFile(bool local_time) noexcept :
+            ALoggerTxtBase<_ThrSafe, _TChar>(local_time),
+            _fstream(std::make_unique<TStream>()),
+            _timeLayout(local_time),
+            _flush([this](bool datasync) { return flushStream(datasync); })
+    {
+        _timeLayout.compile(local_time ? "%FT%T.%f%z" : "%FT%T.%fZ");
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    int ALoggerTxtJsonFile<_ThrSafe, _TChar>::flushStream(bool datasync) noexcept
+    {
+        _fstream->flush();
+        return datasync ? _fstream->duplicateFd() : -1;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtJsonFile<_ThrSafe, _TChar>::beginRecord() noexcept
+    {
+        _line.clear();
+        _first = true;
+
+        if (_format == EStructFormat::JSON)
+            _line.push_back('{');
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtJsonFile<_ThrSafe, _TChar>::appendKey(const char* key, std::size_t size) noexcept
+    {
+        if (!_first)
+            _line.push_back(_format == EStructFormat::JSON ? ',' : ' ');
+        _first = false;
+
+        if (_format == EStructFormat::JSON) {
+            JsonEscape::appendQuoted(_line, std::string_view(key, size));
+            _line.push_back(':');
+        } else {
+            JsonEscape::appendLogfmtKey(_line, std::string_view(key, size));
+            _line.push_back('=');
+        }
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtJsonFile<_ThrSafe, _TChar>::appendString(const char* key, std::size_t size, std::string_view value) noexcept
+    {
+        appendKey(key, size);
+
+        if (_format == EStructFormat::JSON)
+            JsonEscape::appendQuoted(_line, value);
+        else
+            JsonEscape::appendLogfmt(_line, value);
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtJsonFile<_ThrSafe, _TChar>::appendNumber(const char* key, std::size_t size, unsigned long value) noexcept
+    {
+        appendKey(key, size);
+
+        char buffer[24];
+        const auto res{ std::to_chars(buffer, buffer + sizeof(buffer), value) };
+        _line.append(buffer, res.ptr);
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtJsonFile<_ThrSafe, _TChar>::appendField(const SFieldValue& value) noexcept
+    {
+        if (value._type == EFieldType::STRING) {
+            appendString(value._key.data(), value._key.size(), value._string);
+            return;
+        }
+
+        appendKey(value._key.data(), value._key.size());
+
+        switch (value._type) {
+        case EFieldType::INT :      Fields::appendNumber(_line, value._int); break;
+        case EFieldType::UINT :     Fields::appendNumber(_line, value._uint); break;
+        case EFieldType::BOOL :     _line.append(value._int != 0 ? "true" : "false"); break;
+        case EFieldType::DOUBLE :
+        case EFieldType::DURATION : {
+            const auto number{ value._type == EFieldType::DOUBLE ? value._double : Fields::seconds(value) };
+            // JSON has no infinity and NaN values
+            if (std::isfinite(number))
+                Fields::appendNumber(_line, number);
+            else
+                _line.append("null");
+            break;
+        }
+        default :
+            break;
+        }
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtJsonFile<_ThrSafe, _TChar>::endRecord() noexcept
+    {
+        if (_format == EStructFormat::JSON)
+            _line.push_back('}');
+        _line.push_back('\n');
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    bool ALoggerTxtJsonFile<_ThrSafe, _TChar>::outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept
+    {
+        assert(_fstream->is_open());
+
+        auto lock{ _flush.lock() };
+
+        if (!_fstream->is_open())
+            return false;
+
+        beginRecord();
+
+        // Timestamp does not contain special characters, so it is written without escaping
+        appendKey("time", 4);
+        if (_format == EStructFormat::JSON)
+            _line.push_back('"');
+        _timeLayout.format(_line, {}, time, {});
+        // strftime writes the local time offset as "+hhmm", RFC 3339 requires "+hh:mm"
+        if (const auto sign{ _line.size() >= 5 ? _line[_line.size() - 5] : '\0' }; sign == '+' || sign == '-')
+            _line.insert(_line.size() - 2, 1, ':');
+        if (_format == EStructFormat::JSON)
+            _line.push_back('"');
+
+        appendString("level", 5, ALoggerTxtBase<_ThrSafe, _TChar>::levelName(level));
+        appendNumber("thread", 6, ALoggerLayout<char>::threadId());
+        appendString("message", 7, data);
+        const auto append_field = [this](const SFieldValue& value) { appendField(value); };
+        if (const auto* context{ ALoggerTxtBase<_ThrSafe, _TChar>::recordContext() })
+            Fields::forEach(context->_fields, append_field);
+        Fields::forEach(ALoggerTxtBase<_ThrSafe, _TChar>::recordFields(), append_field);
+
+        endRecord();
+
+        _fstream->write(_line.data(), static_cast<std::streamsize>(_line.size()));
+
+        if (_flush.written(level, _line.size())) {
+            _fstream->flush();
+            _flush.flushed();
+        }
+
+        return true;
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_TXT_JSON_FILE_H_
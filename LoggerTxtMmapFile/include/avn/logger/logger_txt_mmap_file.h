@@ -0,0 +1,393 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_txt_mmap_file.h
+ * \brief ALoggerTxtMmapFile class implements text logging to a memory-mapped file.
+ *
+ * As #ALogger::ALoggerBase child this class has features listed below :
+ * - multithreading or single thread mode.
+ * - enable or disable logger levels. If current output message has level that is enabled now, it will be output. Also it
+ * is possible to output regardless of current logger level by using #forceAddToLog call.
+ * - add logger tasks and automatically finish them.
+ *
+ * Unlike #ALogger::ALoggerTxtFile this class does not use file streams. Output file is extended by large pre-allocated
+ * segments that are mapped into memory. Messages are formatted directly into mapped memory, so there is no intermediate
+ * buffer copy and no write(2) call per flush. When current segment is filled, it is unmapped, the file is truncated to
+ * its used size and the next segment is allocated and mapped. At file closing the file is truncated to its used size
+ * too. After a crash the file tail can stay filled by zero bytes of the pre-allocated segment, this tail is cut off
+ * when the file is opened for appending.
+ *
+ * Mapped memory is written to the disk by the operating system. You can tune durability by #ALogger::ALoggerTxtMmapFile::setMsync
+ * call :
+ * - #ALogger::EMsync::NONE : the operating system decides when to write data ;
+ * - #ALogger::EMsync::SEGMENT : asynchronous msync(2) is scheduled for each segment before unmapping, so the logging
+ * thread does not wait for the disk. The last segment is synchronized at file closing. This is the default mode ;
+ * - #ALogger::EMsync::ASYNC : asynchronous msync(2) is scheduled after specified bytes amount ;
+ * - #ALogger::EMsync::SYNC : synchronous msync(2) is called after specified bytes amount.
+ *
+ * Also you can specify levels to be synchronized instantly by #ALogger::ALoggerTxtMmapFile::setMsyncLevels call.
+ *
+ * \code
+
+    constexpr auto WARNING = 0;     // WARNING identifier
+
+    ALogger::ALoggerTxtMmapFile<true, char> logger("/tmp/test.txt"s);
+
+    logger.addLevelDescr(WARNING, "WARNING");
+    logger.enableLevel(WARNING);
+    logger.addString(WARNING, "This is test string : integer = ", 10);
+
+ * \endcode
+ *
+ * \warning Only POSIX systems are supported.
+ */
+
+#ifndef _AVN_LOGGER_TXT_MMAP_FILE_H_
+#define _AVN_LOGGER_TXT_MMAP_FILE_H_
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <avn/logger/logger_txt_base.h>
+
+namespace ALogger {
+
+    /** Mapped memory synchronization mode */
+    enum class EMsync {
+        NONE,       ///< Data is written by the operating system
+        SEGMENT,    ///< Asynchronous msync(2) before segment unmapping
+        ASYNC,      ///< Asynchronous msync(2) after specified bytes amount
+        SYNC        ///< Synchronous msync(2) after specified bytes amount
+    };
+
+    /** Memory-mapped text file logger
+     *
+     * \tparam _ThrSafe Thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated.
+     * \tparam _TChar Character type. Only char is currently supported.
+     */
+    template<bool _ThrSafe, typename _TChar>
+    class ALoggerTxtMmapFile : public ALoggerTxtBase<_ThrSafe, _TChar> {
+    public:
+        /** Current thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated */
+        constexpr static bool ThrSafe{ _ThrSafe };
+
+        /** Character type for text logger messages */
+        using TChar = _TChar;
+
+        static_assert(std::is_same_v<TChar, char>, "Only char is currently supported by memory-mapped file logger");
+
+        /** String type for text logger messages */
+        using TString = std::basic_string<_TChar>;
+
+        /** Default segment size */
+        constexpr static std::size_t DefaultSegmentSize{ 16 * 1024 * 1024 };
+
+        /** Default constructor
+         *
+         * \param[in] local_time Use local time instead of GMT one. True by default
+         */
+        ALoggerTxtMmapFile(bool local_time = true) noexcept : ALoggerTxtBase<_ThrSafe, _TChar>(local_time)    {}
+
+        /** Constructor with output file configuration
+         *
+         * #openFile is called after object construction
+         *
+         * \param[in] filename Output file name and path
+         * \param[in] append Append messages to the existing file. False by default
+         * \param[in] local_time Use local time instead of GMT one. True by default
+         */
+        ALoggerTxtMmapFile(const std::filesystem::path& filename, bool append = false, bool local_time = true) noexcept :
+                ALoggerTxtMmapFile(local_time)
+        {
+            openFile(filename, append);
+        }
+
+        ALoggerTxtMmapFile(const ALoggerTxtMmapFile&) = delete;
+
+        ~ALoggerTxtMmapFile() noexcept override { closeFile(); }
+
+        /** Open file
+         *
+         * \param[in] filename Output file name and path
+         * \param[in] append Append messages to the existing file. False by default
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtMmapFile& openFile(const std::filesystem::path& filename, bool append = false) noexcept;
+
+        /** Close currently opened file
+         *
+         * Current segment is unmapped and file is truncated to its used size.
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtMmapFile& closeFile() noexcept;
+
+        /** Synchronize all output messages with the output file
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtMmapFile& flushFile() noexcept                             { std::lock_guard<std::mutex> lock(_mutex); msyncRange(MS_SYNC); return *this; }
+
+        /** Set segment size
+         *
+         * New size is used for the next segment allocation. It is rounded up to the memory page size.
+         *
+         * \param[in] size Segment size in bytes
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtMmapFile& setSegmentSize(std::size_t size) noexcept        { std::lock_guard<std::mutex> lock(_mutex); _segmentSize = std::max<std::size_t>(size, 1); return *this; }
+
+        /** Set mapped memory synchronization policy
+         *
+         * \param[in] mode Synchronization mode
+         * \param[in] bytes Bytes amount between msync(2) calls for #ALogger::EMsync::ASYNC and #ALogger::EMsync::SYNC
+         * modes. Zero means each message
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtMmapFile& setMsync(EMsync mode, std::size_t bytes = 0) noexcept  { std::lock_guard<std::mutex> lock(_mutex); _msync = mode; _msyncBytes = bytes; return *this; }
+
+        /** Set levels to be synchronized instantly by synchronous msync(2)
+         *
+         * \param[in] levels Levels list
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtMmapFile& setMsyncLevels(const TLevels& levels) noexcept   { std::lock_guard<std::mutex> lock(_mutex); _msyncLevels = levels; return *this; }
+
+        /** Check that output file is opened
+         *
+         * \return True if file is opened
+         */
+        bool IsOpenedFile() const noexcept                                 { return _fd >= 0; }
+
+        /** Check that output file is opened
+         *
+         * \return True if file is opened
+         */
+        operator bool () const noexcept                                    { return IsOpenedFile(); }
+
+        /** Get used file size
+         *
+         * \return Bytes amount written
+         */
+        std::size_t fileSize() const noexcept                              { return _used; }
+
+    private:
+        // Output buffer that formats the message directly into the mapped segment. Message that does not fit is cut
+        struct SMappedLine {
+            char* _pos;
+            char* _end;
+            bool _overflow{false};
+
+            void append(const char* str, std::size_t size) noexcept;
+            void push_back(char ch) noexcept                                { append(&ch, 1); }
+        };
+
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept override;
+        void close() noexcept;
+        bool mapSegment(std::size_t required) noexcept;
+        void unmapSegment(int flags) noexcept;
+        void msyncRange(int flags) noexcept;
+        static std::size_t usedSize(int fd, std::size_t size) noexcept;
+
+        std::mutex _mutex;  // Output lock, it guards the mapping against flushes and configuration calls
+        TString _line;      // Message buffer for the records that do not fit the current segment
+        int _fd{-1};
+        char* _map{nullptr};
+        std::size_t _mapOffset{0};      // File offset of the mapped segment, page aligned
+        std::size_t _mapSize{0};
+        std::size_t _used{0};           // Bytes written to the file
+        std::size_t _synced{0};         // File offset of the first not synchronized byte
+        std::size_t _segmentSize{DefaultSegmentSize};
+
+        EMsync _msync{EMsync::SEGMENT};
+        std::size_t _msyncBytes{0};
+        TLevels _msyncLevels;
+
+        static std::size_t pageSize() noexcept { static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)); return size; }
+    };
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtMmapFile<_ThrSafe, _TChar>::SMappedLine::append(const char* str, std::size_t size) noexcept
+    {
+        if (static_cast<std::size_t>(_end - _pos) < size) {
+            _overflow = true;
+            _pos = _end;
+            return;
+        }
+
+        std::memcpy(_pos, str, size);
+        _pos += size;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtMmapFile<_ThrSafe, _TChar>& ALoggerTxtMmapFile<_ThrSafe, _TChar>::openFile(const std::filesystem::path& filename, bool append) noexcept
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        close();
+
+        _fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (append ? 0 : O_TRUNC), 0644);
+        if (_fd < 0)
+            return *this;
+
+        struct stat st{};
+        _used = ::fstat(_fd, &st) == 0 ? usedSize(_fd, static_cast<std::size_t>(st.st_size)) : 0;
+        _synced = _used;
+
+        if (!mapSegment(0)) {
+            ::close(_fd);
+            _fd = -1;
+        }
+
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtMmapFile<_ThrSafe, _TChar>& ALoggerTxtMmapFile<_ThrSafe, _TChar>::closeFile() noexcept
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        close();
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtMmapFile<_ThrSafe, _TChar>::close() noexcept
+    {
+        if (_fd < 0)
+            return;
+
+        unmapSegment(MS_SYNC);
+        [[maybe_unused]] const auto res{ ::ftruncate(_fd, static_cast<off_t>(_used)) };
+        ::close(_fd);
+        _fd = -1;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    /* static */ std::size_t ALoggerTxtMmapFile<_ThrSafe, _TChar>::usedSize(int fd, std::size_t size) noexcept
+    {
+        // Messages never contain zero bytes, so zero tail is the unused part of the segment left by a crash
+        char buffer[4096];
+
+        while (size != 0) {
+            const auto block{ std::min(size, sizeof(buffer)) };
+            if (::pread(fd, buffer, block, static_cast<off_t>(size - block)) != static_cast<ssize_t>(block))
+                break;
+
+            const auto* end{ buffer + block };
+            while (end != buffer && end[-1] == 0)
+                --end;
+
+            if (end != buffer)
+                return size - block + static_cast<std::size_t>(end - buffer);
+            size -= block;
+        }
+
+        return size;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    bool ALoggerTxtMmapFile<_ThrSafe, _TChar>::mapSegment(std::size_t required) noexcept
+    {
+        const auto page{ pageSize() };
+        const auto offset{ _used / page * page };
+        const auto size{ ((_used - offset) + std::max(_segmentSize, required) + page - 1) / page * page };
+
+#ifdef __linux__
+        if (::fallocate(_fd, 0, static_cast<off_t>(offset), static_cast<off_t>(size)) != 0)
+#endif
+            if (::ftruncate(_fd, static_cast<off_t>(offset + size)) != 0)
+                return false;
+
+        void* map{ ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, static_cast<off_t>(offset)) };
+        if (map == MAP_FAILED)
+            return false;
+
+        _map = static_cast<char*>(map);
+        _mapOffset = offset;
+        _mapSize = size;
+        return true;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtMmapFile<_ThrSafe, _TChar>::unmapSegment(int flags) noexcept
+    {
+        if (!_map)
+            return;
+
+        if (_msync != EMsync::NONE)
+            msyncRange(flags);
+
+        ::munmap(_map, _mapSize);
+        _map = nullptr;
+        _mapSize = 0;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtMmapFile<_ThrSafe, _TChar>::msyncRange(int flags) noexcept
+    {
+        if (!_map || _synced >= _used)
+            return;
+
+        const auto page{ pageSize() };
+        const auto from{ std::max(_synced, _mapOffset) / page * page };
+        ::msync(_map + (from - _mapOffset), _used - from, flags);
+        _synced = _used;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    bool ALoggerTxtMmapFile<_ThrSafe, _TChar>::outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept
+    {
+        assert(_fd >= 0);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_fd < 0)
+            return false;
+
+        SMappedLine line{ _map + (_used - _mapOffset), _map + _mapSize };
+        ALoggerTxtBase<_ThrSafe, _TChar>::prepareString(line, level, time, data);
+        line.push_back('\n');
+
+        if (!line._overflow) {
+            _used = _mapOffset + static_cast<std::size_t>(line._pos - _map);
+        } else {
+            // Message does not fit the current segment, it is formatted once more to get its size. Its cut part in
+            // the old segment is removed by the truncation
+            auto& str{ _line };
+            str.clear();
+            ALoggerTxtBase<_ThrSafe, _TChar>::prepareString(str, level, time, data);
+            str.push_back('\n');
+
+            unmapSegment(MS_ASYNC);
+            if (::ftruncate(_fd, static_cast<off_t>(_used)) != 0 || !mapSegment(str.size())) {
+                close();
+                return false;
+            }
+
+            std::memcpy(_map + (_used - _mapOffset), str.data(), str.size());
+            _used += str.size();
+        }
+
+        if (_msyncLevels.count(level))
+            msyncRange(MS_SYNC);
+        else if ((_msync == EMsync::ASYNC || _msync == EMsync::SYNC) && _used - _synced >= _msyncBytes)
+            msyncRange(_msync == EMsync::SYNC ? MS_SYNC : MS_ASYNC);
+
+        return true;
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_TXT_MMAP_FILE_H_
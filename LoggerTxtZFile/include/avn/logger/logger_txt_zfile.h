@@ -0,0 +1,413 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_txt_zfile.h
+ * \brief ALoggerTxtZFile class implements text logging to a compressed file.
+ *
+ * As #ALogger::ALoggerBase child this class has features listed below :
+ * - multithreading or single thread mode.
+ * - enable or disable logger levels. If current output message has level that is enabled now, it will be output. Also it
+ * is possible to output regardless of current logger level by using #forceAddToLog call.
+ * - add logger tasks and automatically finish them.
+ *
+ * Messages are collected into the block of #ALogger::SZFileOptions::_blockSize bytes. Filled block is handed to the
+ * background thread that compresses it by zlib and writes it to the file. Blocks are independent, each one has a header
+ * with records amount and records time range, see logger_zblock.h for the format description. Compressed file can be
+ * read by #ALogger::ALoggerZBlockReader class or by logger_zread utility.
+ *
+ * Message producer does not wait for the background thread. If #ALogger::SZFileOptions::_pending blocks are already
+ * waiting for compression, the current block keeps collecting messages and it is handed over at the next message.
+ * Producer waits only if the current block grows up to the size of all pending blocks.
+ *
+ * Blocks are written to the file without flushing. The file is flushed according to the flush policy, see
+ * #ALogger::ALoggerTxtZFile::setFlushPolicy call. Each flush finishes the current block.
+ *
+ * \code
+
+    constexpr auto WARNING = 0;     // WARNING identifier
+
+    ALogger::ALoggerTxtZFile<true, char> logger("/tmp/test.azl"s);
+
+    logger.addLevelDescr(WARNING, "WARNING");
+    logger.enableLevel(WARNING);
+    logger.addString(WARNING, "This is test string : integer = ", 10);
+
+ * \endcode
+ */
+
+#ifndef _AVN_LOGGER_TXT_ZFILE_H_
+#define _AVN_LOGGER_TXT_ZFILE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include <avn/logger/logger_flush_policy.h>
+#include <avn/logger/logger_txt_base.h>
+#include <avn/logger/logger_zblock.h>
+
+namespace ALogger {
+
+    /** Compressed file options */
+    struct SZFileOptions {
+        std::size_t _blockSize{ 1024 * 1024 };      ///< Decompressed block size
+        int _level{ Z_DEFAULT_COMPRESSION };         ///< zlib compression level
+        std::size_t _pending{4};                    ///< Maximum blocks amount waiting for compression
+    };
+
+    /** Compressed text file logger
+     *
+     * \tparam _ThrSafe Thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated.
+     * \tparam _TChar Character type. Only char is currently supported.
+     */
+    template<bool _ThrSafe, typename _TChar>
+    class ALoggerTxtZFile : public ALoggerTxtBase<_ThrSafe, _TChar> {
+    public:
+        /** Current thread security mode. If true, multithread mode will be used. Otherwise single ther will be activated */
+        constexpr static bool ThrSafe{ _ThrSafe };
+
+        /** Character type for text logger messages */
+        using TChar = _TChar;
+
+        static_assert(std::is_same_v<TChar, char>, "Only char is currently supported by compressed file logger");
+
+        /** String type for text logger messages */
+        using TString = std::basic_string<_TChar>;
+
+        /** Default constructor
+         *
+         * \param[in] local_time Use local time instead of GMT one. True by default
+         */
+        ALoggerTxtZFile(bool local_time = true) noexcept :
+                ALoggerTxtBase<_ThrSafe, _TChar>(local_time),
+                _flush([this](bool) { flushBlock(); return -1; })    {}
+
+        /** Constructor with output file configuration
+         *
+         * #openFile is called after object construction
+         *
+         * \param[in] filename Output file name and path
+         * \param[in] append Append blocks to the existing file. False by default
+         * \param[in] options Compressed file options
+         * \param[in] local_time Use local time instead of GMT one. True by default
+         */
+        ALoggerTxtZFile(const std::filesystem::path& filename, bool append = false, const SZFileOptions& options = {}, bool local_time = true) noexcept :
+                ALoggerTxtZFile(local_time)
+        {
+            openFile(filename, append, options);
+        }
+
+        ALoggerTxtZFile(const ALoggerTxtZFile&) = delete;
+
+        ~ALoggerTxtZFile() noexcept override { closeFile(); }
+
+        /** Open file
+         *
+         * \param[in] filename Output file name and path
+         * \param[in] append Append blocks to the existing file. False by default
+         * \param[in] options Compressed file options
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtZFile& openFile(const std::filesystem::path& filename, bool append = false, const SZFileOptions& options = {}) noexcept;
+
+        /** Close currently opened file
+         *
+         * Current block is compressed and all blocks are written.
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtZFile& closeFile() noexcept;
+
+        /** Compress current block and write all blocks to the file
+         *
+         * Each call finishes current block, so frequent calls decrease compression ratio.
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtZFile& flushFile() noexcept;
+
+        /** Set flush policy
+         *
+         * Flush hands the current block to the background thread that flushes the file after writing it. Flush does not
+         * wait for compression. fdatasync(2) option is not supported and is ignored.
+         *
+         * \param[in] policy Flush policy
+         *
+         * \return Current instance reference
+         */
+        ALoggerTxtZFile& setFlushPolicy(const SFlushPolicy& policy) noexcept { _flush.setPolicy(policy); return *this; }
+
+        /** Get flush policy engine
+         *
+         * \return Flush policy engine
+         */
+        const ALoggerFlushPolicy& flushPolicy() const noexcept              { return _flush; }
+
+        /** Check that output file is opened
+         *
+         * \return True if file is opened
+         */
+        bool IsOpenedFile() const noexcept                                 { return _file.is_open(); }
+
+        /** Check that output file is opened
+         *
+         * \return True if file is opened
+         */
+        operator bool () const noexcept                                    { return IsOpenedFile(); }
+
+        /** Written blocks amount
+         *
+         * \return Written blocks amount
+         */
+        std::size_t blocks() const noexcept                                { return _blocks; }
+
+        /** Lost blocks amount
+         *
+         * Block is lost if it can not be compressed or written. Its records are not in the file.
+         *
+         * \return Lost blocks amount
+         */
+        std::size_t errors() const noexcept                                { return _errors; }
+
+    private:
+        struct SBlock {
+            SZBlockHeader _header;
+            std::string _data;
+        };
+
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept override;
+        bool submit(bool wait) noexcept;
+        bool flushBlock() noexcept;
+        bool flushDue() const noexcept                                      { return _flushTarget != 0 && _processed >= _flushTarget; }
+        void worker() noexcept;
+
+        TString _line;      // Reusable message buffer
+        std::ofstream _file;
+        SZFileOptions _options;
+        SBlock _current;    // It is guarded by the output lock of the flush policy engine
+
+        std::mutex _mutex;  // Queue lock
+        std::condition_variable _cv;
+        std::condition_variable _cvDone;
+        std::deque<SBlock> _queue;
+        std::size_t _submitted{0};      // Blocks handed to the background thread
+        std::size_t _processed{0};      // Blocks written or lost by the background thread
+        std::size_t _flushTarget{0};    // File is flushed when this amount of blocks is processed. Zero if not requested
+        bool _stop{false};
+        std::atomic<std::size_t> _blocks{0};
+        std::atomic<std::size_t> _errors{0};
+        std::thread _thread;
+        ALoggerFlushPolicy _flush;      // The last member, so its thread is stopped first
+    };
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtZFile<_ThrSafe, _TChar>& ALoggerTxtZFile<_ThrSafe, _TChar>::openFile(const std::filesystem::path& filename, bool append, const SZFileOptions& options) noexcept
+    {
+        closeFile();
+
+        auto lock{ _flush.lock() };
+
+        _file.open(filename, std::ios_base::binary | (append ? std::ios_base::app : std::ios_base::trunc));
+        if (!_file.is_open())
+            return *this;
+
+        _options = options;
+        _current = {};
+        _current._data.reserve(_options._blockSize + 1024);
+        _submitted = _processed = _flushTarget = 0;
+        _stop = false;
+        _thread = std::thread(&ALoggerTxtZFile::worker, this);
+
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtZFile<_ThrSafe, _TChar>& ALoggerTxtZFile<_ThrSafe, _TChar>::closeFile() noexcept
+    {
+        auto lock{ _flush.lock() };
+
+        if (!_file.is_open())
+            return *this;
+
+        submit(true);
+
+        {
+            std::lock_guard<std::mutex> queue_lock(_mutex);
+            _stop = true;
+        }
+        _cv.notify_one();
+        _thread.join();
+
+        _file.close();
+
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    ALoggerTxtZFile<_ThrSafe, _TChar>& ALoggerTxtZFile<_ThrSafe, _TChar>::flushFile() noexcept
+    {
+        auto lock{ _flush.lock() };
+
+        if (!_file.is_open())
+            return *this;
+
+        submit(true);
+
+        {
+            std::unique_lock<std::mutex> queue_lock(_mutex);
+            _flushTarget = _submitted;
+            _cv.notify_one();
+            _cvDone.wait(queue_lock, [this] { return _processed == _submitted && _flushTarget == 0; });
+        }
+
+        _flush.flushed();
+        return *this;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    bool ALoggerTxtZFile<_ThrSafe, _TChar>::submit(bool wait) noexcept
+    {
+        if (_current._header._records == 0)
+            return true;
+
+        {
+            std::unique_lock<std::mutex> queue_lock(_mutex);
+            const auto pending{ std::max<std::size_t>(_options._pending, 1) };
+
+            // Full queue does not stop the producer, the current block keeps growing up to the size of the whole queue
+            if (_queue.size() >= pending) {
+                if (!wait && _current._data.size() < pending * _options._blockSize)
+                    return false;
+                _cvDone.wait(queue_lock, [this, pending] { return _queue.size() < pending; });
+            }
+
+            _queue.push_back(std::move(_current));
+            ++_submitted;
+        }
+        _cv.notify_one();
+
+        _current = {};
+        _current._data.reserve(_options._blockSize + 1024);
+        return true;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    bool ALoggerTxtZFile<_ThrSafe, _TChar>::flushBlock() noexcept
+    {
+        if (!_file.is_open())
+            return true;
+
+        const bool submitted{ submit(false) };
+
+        {
+            std::lock_guard<std::mutex> queue_lock(_mutex);
+            _flushTarget = _submitted;
+        }
+        _cv.notify_one();
+
+        return submitted;
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    void ALoggerTxtZFile<_ThrSafe, _TChar>::worker() noexcept
+    {
+        std::string compressed;
+        unsigned char header[SZBlockHeader::Size];
+
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (true) {
+            _cv.wait(lock, [this] { return _stop || !_queue.empty() || flushDue(); });
+
+            if (flushDue()) {
+                _flushTarget = 0;
+                lock.unlock();
+                _file.flush();
+                lock.lock();
+                _cvDone.notify_all();
+                continue;
+            }
+
+            if (_queue.empty())
+                break;
+
+            auto block{ std::move(_queue.front()) };
+            _queue.pop_front();
+            _cvDone.notify_all();
+            lock.unlock();
+
+            const auto* raw{ reinterpret_cast<const Bytef*>(block._data.data()) };
+            uLongf size{ ::compressBound(static_cast<uLong>(block._data.size())) };
+            compressed.resize(size);
+
+            bool written{false};
+
+            if (::compress2(reinterpret_cast<Bytef*>(compressed.data()), &size, raw, static_cast<uLong>(block._data.size()), _options._level) == Z_OK) {
+                block._header._rawSize = static_cast<std::uint32_t>(block._data.size());
+                block._header._compressedSize = static_cast<std::uint32_t>(size);
+                block._header._crc = static_cast<std::uint32_t>(::crc32(0L, raw, static_cast<uInt>(block._data.size())));
+                block._header.store(header);
+
+                _file.write(reinterpret_cast<const char*>(header), sizeof(header));
+                _file.write(compressed.data(), static_cast<std::streamsize>(size));
+                written = _file.good();
+            }
+
+            lock.lock();
+            if (written)
+                ++_blocks;
+            else
+                ++_errors;
+            ++_processed;
+            _cvDone.notify_all();
+        }
+    }
+
+    template<bool _ThrSafe, typename _TChar>
+    bool ALoggerTxtZFile<_ThrSafe, _TChar>::outData(std::size_t level, std::chrono::system_clock::time_point time, const TString& data) noexcept
+    {
+        assert(_file.is_open());
+
+        auto lock{ _flush.lock() };
+
+        if (!_file.is_open())
+            return false;
+
+        auto& str{ _line };
+        str.clear();
+        ALoggerTxtBase<_ThrSafe, _TChar>::prepareString(str, level, time, data);
+        const auto time_us{ zblockTime(time) };
+        auto& header{ _current._header };
+
+        unsigned char prefix[12];
+        ZBlock::store64(prefix, static_cast<std::uint64_t>(time_us));
+        ZBlock::store32(prefix + 8, static_cast<std::uint32_t>(str.size()));
+
+        _current._data.append(reinterpret_cast<const char*>(prefix), sizeof(prefix));
+        _current._data.append(str);
+
+        if (header._records == 0 || time_us < header._timeMin)
+            header._timeMin = time_us;
+        if (header._records == 0 || time_us > header._timeMax)
+            header._timeMax = time_us;
+        ++header._records;
+
+        if (_flush.written(level, sizeof(prefix) + str.size())) {
+            if (flushBlock())
+                _flush.flushed();
+        } else if (_current._data.size() >= _options._blockSize) {
+            submit(false);
+        }
+
+        return true;
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_TXT_ZFILE_H_
@@ -0,0 +1,288 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+/*! \file logger_zblock.h
+ * \brief Compressed log file block format and ALoggerZBlockReader class.
+ *
+ * Compressed log file is a sequence of independent blocks. Each block starts with #ALogger::SZBlockHeader that is
+ * followed by zlib stream of #ALogger::SZBlockHeader::_compressedSize bytes. Decompressed block contains
+ * #ALogger::SZBlockHeader::_records records, each record is :
+ * - message time as microseconds since epoch, signed 64 bit ;
+ * - message size in bytes, unsigned 32 bit ;
+ * - message text without trailing new line character.
+ *
+ * All integers are stored in little-endian byte order. Header contains records time range, so reader can skip
+ * blocks that are out of requested time window without their decompression.
+ *
+ * \code
+
+    ALogger::ALoggerZBlockReader reader("/tmp/test.azl"s);
+
+    reader.readWindow(from, to, [](std::chrono::system_clock::time_point time, std::string_view message) {
+        std::cout << message << std::endl;
+    });
+
+ * \endcode
+ */
+
+#ifndef _AVN_LOGGER_ZBLOCK_H_
+#define _AVN_LOGGER_ZBLOCK_H_
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include <zlib.h>
+
+namespace ALogger {
+
+    /** Compressed block header */
+    struct SZBlockHeader {
+        /** Block signature */
+        constexpr static std::uint32_t Magic{ 0x4C5A4E41 };     // "ANZL"
+
+        /** Serialized header size */
+        constexpr static std::size_t Size{ 40 };
+
+        std::uint32_t _magic{ Magic };          ///< Block signature
+        std::uint32_t _headerSize{ Size };      ///< Serialized header size, allows future extension
+        std::uint32_t _records{0};              ///< Records amount
+        std::uint32_t _rawSize{0};              ///< Decompressed block size
+        std::uint32_t _compressedSize{0};       ///< Compressed block size
+        std::uint32_t _crc{0};                  ///< CRC-32 of decompressed block
+        std::int64_t _timeMin{0};               ///< Earliest record time, microseconds since epoch
+        std::int64_t _timeMax{0};               ///< Latest record time, microseconds since epoch
+
+        /** Serialize header
+         *
+         * \param[out] data Output buffer of #Size bytes
+         */
+        void store(unsigned char* data) const noexcept;
+
+        /** Deserialize header
+         *
+         * \param[in] data Input buffer of #Size bytes
+         *
+         * \return True if block signature and header size are correct
+         */
+        bool load(const unsigned char* data) noexcept;
+
+        /** Check block time range overlapping
+         *
+         * \param[in] from Window start, microseconds since epoch
+         * \param[in] to Window end, microseconds since epoch
+         *
+         * \return True if block can contain records within [from, to] window
+         */
+        bool overlaps(std::int64_t from, std::int64_t to) const noexcept    { return _records != 0 && _timeMin <= to && _timeMax >= from; }
+    };
+
+    /** Convert time point to microseconds since epoch */
+    inline std::int64_t zblockTime(std::chrono::system_clock::time_point time) noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+    }
+
+    /** Compressed log file reader */
+    class ALoggerZBlockReader {
+    public:
+        /** Record handler type */
+        using TRecord = std::function<void (std::chrono::system_clock::time_point time, std::string_view message)>;
+
+        /** Constructor
+         *
+         * \param[in] filename Compressed file name and path
+         */
+        explicit ALoggerZBlockReader(const std::filesystem::path& filename) : _file(filename, std::ios_base::binary)  {}
+
+        /** Check that file is opened
+         *
+         * \return True if file is opened
+         */
+        operator bool () const noexcept                                     { return _file.is_open(); }
+
+        /** Read next block header
+         *
+         * Block data is not read. Call #skip or #read after this call.
+         *
+         * \param[out] header Block header
+         *
+         * \return False if there are no more blocks or file is corrupted
+         */
+        bool next(SZBlockHeader& header);
+
+        /** Skip current block data without decompression
+         *
+         * \param[in] header Current block header
+         */
+        void skip(const SZBlockHeader& header)                              { _file.seekg(header._compressedSize, std::ios_base::cur); }
+
+        /** Read and decompress current block data
+         *
+         * \param[in] header Current block header
+         * \param[in] handler Record handler
+         *
+         * \return False if block is corrupted
+         */
+        bool read(const SZBlockHeader& header, const TRecord& handler);
+
+        /** Output records within time window
+         *
+         * Blocks out of window are skipped without decompression.
+         *
+         * \param[in] from Window start
+         * \param[in] to Window end
+         * \param[in] handler Record handler
+         *
+         * \return Decompressed blocks amount or -1 if file is corrupted
+         */
+        long readWindow(std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to, const TRecord& handler);
+
+    private:
+        std::ifstream _file;
+        std::string _compressed;
+        std::string _raw;
+    };
+
+    namespace ZBlock {
+
+        inline void store32(unsigned char* data, std::uint32_t value) noexcept
+        {
+            for (int i = 0; i < 4; ++i)
+                data[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+
+        inline void store64(unsigned char* data, std::uint64_t value) noexcept
+        {
+            for (int i = 0; i < 8; ++i)
+                data[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+
+        inline std::uint32_t load32(const unsigned char* data) noexcept
+        {
+            std::uint32_t value{0};
+            for (int i = 3; i >= 0; --i)
+                value = (value << 8) | data[i];
+            return value;
+        }
+
+        inline std::uint64_t load64(const unsigned char* data) noexcept
+        {
+            std::uint64_t value{0};
+            for (int i = 7; i >= 0; --i)
+                value = (value << 8) | data[i];
+            return value;
+        }
+
+    } // namespace ZBlock
+
+    inline void SZBlockHeader::store(unsigned char* data) const noexcept
+    {
+        ZBlock::store32(data +  0, _magic);
+        ZBlock::store32(data +  4, _headerSize);
+        ZBlock::store32(data +  8, _records);
+        ZBlock::store32(data + 12, _rawSize);
+        ZBlock::store32(data + 16, _compressedSize);
+        ZBlock::store32(data + 20, _crc);
+        ZBlock::store64(data + 24, static_cast<std::uint64_t>(_timeMin));
+        ZBlock::store64(data + 32, static_cast<std::uint64_t>(_timeMax));
+    }
+
+    inline bool SZBlockHeader::load(const unsigned char* data) noexcept
+    {
+        _magic          = ZBlock::load32(data +  0);
+        _headerSize     = ZBlock::load32(data +  4);
+        _records        = ZBlock::load32(data +  8);
+        _rawSize        = ZBlock::load32(data + 12);
+        _compressedSize = ZBlock::load32(data + 16);
+        _crc            = ZBlock::load32(data + 20);
+        _timeMin        = static_cast<std::int64_t>(ZBlock::load64(data + 24));
+        _timeMax        = static_cast<std::int64_t>(ZBlock::load64(data + 32));
+
+        return _magic == Magic && _headerSize >= Size;
+    }
+
+    inline bool ALoggerZBlockReader::next(SZBlockHeader& header)
+    {
+        unsigned char data[SZBlockHeader::Size];
+
+        if (!_file.read(reinterpret_cast<char*>(data), sizeof(data)) || !header.load(data))
+            return false;
+
+        _file.seekg(header._headerSize - SZBlockHeader::Size, std::ios_base::cur);
+        return static_cast<bool>(_file);
+    }
+
+    inline bool ALoggerZBlockReader::read(const SZBlockHeader& header, const TRecord& handler)
+    {
+        _compressed.resize(header._compressedSize);
+        _raw.resize(header._rawSize);
+
+        if (!_file.read(_compressed.data(), static_cast<std::streamsize>(_compressed.size())))
+            return false;
+
+        uLongf raw_size{ header._rawSize };
+        if (::uncompress(reinterpret_cast<Bytef*>(_raw.data()), &raw_size, reinterpret_cast<const Bytef*>(_compressed.data()), header._compressedSize) != Z_OK ||
+                raw_size != header._rawSize ||
+                ::crc32(0L, reinterpret_cast<const Bytef*>(_raw.data()), header._rawSize) != header._crc)
+            return false;
+
+        const auto* data{ reinterpret_cast<const unsigned char*>(_raw.data()) };
+        const auto* end{ data + _raw.size() };
+
+        for (std::uint32_t record = 0; record < header._records; ++record) {
+            if (end - data < 12)
+                return false;
+
+            const auto time{ static_cast<std::int64_t>(ZBlock::load64(data)) };
+            const auto size{ ZBlock::load32(data + 8) };
+            data += 12;
+
+            if (static_cast<std::size_t>(end - data) < size)
+                return false;
+
+            handler(std::chrono::system_clock::time_point(std::chrono::microseconds(time)),
+                    std::string_view(reinterpret_cast<const char*>(data), size));
+            data += size;
+        }
+
+        return true;
+    }
+
+    inline long ALoggerZBlockReader::readWindow(std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to, const TRecord& handler)
+    {
+        const auto from_us{ zblockTime(from) };
+        const auto to_us{ zblockTime(to) };
+        long blocks{0};
+
+        SZBlockHeader header;
+
+        while (next(header)) {
+            if (!header.overlaps(from_us, to_us)) {
+                skip(header);
+                continue;
+            }
+
+            const bool res{ read(header, [&](std::chrono::system_clock::time_point time, std::string_view message) {
+                const auto time_us{ zblockTime(time) };
+                if (time_us >= from_us && time_us <= to_us)
+                    handler(time, message);
+            }) };
+
+            if (!res)
+                return -1;
+
+            ++blocks;
+        }
+
+        return _file.eof() ? blocks : -1;
+    }
+
+} // namespace ALogger
+
+#endif  // _AVN_LOGGER_ZBLOCK_H_
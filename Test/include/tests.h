@@ -7,6 +7,12 @@
 size_t test_base();
 size_t test_txt_file();
 size_t test_txt_cout();
+size_t test_txt_console();
 size_t test_txt_group();
+size_t test_txt_mmap_file();
+size_t test_txt_async_file();
+size_t test_txt_zfile();
+size_t test_txt_append_file();
+size_t test_txt_json_file();
 
 #endif  // _AVN_LOGGER_TESTS_H_
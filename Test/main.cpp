@@ -14,7 +14,13 @@ int main(int argc, char *argv[])
     ret_code += test_base();
     ret_code += test_txt_file();
     ret_code += test_txt_cout();
+    ret_code += test_txt_console();
     ret_code += test_txt_group();
+    ret_code += test_txt_mmap_file();
+    ret_code += test_txt_async_file();
+    ret_code += test_txt_zfile();
+    ret_code += test_txt_append_file();
+    ret_code += test_txt_json_file();
 
     return ret_code;
 }
\ No newline at end of file
@@ -3,8 +3,10 @@
 
 #include <functional>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <tests.h>
 #include <avn/logger/logger_base.h>
@@ -87,6 +89,45 @@ namespace {
     ALogger::ALoggerGroup<ALoggerTest, ALoggerTest2, ALoggerTest_ERROR1> err_grp;
 #endif
 
+    // Payload that counts its copies
+    struct SCounted {
+        static size_t _copies;
+
+        SCounted() = default;
+        SCounted(const SCounted&)               { ++_copies; }
+        SCounted(SCounted&&) noexcept = default;
+        SCounted& operator=(const SCounted&)    { ++_copies; return *this; }
+        SCounted& operator=(SCounted&&) noexcept = default;
+    };
+
+    size_t SCounted::_copies;
+    size_t _countedOutputs;
+
+    template<bool _ThrSafe>
+    class ALoggerCounted : public ALogger::ALoggerBase<_ThrSafe, SCounted> {
+    public:
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const SCounted& data) noexcept override
+        {
+            ++_countedOutputs;
+            return true;
+        }
+    };
+
+    class ALoggerSpill : public ALogger::ALoggerBase<false, std::string> {
+    public:
+        std::string _output;
+        std::chrono::system_clock::time_point _lastTime;
+        bool _ordered{true};
+
+        bool outData(std::size_t level, std::chrono::system_clock::time_point time, const std::string& data) noexcept override
+        {
+            _ordered = _ordered && time >= _lastTime;
+            _lastTime = time;
+            _output.append(std::to_string(level)).append(":").append(data).push_back(';');
+            return true;
+        }
+    };
+
     ALoggerTest _testLog;
     ALogger::ALoggerGroup<ALoggerTest, ALoggerTest2> _logGrp;
     size_t _errors;
@@ -403,6 +444,750 @@ size_t _testLogger_base()
     return _errors;
 }
 
+size_t _testLogger_move()
+{
+    _errors = 0;
+
+    makeStep([]()
+    {
+        ALoggerCounted<false> log;
+        log.enableLevel(1);
+
+        SCounted::_copies = 0;
+        _countedOutputs = 0;
+
+        log.addToLog(1, SCounted());
+        log.forceAddToLog(2, SCounted());
+        {
+            auto task = log.addTask();
+            log.addToLog(1, SCounted());
+            log.addToLog(2, SCounted());
+        }
+
+        return SCounted::_copies == 0 && _countedOutputs == 4;
+    }, "Test _testLogger_move.1 : Rvalue messages are copied by logger or task");
+
+    makeStep([]()
+    {
+        ALoggerCounted<true> log;
+        const SCounted data;
+
+        SCounted::_copies = 0;
+        {
+            auto task = log.addTask();
+            log.addToLog(1, data);
+        }
+
+        return SCounted::_copies == 1;
+    }, "Test _testLogger_move.2 : Lvalue message inside task is copied more than once");
+
+    makeStep([]()
+    {
+        ALogger::ALoggerGroup<ALoggerCounted<false>, ALoggerCounted<true>> group;
+        group.enableLevel(1);
+
+        SCounted::_copies = 0;
+        _countedOutputs = 0;
+
+        group.addToLog(1, SCounted());
+        {
+            auto task = group.addTask();
+            group.addToLog(1, SCounted());
+            task.addToLog(2, SCounted());
+        }
+
+        // Without tasks loggers get references, inside tasks only the first logger copies the message
+        return SCounted::_copies == 2 && _countedOutputs == 6;
+    }, "Test _testLogger_move.3 : Group copies rvalue message more than once per extra logger");
+
+    return _errors;
+}
+
+size_t _testLogger_spill()
+{
+    _errors = 0;
+
+    constexpr std::size_t entries{ 200 };
+    const auto message = [](std::size_t ind) { return "message " + std::to_string(ind) + std::string(40, '.'); };
+
+    makeStep([&]()
+    {
+        ALoggerSpill log;
+        std::string expected;
+
+        log.setSpillPolicy({ 2048, 0 });
+        log.enableLevel(1);
+        {
+            auto task = log.addTask();
+            task.failed();
+
+            for (std::size_t ind = 0; ind < entries; ++ind) {
+                log.addToLog(ind % 2 + 1, message(ind));
+                expected.append(std::to_string(ind % 2 + 1)).append(":").append(message(ind)).push_back(';');
+            }
+
+            if (task.spilledEntries() == 0 || task.memory() > 2048 || log.spillBudget().used() != task.memory())
+                return false;
+        }
+
+        return log._output == expected && log._ordered && log.spillBudget().used() == 0;
+    }, "Test _testLogger_spill.1 : Failed task does not output all spilled messages in order");
+
+    makeStep([&]()
+    {
+        ALoggerSpill log;
+        std::string expected;
+
+        log.setSpillPolicy({ 0, 1024 });
+        log.enableLevel(1);
+        {
+            auto task = log.addTask();
+            task.succeeded();
+
+            for (std::size_t ind = 0; ind < entries; ++ind) {
+                log.addToLog(ind % 2 + 1, message(ind));
+                if (ind % 2 == 0)
+                    expected.append("1:").append(message(ind)).push_back(';');
+            }
+
+            if (task.spilledEntries() == 0)
+                return false;
+        }
+
+        return log._output == expected && log._ordered && log.spillBudget().used() == 0;
+    }, "Test _testLogger_spill.2 : Succeeded task outputs spilled messages of disabled levels");
+
+    makeStep([&]()
+    {
+        ALoggerSpill log;
+        log.enableLevel(1);
+        {
+            auto task = log.addTask();
+
+            for (std::size_t ind = 0; ind < entries; ++ind)
+                log.addToLog(1, message(ind));
+
+            if (task.spilledEntries() != 0 || task.memory() != 0 || log.spillBudget().used() != 0)
+                return false;
+        }
+
+        return log._ordered;
+    }, "Test _testLogger_spill.3 : Task without spill policy accounts memory");
+
+    makeStep([&]()
+    {
+        ALoggerSpill log;
+        std::string expected;
+        constexpr std::size_t limit{ 4096 };
+
+        log.setSpillPolicy({ limit, 0 });
+        log.enableLevel(1);
+        {
+            auto task = log.addTask();
+            task.failed();
+
+            for (std::size_t ind = 0; ind < entries; ++ind) {
+                const auto spilled{ task.spilledEntries() };
+                log.addToLog(1, message(ind));
+                expected.append("1:").append(message(ind)).push_back(';');
+
+                // Spill keeps the newest messages below the low watermark
+                if (task.spilledEntries() != spilled && (task.memory() == 0 || task.memory() > ALogger::ALoggerSpillBudget::lowWatermark(limit)))
+                    return false;
+            }
+
+            if (task.spilledEntries() == 0 || task.spilledEntries() == entries)
+                return false;
+        }
+
+        return log._output == expected && log._ordered && log.spillBudget().used() == 0;
+    }, "Test _testLogger_spill.4 : Task does not spill down to the low watermark");
+
+    makeStep([&]()
+    {
+        ALoggerSpill log;
+
+        log.setSpillPolicy({ 1024 * 1024, 0 });
+        log.enableLevel(1);
+        {
+            auto task = log.addTask();
+            task.failed();
+            {
+                auto nested = log.addTask();
+                nested.succeeded();
+                log.addToLog(2, "dropped");
+                log.addToLog(1, "kept");
+                log.setSpillPolicy({ 1, 0 });
+            }
+
+            if (task.spilledEntries() != 1)
+                return false;
+        }
+
+        return log._output == "1:kept;" && log.spillBudget().used() == 0;
+    }, "Test _testLogger_spill.5 : Dropped messages are counted as spilled");
+
+    makeStep([]()
+    {
+        // Spilled prefix is removed by whole chunks and by the shift inside the first remaining one
+        ALogger::ALoggerChunkList<int, 4> list;
+        for (int ind = 0; ind < 10; ++ind)
+            list.emplace_back(ind);
+
+        list.eraseFront(5);
+        list.emplace_back(10);
+
+        std::string items;
+        for (const auto item : list)
+            items += std::to_string(item);
+
+        list.eraseFront(100);
+        list.emplace_back(11);
+
+        return items == "5678910" && list.size() == 1 && list.back() == 11 && *list.begin() == 11;
+    }, "Test _testLogger_spill.6 : Incorrect removal of the first chunk list items");
+
+    return _errors;
+}
+
+size_t _testLogger_flush()
+{
+    _errors = 0;
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        log.enableLevel(1);
+        {
+            auto task = log.addTask();
+            task.setFlushPolicy({ std::chrono::steady_clock::duration(0), 3 });
+
+            log.addToLog(1, "a");
+            log.addToLog(2, "b");
+            if (!log._output.empty())
+                return false;
+
+            log.addToLog(1, "c");
+            if (log._output != "1:a;1:c;" || task.flushes() != 1)
+                return false;
+
+            log.addToLog(2, "d");
+        }
+
+        // Failed task outputs kept messages at the end
+        return log._output == "1:a;1:c;2:b;2:d;";
+    }, "Test _testLogger_flush.1 : Incorrect partial flush by messages amount");
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        log.enableLevel(1);
+        log.setTaskFlushPolicy({ std::chrono::milliseconds(1), 0 });
+        {
+            auto task = log.addTask();
+            task.succeeded();
+
+            log.addToLog(2, "a");
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            log.addToLog(1, "b");
+            if (log._output != "1:b;")
+                return false;
+        }
+
+        return log._output == "1:b;";
+    }, "Test _testLogger_flush.2 : Incorrect partial flush by interval");
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        log.enableLevel(1);
+        log.setSpillPolicy({ 1, 0 });
+        {
+            auto task = log.addTask();
+
+            log.addToLog(1, "a");
+            log.addToLog(2, "b");
+            log.addToLog(1, "c");
+            task.flush();
+            if (log._output != "1:a;1:c;" || task.spilledEntries() != 1)
+                return false;
+
+            log.addToLog(2, "d");
+            log.addToLog(1, "e");
+            task.flush();
+            if (log._output != "1:a;1:c;1:e;" || task.spilledEntries() != 2)
+                return false;
+        }
+
+        return log._output == "1:a;1:c;1:e;2:b;2:d;" && log.spillBudget().used() == 0;
+    }, "Test _testLogger_flush.3 : Incorrect partial flush of spilled messages");
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        std::vector<ALogger::STaskInfo> reported;
+
+        {
+            ALogger::ALoggerTaskWatchdog watchdog(log.openTasks(), std::chrono::milliseconds(10), std::chrono::hours(1),
+                                                  [&reported](const ALogger::STaskInfo& task) { reported.push_back(task); });
+
+            auto task = log.addTask();
+            if (log.openTasks().size() != 1 || watchdog.check() != 0)
+                return false;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            if (watchdog.check() != 1 || watchdog.check() != 0)
+                return false;
+        }
+
+        return reported.size() == 1 && reported.front()._thread == std::this_thread::get_id() &&
+               reported.front()._age >= std::chrono::milliseconds(10) && log.openTasks().size() == 0;
+    }, "Test _testLogger_flush.4 : Watchdog does not report long task once");
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        ALogger::ALoggerTaskWatchdog* watchdog_ptr{nullptr};
+        std::size_t nested{0};
+
+        {
+            // Report function that checks tasks again locks the watchdog if it is called under the lock
+            ALogger::ALoggerTaskWatchdog watchdog(log.openTasks(), std::chrono::milliseconds(0), std::chrono::hours(1),
+                                                  [&](const ALogger::STaskInfo&) { nested += watchdog_ptr->check(); });
+            watchdog_ptr = &watchdog;
+
+            auto task = log.addTask();
+            if (watchdog.check() != 1)
+                return false;
+        }
+
+        return nested == 0;
+    }, "Test _testLogger_flush.5 : Watchdog reports tasks under its lock");
+
+    return _errors;
+}
+
+size_t _testLogger_trace()
+{
+    _errors = 0;
+
+    makeStep([]()
+    {
+        ALogger::ALoggerTrace trace;
+        ALoggerSpill log;
+        log.setTrace(&trace);
+
+        {
+            auto outer = log.addTask();
+            outer.setName("request \"1\"").succeeded();
+            log.addToLog(1, "a");
+
+            {
+                auto inner = log.addTask();
+                log.addToLog(1, "b");
+                log.addToLog(1, "c");
+            }
+        }
+
+        std::thread([&log]() { auto task = log.addTask(); task.setName("worker"); }).join();
+
+        const auto spans{ trace.spans() };
+        if (spans.size() != 3)
+            return false;
+
+        const auto& outer{ spans[0] };
+        const auto& inner{ spans[1] };
+        const auto& worker{ spans[2] };
+
+        return outer._name == "request \"1\"" && outer._depth == 0 && outer._entries == 1 && outer._succeeded &&
+               inner._name == "task" && inner._depth == 1 && inner._entries == 2 && !inner._succeeded &&
+               inner._start >= outer._start && inner._end <= outer._end && inner._thread == outer._thread &&
+               worker._name == "worker" && worker._depth == 0 && worker._thread != outer._thread;
+    }, "Test _testLogger_trace.1 : Incorrect task spans");
+
+    makeStep([]()
+    {
+        ALogger::ALoggerTrace trace;
+        ALoggerSpill log;
+        log.setTrace(&trace);
+
+        {
+            auto task = log.addTask();
+            task.setName("request \"1\"");
+        }
+
+        std::ostringstream out;
+        if (!trace.writeChromeTrace(out))
+            return false;
+
+        const auto json{ out.str() };
+        return json.find("{\"traceEvents\":[\n{\"name\":\"request \\\"1\\\"\",\"cat\":\"task\",\"ph\":\"X\",\"ts\":") == 0 &&
+               json.find("\"args\":{\"depth\":0,\"entries\":0,\"succeeded\":false}}\n]") != std::string::npos;
+    }, "Test _testLogger_trace.2 : Incorrect Chrome trace output");
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+
+        // Each trace gets its own thread buffer, buffers of destroyed traces are forgotten
+        for (std::size_t ind = 0; ind < 100; ++ind) {
+            ALogger::ALoggerTrace trace;
+            log.setTrace(&trace);
+            {
+                auto task = log.addTask();
+            }
+            log.setTrace(nullptr);
+
+            const auto spans{ trace.spans() };
+            if (spans.size() != 1 || spans.front()._thread != 1 || spans.front()._depth != 0)
+                return false;
+        }
+
+        return true;
+    }, "Test _testLogger_trace.3 : Incorrect thread buffers of sequential traces");
+
+    return _errors;
+}
+
+size_t _testLogger_shared()
+{
+    _errors = 0;
+
+    makeStep([]()
+    {
+        constexpr std::size_t threads_count{ 4 };
+        constexpr std::size_t entries{ 1000 };
+
+        ALoggerSpill log;
+        log.enableLevel(1);
+
+        auto task{ log.addSharedTask() };
+        std::vector<std::thread> threads;
+
+        for (std::size_t thread_num = 0; thread_num < threads_count; ++thread_num) {
+            threads.emplace_back([&log, task]() {
+                auto scope{ log.activate(task) };
+                for (std::size_t ind = 0; ind < entries; ++ind)
+                    log.addToLog(2, "m");
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        if (!log._output.empty())
+            return false;
+
+        task.reset();
+        return log._output.size() == threads_count * entries * 4;
+    }, "Test _testLogger_shared.1 : Failed shared task loses messages of several threads");
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        log.enableLevel(1);
+
+        auto task{ log.addSharedTask() };
+
+        std::thread([&log, task]() {
+            auto scope{ log.activate(task) };
+            log.addToLog(2, "a");
+            log.addToLog(1, "b");
+        }).join();
+
+        std::thread([&log, task]() {
+            auto scope{ log.activate(task) };
+            log.addToLog(1, "c");
+
+            {
+                auto local{ log.addTask() };
+                log.addToLog(2, "d");
+            }
+
+            log.addToLog(2, "e");
+            task.succeeded();
+        }).join();
+
+        log.addToLog(1, "f");
+        if (log._output != "1:f;")
+            return false;
+
+        // Failed thread-bound task hands its messages to the shared task
+        task.reset();
+        return log._output == "1:f;1:b;1:c;2:d;";
+    }, "Test _testLogger_shared.2 : Incorrect shared task activation or result");
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        log.enableLevel(1);
+
+        auto task{ log.addSharedTask() };
+
+        std::thread([&log, task]() {
+            auto scope{ log.activate(task) };
+            log.addToLog(2, "a");
+            {
+                auto local{ log.addTask(true) };
+                log.addToLog(2, "b");
+                log.addToLog(1, "c");
+                {
+                    auto nested{ log.addTask() };
+                    log.addToLog(2, "d");
+                }
+            }
+            log.addToLog(2, "e");
+            task.failed();
+        }).join();
+
+        if (!log._output.empty())
+            return false;
+
+        task.reset();
+        return log._output == "2:a;1:c;2:d;2:e;";
+    }, "Test _testLogger_shared.3 : Nested tasks inside the shared scope bypass the failed shared task");
+
+    return _errors;
+}
+
+size_t _testLogger_nested()
+{
+    _errors = 0;
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        log.enableLevel(1);
+        {
+            auto outer = log.addTask();
+            log.addToLog(1, "a");
+            {
+                auto inner = log.addTask();
+                inner.succeeded();
+                log.addToLog(2, "b");
+                log.addToLog(1, "c");
+            }
+            if (!log._output.empty())
+                return false;
+
+            {
+                auto inner = log.addTask();
+                log.addToLog(2, "d");
+            }
+            log.addToLog(2, "e");
+        }
+
+        // Failed outer task outputs all messages except the ones dropped by the succeeded nested task
+        return log._output == "1:a;1:c;2:d;2:e;";
+    }, "Test _testLogger_nested.1 : Nested task messages are not handed to the failed outer task in order");
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        log.enableLevel(1);
+        {
+            auto outer = log.addTask();
+            outer.succeeded();
+            {
+                auto inner = log.addTask();
+                log.addToLog(2, "a");
+                log.addToLog(1, "b");
+            }
+            log.addToLog(2, "c");
+        }
+
+        // Failed nested task messages survive the succeeded outer task
+        return log._output == "2:a;1:b;";
+    }, "Test _testLogger_nested.2 : Succeeded outer task filters failed nested task messages");
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        log.enableLevel(1);
+        log.setSpillPolicy({ 1, 0 });
+        {
+            auto outer = log.addTask();
+            log.addToLog(2, "a");
+            {
+                auto inner = log.addTask();
+                inner.succeeded();
+                log.addToLog(2, "b");
+                log.addToLog(1, "c");
+                if (inner.spilledEntries() != 2)
+                    return false;
+            }
+            log.addToLog(1, "d");
+        }
+
+        return log._output == "2:a;1:c;1:d;" && log.spillBudget().used() == 0;
+    }, "Test _testLogger_nested.3 : Spilled nested task messages are not handed to the outer task");
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        log.enableLevel(1);
+        log.setSpillPolicy({ 1, 0 });
+        {
+            auto outer = log.addTask();
+            outer.succeeded();
+            {
+                auto middle = log.addTask();
+                middle.succeeded();
+                {
+                    auto inner = log.addTask();
+                    log.addToLog(2, "a");
+                }
+                log.addToLog(2, "b");
+                if (middle.spilledEntries() == 0)
+                    return false;
+            }
+            if (outer.memory() != log.spillBudget().used())
+                return false;
+        }
+
+        return log._output == "2:a;" && log.spillBudget().used() == 0;
+    }, "Test _testLogger_nested.4 : Spilled messages of the failed nested task do not survive the succeeded tasks");
+
+    return _errors;
+}
+
+size_t _testLogger_sampling()
+{
+    _errors = 0;
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        log.enableLevel(1);
+
+        std::size_t sampled{0};
+        for (std::size_t ind = 0; ind < 10; ++ind) {
+            auto task = log.addTask(ALogger::STaskSampling::oneIn(5), true);
+            sampled += task.sampled();
+            log.addToLog(2, std::to_string(ind));
+        }
+
+        return sampled == 2 && log._output == "2:0;2:5;";
+    }, "Test _testLogger_sampling.1 : Incorrect one in N sampling of succeeded tasks");
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+
+        const auto first{ ALogger::STaskSampling::byKey("request-1", 7) };
+        if (first._hash != ALogger::STaskSampling::byKey("request-1", 7)._hash || first._hash == ALogger::STaskSampling::byKey("request-2", 7)._hash)
+            return false;
+
+        auto task = log.addTask(ALogger::STaskSampling::byKey("request-1", 1));
+        auto no_sampling = log.addTask(ALogger::STaskSampling());
+        return task.sampled() && !no_sampling.sampled();
+    }, "Test _testLogger_sampling.2 : Incorrect key sampling");
+
+    makeStep([]()
+    {
+        ALogger::ALoggerGroup<ALoggerSpill, ALoggerSpill> group;
+        group.enableLevel(1);
+
+        {
+            auto task = group.addTask(ALogger::STaskSampling::oneIn(1), true);
+            task.addToLog(2, "a");
+        }
+        {
+            auto task = group.addTask(ALogger::STaskSampling::oneIn(2), true);
+            task.addToLog(2, "b");
+        }
+
+        return group.logger<0>()._output == "2:a;" && group.logger<1>()._output == "2:a;";
+    }, "Test _testLogger_sampling.3 : Group tasks are sampled differently");
+
+    makeStep([]()
+    {
+        ALoggerSpill log;
+        log.enableLevel(1);
+        {
+            auto outer = log.addTask(true);
+            log.addToLog(2, "a");
+            {
+                auto sampled = log.addTask(ALogger::STaskSampling::oneIn(1), true);
+                log.addToLog(2, "b");
+                log.addToLog(1, "c");
+                if (!sampled.sampled())
+                    return false;
+            }
+            {
+                auto unsampled = log.addTask(ALogger::STaskSampling(), true);
+                log.addToLog(2, "d");
+            }
+        }
+
+        // Sampled nested task keeps its details inside the succeeded unsampled outer task
+        return log._output == "2:b;1:c;";
+    }, "Test _testLogger_sampling.4 : Sampled nested task loses its messages in the succeeded outer task");
+
+    return _errors;
+}
+
+size_t _testLogger_filter()
+{
+    _errors = 0;
+
+    makeStep([]()
+    {
+        ALogger::ALoggerGroup<ALoggerSpill, ALoggerSpill> group;
+
+        if (group.mayOutput(1) || group.addToLog(1, "a"))
+            return false;
+
+        // Level is changed by the logger reference, not by the group
+        group.logger<1>().enableLevel(1);
+        if (!group.mayOutput(1) || group.mayOutput(2))
+            return false;
+
+        group.addToLog(1, "b");
+        group.logger<1>().disableLevel(1);
+        group.addToLog(1, "c");
+
+        return group.logger<0>()._output.empty() && group.logger<1>()._output == "1:b;";
+    }, "Test _testLogger_filter.1 : Group filter does not follow loggers levels");
+
+    makeStep([]()
+    {
+        ALogger::ALoggerGroup<ALoggerSpill, ALoggerSpill> group;
+
+        {
+            auto task = group.addTask();
+            if (!group.mayOutput(2))
+                return false;
+            group.addToLog(2, "a");
+        }
+
+        return !group.mayOutput(2) && group.logger<0>()._output == "2:a;" && group.logger<1>()._output == "2:a;";
+    }, "Test _testLogger_filter.2 : Group filter rejects messages of the open task");
+
+    makeStep([]()
+    {
+        ALogger::ALoggerGroup<ALoggerSpill, ALoggerSpill> group;
+        ALoggerSpill other;
+
+        {
+            // Task of any logger disables the filter on the thread
+            auto task = other.addTask();
+            if (!group.mayOutput(2))
+                return false;
+        }
+
+        {
+            auto shared = group.logger<0>().addSharedTask();
+            auto scope = group.logger<0>().activate(shared);
+            group.addToLog(2, "a");
+        }
+
+        return !group.mayOutput(2) && group.mayOutput(100) && group.logger<0>()._output == "2:a;" && group.logger<1>()._output.empty();
+    }, "Test _testLogger_filter.3 : Group filter rejects messages of the shared task");
+
+    return _errors;
+}
+
 size_t test_base()
 {
     size_t res = 0;
@@ -415,6 +1200,14 @@ size_t test_base()
     res += _testLogger_group();
     res += _testLogger_task();
     res += _testLogger_group_task();
+    res += _testLogger_move();
+    res += _testLogger_spill();
+    res += _testLogger_flush();
+    res += _testLogger_trace();
+    res += _testLogger_shared();
+    res += _testLogger_nested();
+    res += _testLogger_sampling();
+    res += _testLogger_filter();
 
     if (!res)
         std::cout << "OK" << std::endl;
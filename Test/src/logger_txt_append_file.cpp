@@ -0,0 +1,105 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <tests.h>
+#include <avn/logger/logger_txt_append_file.h>
+
+namespace {
+
+    constexpr size_t processes = 4;
+    constexpr size_t records = 2000;
+
+    std::string _payload(size_t process, size_t record)
+    {
+        // Records of different length and content, long enough to span stream buffer borders
+        return "P" + std::to_string(process) + " R" + std::to_string(record) + " " +
+               std::string(100 + (record * 37 + process * 11) % 900, static_cast<char>('a' + process));
+    }
+
+    void _writer(const std::filesystem::path& tmpFile, size_t process)
+    {
+        ALogger::ALoggerTxtAppendFile<true, char> log(tmpFile);
+
+        if (process % 2 == 1)
+            log.setFlushPolicy({ 8 * 1024, std::chrono::milliseconds(0), {} });
+
+        log.addLevelDescr(0, "TEST-0");
+        log.enableLevel(0);
+
+        for (size_t i = 0; i < records; ++i)
+            log.addString(0, _payload(process, i));
+    }
+
+}   // namespace
+
+size_t test_txt_append_file()
+{
+    using namespace std;
+    namespace fs = std::filesystem;
+
+    fs::path tmpFile;
+    size_t ctr = 0;
+
+    do {
+        tmpFile = fs::temp_directory_path() / ( std::to_wstring(ctr) + L".tmp"s );
+        if (!fs::exists(tmpFile))
+            break;
+        ++ctr;
+    }
+    while(true);
+
+    std::wcout << L"START test_txt_append_file "s << tmpFile << std::endl;
+
+    std::vector<pid_t> children;
+
+    for (size_t process = 0; process < processes; ++process) {
+        const auto pid{ ::fork() };
+
+        if (pid == 0) {
+            _writer(tmpFile, process);
+            ::_exit(0);
+        }
+
+        if (pid > 0)
+            children.push_back(pid);
+    }
+
+    for (auto pid : children)
+        ::waitpid(pid, nullptr, 0);
+
+    std::vector<size_t> next(processes, 0);
+    size_t res = 0;
+    size_t lines = 0;
+    std::ifstream file(tmpFile);
+
+    for (std::string line; std::getline(file, line) && res == 0; ++lines) {
+        const auto pos{ line.find("] P") };
+        const auto process{ pos == std::string::npos ? processes : static_cast<size_t>(line[pos + 3] - '0') };
+
+        if (process >= processes || line.compare(pos + 2, std::string::npos, _payload(process, next[process])) != 0) {
+            std::cout << "[ERROR] Test test_txt_append_file : Torn record at line " << lines << std::endl;
+            ++res;
+            break;
+        }
+
+        ++next[process];
+    }
+
+    if (res == 0 && (children.size() != processes || lines != processes * records)) {
+        std::cout << "[ERROR] Test test_txt_append_file : Incorrect lines amount " << lines << std::endl;
+        ++res;
+    }
+
+    std::filesystem::remove(tmpFile);
+
+    return res;
+}
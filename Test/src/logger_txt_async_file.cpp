@@ -0,0 +1,121 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <tests.h>
+#include <avn/logger/logger_txt_async_file.h>
+
+namespace {
+
+    size_t _testLogger_async(const std::filesystem::path& tmpFile, const ALogger::SAsyncFileOptions& options, const char* descr)
+    {
+        using namespace std;
+
+        constexpr size_t records = 2000;
+
+        {
+            ALogger::ALoggerTxtAsyncFile<true, char> log(tmpFile, false, options);
+
+            log.addLevelDescr(0, "TEST-0");
+            log.enableLevel(0);
+
+            for (size_t i = 0; i < records; ++i) {
+                log.addString(0, "This is test string : integer = ", i);
+                if (i % 500 == 0)
+                    log.flushFile();
+            }
+
+            std::cout << "    " << descr << " : io_uring " << log.usesUring() << ", O_DIRECT " << log.usesDirectIO() << std::endl;
+        }
+
+        size_t lines = 0;
+        std::ifstream file(tmpFile);
+
+        for (std::string line; std::getline(file, line); ++lines) {
+            const auto expected{ "This is test string : integer = "s + std::to_string(lines) };
+            if (line.size() < expected.size() || line.compare(line.size() - expected.size(), expected.size(), expected) != 0) {
+                std::cout << "[ERROR] Test test_txt_async_file " << descr << " : Incorrect line " << lines << " : " << line << std::endl;
+                return 1;
+            }
+        }
+
+        if (lines != records) {
+            std::cout << "[ERROR] Test test_txt_async_file " << descr << " : Incorrect lines amount " << lines << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    size_t _testLogger_interval(const std::filesystem::path& tmpFile)
+    {
+        ALogger::ALoggerTxtAsyncFile<true, char> log(tmpFile, false, { 4096, 4, false, true });
+
+        log.enableLevel(0);
+        log.setFlushPolicy({ 0, std::chrono::milliseconds(10), {}, false, false });
+        log.addString(0, "Interval");
+
+        // Buffer is partially filled, so only the timer hands it to the writer
+        for (int i = 0; i < 200 && std::filesystem::file_size(tmpFile) == 0; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        if (std::filesystem::file_size(tmpFile) == 0 || log.flushPolicy().flushes() == 0) {
+            std::cout << "[ERROR] Test test_txt_async_file interval : Partially filled buffer is not written by the timer" << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    size_t _testLogger_alloc(const std::filesystem::path& tmpFile)
+    {
+        // Buffers can not be allocated, so the file is not opened
+        ALogger::ALoggerTxtAsyncFile<true, char> log(tmpFile, false, { std::numeric_limits<std::size_t>::max() / 2, 2, false, true });
+
+        if (log.IsOpenedFile()) {
+            std::cout << "[ERROR] Test test_txt_async_file alloc : File is opened without buffers" << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+}   // namespace
+
+size_t test_txt_async_file()
+{
+    using namespace std;
+    namespace fs = std::filesystem;
+
+    fs::path tmpFile;
+    size_t ctr = 0;
+
+    do {
+        tmpFile = fs::temp_directory_path() / ( std::to_wstring(ctr) + L".tmp"s );
+        if (!fs::exists(tmpFile))
+            break;
+        ++ctr;
+    }
+    while(true);
+
+    std::wcout << L"START test_txt_async_file "s << tmpFile << std::endl;
+
+    size_t res = 0;
+
+    res += _testLogger_async(tmpFile, { 4096, 4, false, true }, "io_uring");
+    res += _testLogger_async(tmpFile, { 4096, 4, false, false }, "pwrite");
+    res += _testLogger_async(tmpFile, { 8192, 4, true, true }, "O_DIRECT");
+    res += _testLogger_interval(tmpFile);
+    res += _testLogger_alloc(tmpFile);
+
+    std::filesystem::remove(tmpFile);
+
+    return res;
+}
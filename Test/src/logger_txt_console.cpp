@@ -0,0 +1,118 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <tests.h>
+#include <avn/logger/logger_txt_console.h>
+
+namespace {
+
+    std::string _readFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios_base::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    size_t _countLines(const std::string& content, const std::string& pattern)
+    {
+        size_t res = 0;
+        for (auto pos = content.find(pattern); pos != std::string::npos; pos = content.find(pattern, pos + 1))
+            ++res;
+        return res;
+    }
+
+}   // namespace
+
+size_t test_txt_console()
+{
+    using namespace std;
+    namespace fs = std::filesystem;
+
+    fs::path tmpFile;
+    size_t ctr = 0;
+
+    do {
+        tmpFile = fs::temp_directory_path() / ( std::to_wstring(ctr) + L".tmp"s );
+        if (!fs::exists(tmpFile))
+            break;
+        ++ctr;
+    }
+    while(true);
+
+    std::wcout << L"START test_txt_console "s << tmpFile << std::endl;
+
+    const auto outFile{ fs::path(tmpFile).replace_extension(".out") };
+    const auto errFile{ fs::path(tmpFile).replace_extension(".err") };
+    const int out{ ::open(outFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) };
+    const int err{ ::open(errFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) };
+
+    constexpr size_t records = 3000;
+
+    {
+        ALogger::ALoggerTxtConsole<true, char> log(true, out, err);
+
+        log.addLevelDescr(0, "TEST-0");
+        log.addLevelDescr(1, "ERROR-1");
+        log.setLevels({0, 1});
+        log.setErrorLevels({1});
+
+        for (size_t i = 0; i < records; ++i)
+            log.addString(i % 100 == 0 ? 1 : 0, "This is test string : integer = ", i);
+    }
+
+    {
+        ALogger::ALoggerTxtConsole<false, wchar_t> wlog(true, out, err);
+
+        wlog.addLevelDescr(0, L"TEST-0");
+        wlog.enableLevel(0);
+        wlog.addString(0, L"Wide string é中\U0001F600");
+    }
+
+    {
+        ALogger::ALoggerTxtConsole<false, char16_t> ulog(true, out, err);
+
+        ulog.addLevelDescr(0, u"TEST-16");
+        ulog.enableLevel(0);
+        ulog.addString(0, std::u16string_view(u"UTF-16 string é中\U0001F600 "), 16);
+    }
+
+    ::close(out);
+    ::close(err);
+
+    const auto outContent{ _readFile(outFile) };
+    const auto errContent{ _readFile(errFile) };
+    size_t res = 0;
+
+    if (_countLines(outContent, "[TEST-0] This is test string") != records - records / 100 ||
+            _countLines(errContent, "[ERROR-1] This is test string") != records / 100 ||
+            _countLines(outContent, "[ERROR-1]") != 0 ||
+            outContent.find("integer = 1\n") > outContent.find("integer = 2\n")) {
+        std::cout << "[ERROR] Test test_txt_console : Incorrect output routing" << std::endl;
+        ++res;
+    }
+
+    if (outContent.find("[TEST-0] Wide string \xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80\n") == std::string::npos) {
+        std::cout << "[ERROR] Test test_txt_console : Incorrect UTF-8 encoding" << std::endl;
+        ++res;
+    }
+
+    if (outContent.find("[TEST-16] UTF-16 string \xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80 16\n") == std::string::npos) {
+        std::cout << "[ERROR] Test test_txt_console : Incorrect UTF-16 logger output" << std::endl;
+        ++res;
+    }
+
+    fs::remove(outFile);
+    fs::remove(errFile);
+
+    return res;
+}
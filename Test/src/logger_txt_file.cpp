@@ -1,15 +1,638 @@
 // This is an independent project of an individual developer. Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
 
+#include <atomic>
 #include <codecvt>
 #include <cstdio>
 #include <functional>
 #include <iostream>
 #include <string>
 #include <filesystem>
+#include <fstream>
+#include <thread>
 #include <tests.h>
 #include <avn/logger/logger_txt_file.h>
 
+namespace {
+
+    size_t _testLogger_rotation(const std::filesystem::path& tmpDir)
+    {
+        using namespace std;
+        namespace fs = std::filesystem;
+
+        const auto file{ tmpDir / "rotation.log" };
+
+        {
+            ALogger::ALoggerTxtFile<true, char> log(file);
+
+            log.setRotation({ 200, std::chrono::seconds(0), 2 });
+            log.addLevelDescr(0, "TEST-0");
+            log.enableLevel(0);
+
+            for (size_t i = 0; i < 40; ++i) {
+                log.addString(0, "This is rotation test string : integer = ", i);
+                this_thread::sleep_for(chrono::milliseconds(2));
+            }
+        }
+
+        auto segment = [&file](const char* suffix) { auto path{ file }; path += suffix; return path; };
+
+        if (!fs::exists(file) || !fs::exists(segment(".1")) || !fs::exists(segment(".2")) ||
+                fs::exists(segment(".3")) || fs::exists(segment(".next"))) {
+            std::cout << "[ERROR] Test test_txt_file.rotation : Incorrect rotated segments" << std::endl;
+            return 1;
+        }
+
+        if (fs::file_size(segment(".1")) > 400) {
+            std::cout << "[ERROR] Test test_txt_file.rotation : Segment size exceeds rotation limit" << std::endl;
+            return 1;
+        }
+
+        // Rotation policy is changed while other thread logs
+        {
+            ALogger::ALoggerTxtFile<true, char> log(file);
+            log.enableLevel(0);
+
+            std::atomic<bool> stop{false};
+            std::thread writer([&log, &stop]() {
+                while (!stop.load())
+                    log.addString(0, "This is concurrent rotation test string");
+            });
+
+            for (size_t i = 0; i < 20; ++i)
+                log.setRotation({ 200 + i * 100, std::chrono::seconds(0), 2 });
+
+            stop = true;
+            writer.join();
+        }
+
+        if (!fs::exists(file)) {
+            std::cout << "[ERROR] Test test_txt_file.rotation : No output file after rotation policy changes" << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    size_t _testLogger_flush(const std::filesystem::path& tmpDir)
+    {
+        using namespace std;
+        namespace fs = std::filesystem;
+
+        const auto file{ tmpDir / "flush.log" };
+        constexpr size_t records = 100;
+        size_t res = 0;
+
+        auto step = [&](const ALogger::SFlushPolicy& policy, auto check, const char* descr) {
+            size_t flushes, datasyncs;
+            {
+                ALogger::ALoggerTxtFile<true, char> log(file);
+
+                log.setFlushPolicy(policy);
+                log.addLevelDescr(0, "TEST-0");
+                log.addLevelDescr(1, "TEST-1");
+                log.setLevels({0, 1});
+
+                for (size_t i = 0; i < records; ++i)
+                    log.addString(i % 10 == 0 ? 1 : 0, "This is flush test string : integer = ", i);
+
+                flushes = log.flushPolicy().flushes();
+                datasyncs = log.flushPolicy().datasyncs();
+            }
+
+            size_t lines = 0;
+            std::ifstream stream(file);
+            for (std::string line; std::getline(stream, line); ++lines);
+
+            if (lines != records || !check(flushes, datasyncs)) {
+                std::cout << "[ERROR] Test test_txt_file.flush " << descr << " : " << lines << " lines, " << flushes
+                          << " flushes, " << datasyncs << " fdatasync calls" << std::endl;
+                ++res;
+            }
+        };
+
+        step({}, [](size_t flushes, size_t) { return flushes == 0; }, "default");
+        step({ 0, chrono::milliseconds(0), {}, true }, [](size_t flushes, size_t) { return flushes == records; }, "always");
+        step({ 0, chrono::milliseconds(0), { 1 } }, [](size_t flushes, size_t) { return flushes == records / 10; }, "levels");
+        step({ 1000, chrono::milliseconds(0), {} }, [](size_t flushes, size_t) { return flushes > 0 && flushes < records / 10; }, "bytes");
+        step({ 0, chrono::milliseconds(0), { 1 }, false, true }, [](size_t, size_t datasyncs) { return datasyncs > 0 && datasyncs <= records / 10; }, "datasync");
+
+        return res;
+    }
+
+    size_t _testLogger_index(const std::filesystem::path& tmpDir)
+    {
+        using namespace std;
+        namespace fs = std::filesystem;
+
+        const auto file{ tmpDir / "index.log" };
+        constexpr size_t records = 5000;
+        const auto start{ chrono::system_clock::now() };
+        const auto recordTime = [start](size_t i) { return start + chrono::milliseconds(i); };
+
+        {
+            ALogger::ALoggerTxtFile<true, char> log(file);
+
+            log.setIndex({ 0, 50 });
+            log.addLevelDescr(0, "TEST-0");
+            log.enableLevel(0);
+
+            for (size_t i = 0; i < records; ++i)
+                log.forceAddToLog(0, "This is index test string : integer = "s + std::to_string(i), recordTime(i));
+        }
+
+        ALogger::ALoggerFileIndexReader index(file);
+
+        if (!index || index.entries() != records / 50) {
+            std::cout << "[ERROR] Test test_txt_file.index : Incorrect index entries amount " << index.entries() << std::endl;
+            return 1;
+        }
+
+        const auto [begin, end] = index.range(recordTime(2000), recordTime(2100));
+
+        std::ifstream stream(file);
+        std::string range(static_cast<size_t>(end - begin), '\0');
+        stream.seekg(static_cast<std::streamoff>(begin));
+        stream.read(range.data(), static_cast<std::streamsize>(range.size()));
+
+        if (range.find("integer = 2000\n") == std::string::npos || range.find("integer = 2100\n") == std::string::npos ||
+                range.size() > fs::file_size(file) / 20) {
+            std::cout << "[ERROR] Test test_txt_file.index : Incorrect range " << begin << " - " << end << std::endl;
+            return 1;
+        }
+
+        // Task outputs its records with original timestamps at the task end
+        const auto late{ tmpDir / "index_late.log" };
+
+        {
+            ALogger::ALoggerTxtFile<true, char> log(late);
+
+            log.setIndex({ 0, 50 });
+            log.enableLevel(0);
+
+            for (size_t i = 0; i < records; ++i) {
+                log.forceAddToLog(0, "This is index test string : integer = "s + std::to_string(i), recordTime(i));
+                if (i == 4000)
+                    log.forceAddToLog(0, "Late record"s, recordTime(2050));
+            }
+        }
+
+        {
+            ALogger::ALoggerFileIndexReader late_index(late);
+            const auto [late_begin, late_end] = late_index.range(recordTime(2000), recordTime(2100));
+
+            std::ifstream late_stream(late);
+            std::string late_range(static_cast<size_t>(std::min<std::uint64_t>(late_end, fs::file_size(late)) - late_begin), '\0');
+            late_stream.seekg(static_cast<std::streamoff>(late_begin));
+            late_stream.read(late_range.data(), static_cast<std::streamsize>(late_range.size()));
+
+            if (late_range.find("integer = 2000\n") == std::string::npos || late_range.find("Late record\n") == std::string::npos) {
+                std::cout << "[ERROR] Test test_txt_file.index : Late record is out of range " << late_begin << " - " << late_end << std::endl;
+                return 1;
+            }
+        }
+
+        const auto rotated{ tmpDir / "index_rotation.log" };
+
+        {
+            ALogger::ALoggerTxtFile<true, char> log(rotated);
+
+            log.setRotation({ 2000, std::chrono::seconds(0), 2 });
+            log.setIndex({ 200, 0 });
+            log.addLevelDescr(0, "TEST-0");
+            log.enableLevel(0);
+
+            for (size_t i = 0; i < 100; ++i) {
+                log.addString(0, "This is index rotation test string : integer = ", i);
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+        }
+
+        auto segment = [&rotated](const char* suffix) { auto path{ rotated }; path += suffix; return path; };
+
+        if (!fs::exists(segment(".idx")) || !fs::exists(segment(".1.idx")) || fs::exists(segment(".next.idx")) ||
+                fs::file_size(segment(".1.idx")) == 0) {
+            std::cout << "[ERROR] Test test_txt_file.index : Index is not rotated with segments" << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    size_t _testLogger_layout(const std::filesystem::path& tmpDir)
+    {
+        using namespace std;
+
+        const auto file{ tmpDir / "layout.log" };
+        const auto time{ chrono::system_clock::from_time_t(1000000000) + chrono::microseconds(1234) };     // 2001-09-09 01:46:40 GMT
+
+        {
+            ALogger::ALoggerTxtFile<true, char> log(file, std::ios_base::out, false);
+
+            log.addLevelDescr(0, "TEST-0");
+            log.enableLevel(0);
+            log.forceAddToLog(0, "default", time);
+
+            log.setLevelPrefix("<");
+            log.setLevelPostfix(">");
+            log.setSpace(" | ");
+            log.setDateOutputFormat("%d.%m.%Y %T");
+            log.forceAddToLog(0, "decorated", time);
+
+            log.setLayout("%F %H:%M:%S.%f %e %a %b %% %L %v");
+            log.forceAddToLog(0, "pattern", time);
+
+            log.setLayout("%L %v");
+            log.forceAddToLog(7, "no description", time);
+            log.forceAddToLog(ALogger::ALoggerTxtBase<true, char>::DenseLevels + 1, "sparse level", time);
+            log.addLevelDescr(7, "TEST-7");
+            log.forceAddToLog(7, "added description", time);
+            log.setLevelPrefix("{");
+            log.forceAddToLog(7, "new prefix", time);
+            log.forceAddToLog(ALogger::ALoggerTxtBase<true, char>::DenseLevels + 1, "cached sparse level", time);
+            log.addLevelDescr(1000, "TEST-1000");
+            log.forceAddToLog(1000, "sparse description", time);
+        }
+
+        const std::string expected[]{
+            "2001-09-09 01:46:40 [TEST-0] default",
+            "09.09.2001 01:46:40 | <TEST-0> | decorated",
+            "2001-09-09 01:46:40.001234 001 Sun Sep % <TEST-0> pattern",
+            "<7> no description",
+            "<257> sparse level",
+            "<TEST-7> added description",
+            "{TEST-7> new prefix",
+            "{257> cached sparse level",
+            "{TEST-1000> sparse description" };
+
+        std::ifstream stream(file);
+        std::string line;
+
+        for (const auto& str : expected) {
+            if (!std::getline(stream, line) || line != str) {
+                std::cout << "[ERROR] Test test_txt_file.layout : \"" << line << "\" instead of \"" << str << "\"" << std::endl;
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    size_t _testLogger_fields(const std::filesystem::path& tmpDir)
+    {
+        using namespace std;
+        using namespace std::chrono_literals;
+
+        const auto file{ tmpDir / "fields.log" };
+
+        {
+            ALogger::ALoggerTxtFile<true, char> log(file, std::ios_base::out, false);
+
+            log.addLevelDescr(0, "INFO");
+            log.addLevelDescr(1, "DEBUG");
+            log.setLayout("%L %v");
+            log.enableLevel(0);
+
+            log.addFields(0, "Request", ALogger::field("status", 200), ALogger::field("size", 15u), ALogger::field("ratio", 0.5),
+                          ALogger::field("ok", true), ALogger::field("elapsed", 1500us), ALogger::field("user", "John Smith"));
+            log.addFields(1, "Dropped by level", ALogger::field("status", 1));
+
+            {
+                auto task{ log.addTask() };
+                log.addFields(1, "Dropped by succeeded task", ALogger::field("status", 2));
+                log.addFields(0, "Task", ALogger::field("status", 3));
+                task.succeeded();
+            }
+
+            log.addString(0, "No fields");
+            log.addFields(0, "Escaped", ALogger::field("text", "say \"hi\"\nbye"), ALogger::field("bad key", "\\"));
+        }
+
+        const std::string expected[]{
+            "[INFO] Request status=200 size=15 ratio=0.5 ok=true elapsed=0.0015s user=\"John Smith\"",
+            "[INFO] Task status=3",
+            "[INFO] No fields",
+            "[INFO] Escaped text=\"say \\\"hi\\\"\\nbye\" bad_key=\"\\\\\"" };
+
+        std::ifstream stream(file);
+        std::string line;
+
+        for (const auto& str : expected) {
+            if (!std::getline(stream, line) || line != str) {
+                std::cout << "[ERROR] Test test_txt_file.fields : \"" << line << "\" instead of \"" << str << "\"" << std::endl;
+                return 1;
+            }
+        }
+
+        if (std::getline(stream, line)) {
+            std::cout << "[ERROR] Test test_txt_file.fields : unexpected line \"" << line << "\"" << std::endl;
+            return 1;
+        }
+
+        {
+            ALogger::ALoggerTxtFile<true, wchar_t> log(file, std::ios_base::out, false);
+
+            log.setLayout(L"%v");
+            log.forceAddToLog(0, L"Wide");
+            log.addFields(0, L"Wide", ALogger::field("name", "\xD0\xB0"));
+            log.enableLevel(0);
+            log.addFields(0, L"Wide", ALogger::field("name", "\xD0\xB0"));
+        }
+
+        stream.close();
+        stream.open(file, std::ios_base::binary);
+
+        if (!std::getline(stream, line) || line != "Wide" || !std::getline(stream, line) || line != "Wide name=\xD0\xB0") {
+            std::cout << "[ERROR] Test test_txt_file.fields : wide record fields \"" << line << "\" are incorrect" << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    size_t _testLogger_context(const std::filesystem::path& tmpDir)
+    {
+        using namespace std;
+
+        const auto file{ tmpDir / "context.log" };
+
+        {
+            ALogger::ALoggerTxtFile<true, char> log(file, std::ios_base::out, false);
+
+            log.addLevelDescr(0, "INFO");
+            log.setLayout("%L %v");
+            log.enableLevel(0);
+
+            log.addString(0, "No context");
+
+            {
+                auto request{ log.addContext(ALogger::field("request", 42), ALogger::field("tenant", "acme")) };
+                log.addString(0, "Request");
+
+                {
+                    auto task{ log.addTask() };
+
+                    {
+                        auto worker{ ALogger::ALoggerContext(ALogger::field("worker", "w 1")) };
+                        log.addFields(0, "Worker", ALogger::field("status", 200));
+                    }
+
+                    log.addString(0, "Task");
+                }
+            }
+
+            log.addString(0, "No context again");
+        }
+
+        const std::string expected[]{
+            "[INFO] No context",
+            "[INFO] request=42 tenant=acme Request",
+            "[INFO] request=42 tenant=acme worker=\"w 1\" Worker status=200",
+            "[INFO] request=42 tenant=acme Task",
+            "[INFO] No context again" };
+
+        std::ifstream stream(file);
+        std::string line;
+
+        for (const auto& str : expected) {
+            if (!std::getline(stream, line) || line != str) {
+                std::cout << "[ERROR] Test test_txt_file.context : \"" << line << "\" instead of \"" << str << "\"" << std::endl;
+                return 1;
+            }
+        }
+
+        {
+            ALogger::ALoggerTxtFile<true, wchar_t> log(file, std::ios_base::out, false);
+
+            log.setLayout(L"%v");
+            log.enableLevel(0);
+
+            auto context{ log.addContext(ALogger::field("name", "\xD0\xB0")) };
+            log.addString(0, L"Wide");
+            log.addString(0, L"Again");
+
+            // Wide prefix is decoded once and reused by the next records
+            const auto& snapshot{ *ALogger::ALoggerContext::current() };
+            if (snapshot.text<wchar_t>().data() != snapshot.text<wchar_t>().data() || snapshot.text<wchar_t>() != L"name=\x0430 ") {
+                std::cout << "[ERROR] Test test_txt_file.context : wide context prefix is not cached" << std::endl;
+                return 1;
+            }
+        }
+
+        stream.close();
+        stream.open(file, std::ios_base::binary);
+
+        for (const auto* str : { "name=\xD0\xB0 Wide", "name=\xD0\xB0 Again" }) {
+            if (!std::getline(stream, line) || line != str) {
+                std::cout << "[ERROR] Test test_txt_file.context : wide record context \"" << line << "\" is incorrect" << std::endl;
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    size_t _testLogger_spill(const std::filesystem::path& tmpDir)
+    {
+        using namespace std;
+
+        const auto file{ tmpDir / "spill.log" };
+        size_t spilled{0};
+
+        {
+            ALogger::ALoggerTxtFile<true, char> log(file, std::ios_base::out, false);
+
+            log.addLevelDescr(0, "INFO");
+            log.addLevelDescr(1, "DEBUG");
+            log.setLayout("%L %v");
+            log.enableLevel(0);
+            log.setSpillPolicy({ 1, 0 });
+
+            auto request{ log.addContext(ALogger::field("request", 42)) };
+            auto task{ log.addTask() };
+
+            log.addString(0, "First");
+            log.addString(1, "Debug");
+            log.addFields(0, "Fields", ALogger::field("status", 200), ALogger::field("name", "a b"));
+            spilled = task.spilledEntries();
+        }
+
+        const std::string expected[]{
+            "[INFO] request=42 First",
+            "[DEBUG] request=42 Debug",
+            "[INFO] request=42 Fields status=200 name=\"a b\"" };
+
+        if (spilled != 3) {
+            std::cout << "[ERROR] Test test_txt_file.spill : " << spilled << " spilled records instead of 3" << std::endl;
+            return 1;
+        }
+
+        std::ifstream stream(file);
+        std::string line;
+
+        for (const auto& str : expected) {
+            if (!std::getline(stream, line) || line != str) {
+                std::cout << "[ERROR] Test test_txt_file.spill : \"" << line << "\" instead of \"" << str << "\"" << std::endl;
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    size_t _testLogger_format(const std::filesystem::path& tmpDir)
+    {
+        using namespace std;
+
+        const auto file{ tmpDir / "format.log" };
+        const std::string name{ "name" };
+
+        {
+            ALogger::ALoggerTxtFile<true, char> log(file, std::ios_base::out, false);
+
+            log.setLayout("%v");
+            log.enableLevel(0);
+
+            log.addFormat(0, AVN_FMT("x={} y={:.3f} z={}"), 10, 2.5, -0.25);
+            log.addFormat(0, AVN_FMT("{:08x}|{:X}|{:b}|{:o}|{:+>6}|{:<4}|{:^7}|{:05}"), 0xBEEFu, 255, 5, 8, 42, 7, "mid", -12);
+            log.addFormat(0, AVN_FMT("{{{}}} {:.2} {} {} {:c} {:e}"), name, "truncated", true, 'c', 65, 1500.0);
+            log.addFormat(1, AVN_FMT("Disabled {}"), 1);
+        }
+
+        {
+            ALogger::ALoggerTxtFile<true, wchar_t> log(file, std::ios_base::app, false);
+
+            log.setLayout(L"%v");
+            log.enableLevel(0);
+
+            log.addFormat(0, AVN_FMT(L"wide={:>6.1f} {} {}"), 3.14159, L"text", name);
+            log.addFormat(0, AVN_FMT(L"code={:d} {:x}"), L'A', L'\xFF');
+        }
+
+        {
+            ALogger::ALoggerTxtFile<true, char> log(file, std::ios_base::app, false);
+
+            log.setLayout("%v");
+            log.enableLevel(0);
+
+            log.addFormat(0, AVN_FMT("{:.600f}"), 0.5);
+        }
+
+        const std::string expected[]{
+            "x=10 y=2.500 z=-0.25",
+            "0000beef|FF|101|10|++++42|7   |  mid  |-0012",
+            "{name} tr true c A 1.500000e+03",
+            "wide=   3.1 text name",
+            "code=65 ff",
+            "0.5" + std::string(599, '0') };
+
+        std::ifstream stream(file, std::ios_base::binary);
+        std::string line;
+
+        for (const auto& str : expected) {
+            if (!std::getline(stream, line) || line != str) {
+                std::cout << "[ERROR] Test test_txt_file.format : \"" << line << "\" instead of \"" << str << "\"" << std::endl;
+                return 1;
+            }
+        }
+
+        // Format strings are checked at compile time
+        const auto ops{ AVN_FMT("a{}b{:>4}") };
+        const auto hex{ AVN_FMT("{:x}") };
+        const auto fixed{ AVN_FMT("{:f}") };
+
+        static_assert(ALogger::Format::SCompiled<decltype(ops)>::Ops.size() == 4);
+        static_assert(ALogger::Format::check<decltype(hex), int>());
+        static_assert(!ALogger::Format::check<decltype(hex), double>());
+        static_assert(!ALogger::Format::check<decltype(fixed), const char*>());
+        static_assert(!ALogger::Format::parse(std::string_view("{:.}"), nullptr)._valid);
+        static_assert(!ALogger::Format::parse(std::string_view("{"), nullptr)._valid);
+        static_assert(!ALogger::Format::parse(std::string_view("}"), nullptr)._valid);
+        static_assert(!ALogger::Format::parse(std::string_view("{:q}"), nullptr)._valid);
+
+        return 0;
+    }
+
+    size_t _testLogger_utf8(const std::filesystem::path& tmpDir)
+    {
+        using namespace std;
+
+        // ASCII run longer than SIMD block, 2, 3 and 4 bytes sequences, unpaired surrogate
+        const std::u32string text{ U"Long enough ASCII text for the fast path \u0430\u0431 \u4E2D \U0001F600 end" };
+        const std::string encoded{ "Long enough ASCII text for the fast path \xD0\xB0\xD0\xB1 \xE4\xB8\xAD \xF0\x9F\x98\x80 end" };
+
+        std::string bytes;
+        ALogger::Utf8::append(bytes, text);
+        if (bytes != encoded) {
+            std::cout << "[ERROR] Test test_txt_file.utf8 : UTF-32 text is encoded incorrectly" << std::endl;
+            return 1;
+        }
+
+        const std::u16string utf16{ u"ASCII text before \u0430 \U0001F600 \xD800 lone" };
+        bytes.clear();
+        ALogger::Utf8::append(bytes, utf16);
+        if (bytes != "ASCII text before \xD0\xB0 \xF0\x9F\x98\x80 \xEF\xBF\xBD lone") {
+            std::cout << "[ERROR] Test test_txt_file.utf8 : UTF-16 text is encoded incorrectly" << std::endl;
+            return 1;
+        }
+
+        const auto file{ tmpDir / "utf8.log" };
+        const std::wstring message(text.cbegin(), text.cend());
+
+        {
+            ALogger::ALoggerTxtFile<true, wchar_t> log(file, std::ios_base::out, false);
+
+            log.addLevelDescr(0, L"\u0422\u0415\u0421\u0422");
+            log.setLayout(L"%L %v");
+            log.forceAddToLog(0, message, std::chrono::system_clock::now());
+        }
+
+        std::ifstream stream(file, std::ios_base::binary);
+        std::string line;
+
+        if (!std::getline(stream, line) || line != "[\xD0\xA2\xD0\x95\xD0\xA1\xD0\xA2] " + encoded) {
+            std::cout << "[ERROR] Test test_txt_file.utf8 : wide file output is not UTF-8" << std::endl;
+            return 1;
+        }
+
+        {
+            ALogger::ALoggerTxtFile<true, char16_t> log16(file, std::ios_base::out, false);
+
+            log16.addLevelDescr(0, u"UTF-16");
+            log16.setLayout(u"%L %v");
+            log16.enableLevel(0);
+            log16.addString(0, std::u16string_view(u"\u0430\U0001F600 "), 10, ' ', 2.5, " narrow \xD0\xB1");
+        }
+
+        {
+            ALogger::ALoggerTxtFile<true, char32_t> log32(file, std::ios_base::app, false);
+
+            log32.addLevelDescr(0, U"UTF-32");
+            log32.setLayout(U"%Y %L %v");
+            log32.enableLevel(0);
+            log32.addString(0, std::u32string_view(U"\u0430\U0001F600 "), -3, " narrow \xD0\xB1");
+        }
+
+        const std::string expected[]{ "[UTF-16] \xD0\xB0\xF0\x9F\x98\x80 10 2.5 narrow \xD0\xB1" };
+
+        stream.close();
+        stream.open(file, std::ios_base::binary);
+
+        if (!std::getline(stream, line) || line != expected[0]) {
+            std::cout << "[ERROR] Test test_txt_file.utf8 : UTF-16 logger output \"" << line << "\" is incorrect" << std::endl;
+            return 1;
+        }
+
+        if (!std::getline(stream, line) || line.size() < 5 || line.substr(5) != "[UTF-32] \xD0\xB0\xF0\x9F\x98\x80 -3 narrow \xD0\xB1") {
+            std::cout << "[ERROR] Test test_txt_file.utf8 : UTF-32 logger output \"" << line << "\" is incorrect" << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+}   // namespace
+
 size_t test_txt_file()
 {
     using namespace std;
@@ -38,5 +661,22 @@ size_t test_txt_file()
 
 //    std::filesystem::remove(tmpFile);
 
-    return 0;
-}
\ No newline at end of file
+    const auto tmpDir{ fs::path(tmpFile).replace_extension(".dir") };
+    fs::create_directories(tmpDir);
+
+    size_t res = 0;
+
+    res += _testLogger_rotation(tmpDir);
+    res += _testLogger_flush(tmpDir);
+    res += _testLogger_index(tmpDir);
+    res += _testLogger_layout(tmpDir);
+    res += _testLogger_utf8(tmpDir);
+    res += _testLogger_fields(tmpDir);
+    res += _testLogger_context(tmpDir);
+    res += _testLogger_spill(tmpDir);
+    res += _testLogger_format(tmpDir);
+
+    fs::remove_all(tmpDir);
+
+    return res;
+}
@@ -0,0 +1,170 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <tests.h>
+#include <avn/logger/logger_txt_json_file.h>
+
+namespace {
+
+    std::string _escapeReference(const std::string& str)
+    {
+        std::string out;
+        char code[8];
+
+        for (const auto ch : str) {
+            switch (ch) {
+            case '"' :  out += "\\\""; break;
+            case '\\' : out += "\\\\"; break;
+            case '\n' : out += "\\n"; break;
+            case '\r' : out += "\\r"; break;
+            case '\t' : out += "\\t"; break;
+            case '\b' : out += "\\b"; break;
+            case '\f' : out += "\\f"; break;
+            default :
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(ch));
+                    out += code;
+                } else {
+                    out.push_back(ch);
+                }
+            }
+        }
+
+        return out;
+    }
+
+    size_t _testLogger_escape()
+    {
+        // Special characters at each position of SIMD blocks and in the tail
+        const std::string specials{ "\"\\\n\t\x01\x1F" };
+        const std::string clean{ "Clean text \xD0\xB0\xD0\xB1 with UTF-8 bytes and some length" };
+
+        for (std::size_t pos = 0; pos < clean.size(); ++pos) {
+            auto str{ clean };
+            str.insert(pos, 1, specials[pos % specials.size()]);
+
+            std::string out;
+            ALogger::JsonEscape::append(out, str);
+
+            if (out != _escapeReference(str)) {
+                std::cout << "[ERROR] Test test_txt_json_file.escape : incorrect escaping \"" << out << "\"" << std::endl;
+                return 1;
+            }
+        }
+
+        std::string out;
+        ALogger::JsonEscape::appendLogfmt(out, "value_without_spaces_and_long_enough");
+        ALogger::JsonEscape::appendLogfmt(out, " ");
+        ALogger::JsonEscape::appendLogfmt(out, "long value with the space and equal=sign");
+        ALogger::JsonEscape::appendLogfmt(out, "");
+
+        if (out != "value_without_spaces_and_long_enough\" \"\"long value with the space and equal=sign\"\"\"") {
+            std::cout << "[ERROR] Test test_txt_json_file.escape : incorrect logfmt value \"" << out << "\"" << std::endl;
+            return 1;
+        }
+
+        out.clear();
+        ALogger::JsonEscape::appendLogfmtKey(out, "key with space=\"quote\"");
+        ALogger::JsonEscape::appendLogfmtKey(out, "");
+
+        if (out != "key_with_space__quote__") {
+            std::cout << "[ERROR] Test test_txt_json_file.escape : incorrect logfmt key \"" << out << "\"" << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+}   // namespace
+
+size_t test_txt_json_file()
+{
+    using namespace std;
+    namespace fs = std::filesystem;
+
+    fs::path tmpFile;
+    size_t ctr = 0;
+
+    do {
+        tmpFile = fs::temp_directory_path() / ( std::to_wstring(ctr) + L".tmp"s );
+        if (!fs::exists(tmpFile))
+            break;
+        ++ctr;
+    }
+    while(true);
+
+    std::wcout << L"START test_txt_json_file "s << tmpFile << std::endl;
+
+    size_t res = _testLogger_escape();
+
+    const auto time{ chrono::system_clock::from_time_t(1000000000) + chrono::microseconds(1234) };     // 2001-09-09 01:46:40 GMT
+    const auto thread{ std::to_string(ALogger::ALoggerLayout<char>::threadId()) };
+
+    {
+        ALogger::ALoggerTxtJsonFile<true, char> log(tmpFile, ALogger::EStructFormat::JSON, std::ios_base::out, false);
+
+        log.addLevelDescr(0, "INFO");
+        log.enableLevel(0);
+        log.forceAddToLog(0, "Message with \"quotes\"\nand new line", time);
+
+        log.setFormat(ALogger::EStructFormat::LOGFMT);
+        log.forceAddToLog(0, "Message with spaces", time);
+        log.forceAddToLog(7, "Word", time);
+
+        log.enableLevel(7);
+        {
+            auto context{ log.addContext(ALogger::field("request", 42u)) };
+            log.addFields(7, "Fields", ALogger::field("status", 200), ALogger::field("name", "a b"), ALogger::field("bad key", 1));
+        }
+
+        log.setFormat(ALogger::EStructFormat::JSON);
+        log.addFields(7, "Fields", ALogger::field("status", -1), ALogger::field("ok", false), ALogger::field("elapsed", std::chrono::milliseconds(250)),
+                      ALogger::field("name", "\"quoted\""), ALogger::field("nan", std::nan("")));
+    }
+
+    const std::string expected[]{
+        "{\"time\":\"2001-09-09T01:46:40.001234Z\",\"level\":\"INFO\",\"thread\":" + thread + ",\"message\":\"Message with \\\"quotes\\\"\\nand new line\"}",
+        "time=2001-09-09T01:46:40.001234Z level=INFO thread=" + thread + " message=\"Message with spaces\"",
+        "time=2001-09-09T01:46:40.001234Z level=7 thread=" + thread + " message=Word",
+        " level=7 thread=" + thread + " message=Fields request=42 status=200 name=\"a b\" bad_key=1",
+        ",\"level\":\"7\",\"thread\":" + thread + ",\"message\":\"Fields\",\"status\":-1,\"ok\":false,\"elapsed\":0.25,\"name\":\"\\\"quoted\\\"\",\"nan\":null}" };
+
+    std::ifstream stream(tmpFile);
+    std::string line;
+
+    for (const auto& str : expected) {
+        // Records added with the current time are checked after the timestamp
+        const bool full{ str.front() == 't' || str.front() == '{' };
+        if (!std::getline(stream, line) || (full ? line != str : line.size() < str.size() || line.compare(line.size() - str.size(), str.size(), str) != 0)) {
+            std::cout << "[ERROR] Test test_txt_json_file : \"" << line << "\" instead of \"" << str << "\"" << std::endl;
+            ++res;
+            break;
+        }
+    }
+
+    stream.close();
+
+    // Local time offset is written as "+hh:mm"
+    {
+        ALogger::ALoggerTxtJsonFile<true, char> log(tmpFile, ALogger::EStructFormat::JSON, std::ios_base::out, true);
+        log.forceAddToLog(0, "Local", time);
+    }
+
+    stream.open(tmpFile);
+    const auto pos{ std::getline(stream, line) ? line.find("\",\"level\"") : std::string::npos };
+    if (pos == std::string::npos || pos < 6 || (line[pos - 6] != '+' && line[pos - 6] != '-') || line[pos - 3] != ':') {
+        std::cout << "[ERROR] Test test_txt_json_file : incorrect local time offset \"" << line << "\"" << std::endl;
+        ++res;
+    }
+    stream.close();
+
+    fs::remove(tmpFile);
+
+    return res;
+}
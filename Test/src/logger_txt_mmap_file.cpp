@@ -0,0 +1,136 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include <tests.h>
+#include <avn/logger/logger_txt_mmap_file.h>
+
+size_t test_txt_mmap_file()
+{
+    using namespace std;
+    namespace fs = std::filesystem;
+
+    fs::path tmpFile;
+    size_t ctr = 0;
+
+    do {
+        tmpFile = fs::temp_directory_path() / ( std::to_wstring(ctr) + L".tmp"s );
+        if (!fs::exists(tmpFile))
+            break;
+        ++ctr;
+    }
+    while(true);
+
+    std::wcout << L"START test_txt_mmap_file "s << tmpFile << std::endl;
+
+    constexpr size_t records = 1000;
+    size_t fileSize;
+
+    {
+        ALogger::ALoggerTxtMmapFile<true, char> log;
+
+        log.setSegmentSize(4096).setMsync(ALogger::EMsync::ASYNC, 1024).openFile(tmpFile);
+        log.addLevelDescr(0, "TEST-0");
+        log.enableLevel(0);
+
+        for (size_t i = 0; i < records; ++i)
+            log.addString(0, "This is test string : integer = ", i);
+
+        fileSize = log.fileSize();
+    }
+
+    size_t res = 0;
+    size_t lines = 0;
+    std::ifstream file(tmpFile);
+
+    for (std::string line; std::getline(file, line); ++lines) {
+        const auto expected{ "This is test string : integer = "s + std::to_string(lines) };
+        if (line.size() < expected.size() || line.compare(line.size() - expected.size(), expected.size(), expected) != 0) {
+            std::cout << "[ERROR] Test test_txt_mmap_file.1 : Incorrect line " << lines << " : " << line << std::endl;
+            ++res;
+            break;
+        }
+    }
+
+    if (lines != records || fs::file_size(tmpFile) != fileSize) {
+        std::cout << "[ERROR] Test test_txt_mmap_file.2 : Incorrect lines amount or file size" << std::endl;
+        ++res;
+    }
+
+    file.close();
+
+    {
+        // Message longer than the segment is mapped by its own segment
+        const std::string long_text(10000, 'x');
+        ALogger::ALoggerTxtMmapFile<true, char> log;
+
+        log.setSegmentSize(4096).openFile(tmpFile);
+        log.setLayout("%v");
+        log.addLevelDescr(0, "TEST-0");
+        log.enableLevel(0);
+
+        std::vector<std::thread> threads;
+        for (size_t thr = 0; thr < 2; ++thr)
+            threads.emplace_back([&log, &long_text, thr]() {
+                for (size_t i = 0; i < records; ++i) {
+                    log.addString(0, i % 100 == 0 ? long_text : "short"s);
+                    if (thr == 0 && i % 10 == 0)
+                        log.flushFile();
+                }
+            });
+
+        for (auto& thread : threads)
+            thread.join();
+        log.closeFile();
+
+        std::ifstream long_file(tmpFile);
+        size_t long_lines = 0;
+        lines = 0;
+        for (std::string line; std::getline(long_file, line); ++lines)
+            if (line == long_text)
+                ++long_lines;
+            else if (line != "short")
+                break;
+
+        if (lines != 2 * records || long_lines != 2 * records / 100) {
+            std::cout << "[ERROR] Test test_txt_mmap_file.3 : Incorrect output of long messages with concurrent flushes" << std::endl;
+            ++res;
+        }
+    }
+
+    {
+        // Zero tail of the pre-allocated segment left by a crash is cut off at appending
+        {
+            std::ofstream crashed(tmpFile, std::ios::binary | std::ios::trunc);
+            crashed << "first\n" << std::string(5000, '\0');
+        }
+
+        {
+            ALogger::ALoggerTxtMmapFile<false, char> log(tmpFile, true);
+            log.setLayout("%v");
+            log.addLevelDescr(0, "TEST-0");
+            log.enableLevel(0);
+            log.addString(0, "second");
+        }
+
+        std::ifstream appended(tmpFile, std::ios::binary);
+        const std::string text{ std::istreambuf_iterator<char>(appended), std::istreambuf_iterator<char>() };
+
+        if (text != "first\nsecond\n") {
+            std::cout << "[ERROR] Test test_txt_mmap_file.4 : Zero tail is not cut off at appending" << std::endl;
+            ++res;
+        }
+    }
+
+    std::filesystem::remove(tmpFile);
+
+    return res;
+}
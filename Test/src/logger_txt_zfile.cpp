@@ -0,0 +1,116 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <tests.h>
+#include <avn/logger/logger_txt_zfile.h>
+
+size_t test_txt_zfile()
+{
+    using namespace std;
+    namespace fs = std::filesystem;
+
+    fs::path tmpFile;
+    size_t ctr = 0;
+
+    do {
+        tmpFile = fs::temp_directory_path() / ( std::to_wstring(ctr) + L".tmp"s );
+        if (!fs::exists(tmpFile))
+            break;
+        ++ctr;
+    }
+    while(true);
+
+    std::wcout << L"START test_txt_zfile "s << tmpFile << std::endl;
+
+    constexpr size_t records = 5000;
+    const auto start{ chrono::system_clock::now() };
+    const auto recordTime = [start](size_t i) { return start + chrono::milliseconds(i); };
+
+    size_t res = 0;
+    size_t blocks;
+
+    {
+        ALogger::ALoggerTxtZFile<true, char> log(tmpFile, false, { 16 * 1024, 6, 2 });
+
+        log.addLevelDescr(0, "TEST-0");
+        log.enableLevel(0);
+
+        for (size_t i = 0; i < records; ++i)
+            log.forceAddToLog(0, "This is test string : integer = "s + std::to_string(i), recordTime(i));
+
+        log.flushFile();
+        blocks = log.blocks();
+    }
+
+    if (blocks < 4 || fs::file_size(tmpFile) >= records * 32) {
+        std::cout << "[ERROR] Test test_txt_zfile : Incorrect blocks amount " << blocks << " or file size " << fs::file_size(tmpFile) << std::endl;
+        ++res;
+    }
+
+    const auto check = [&](size_t first, size_t last, const char* descr) {
+        ALogger::ALoggerZBlockReader reader(tmpFile);
+        size_t expected{ first };
+
+        const auto decompressed{ reader.readWindow(recordTime(first), recordTime(last), [&](chrono::system_clock::time_point, std::string_view message) {
+            const auto suffix{ "integer = "s + std::to_string(expected) };
+            if (message.size() < suffix.size() || message.substr(message.size() - suffix.size()) != suffix)
+                expected = records * 2;
+            ++expected;
+        }) };
+
+        if (expected != last + 1 || decompressed <= 0 || (last - first < records / 2 && static_cast<size_t>(decompressed) >= blocks)) {
+            std::cout << "[ERROR] Test test_txt_zfile " << descr << " : " << decompressed << " blocks decompressed, "
+                      << expected << " next record" << std::endl;
+            return 1;
+        }
+
+        return 0;
+    };
+
+    res += check(0, records - 1, "whole file");
+    res += check(2000, 2100, "window");
+
+    {
+        // Invalid compression level makes compress2 fail
+        ALogger::ALoggerTxtZFile<true, char> log(tmpFile, false, { 1024, 42, 4 });
+
+        log.enableLevel(0);
+        log.addString(0, "Lost record");
+        log.flushFile();
+
+        if (log.blocks() != 0 || log.errors() != 1) {
+            std::cout << "[ERROR] Test test_txt_zfile : Failed block is not counted, blocks " << log.blocks() << ", errors " << log.errors() << std::endl;
+            ++res;
+        }
+    }
+
+    {
+        // Blocks are written by the flush policy only
+        ALogger::ALoggerTxtZFile<true, char> log(tmpFile, false, { 1024 * 1024, 6, 2 });
+
+        log.setFlushPolicy({ 0, chrono::milliseconds(0), { 1 }, false, false });
+        log.enableLevel(0);
+        log.enableLevel(1);
+        log.addString(0, "Not flushed");
+        const auto unflushed{ fs::file_size(tmpFile) };
+        log.addString(1, "Flushed");
+
+        for (int i = 0; i < 200 && fs::file_size(tmpFile) == 0; ++i)
+            this_thread::sleep_for(chrono::milliseconds(5));
+
+        if (unflushed != 0 || fs::file_size(tmpFile) == 0 || log.flushPolicy().flushes() != 1) {
+            std::cout << "[ERROR] Test test_txt_zfile : Block is not written by the flush policy, " << log.flushPolicy().flushes() << " flushes" << std::endl;
+            ++res;
+        }
+    }
+
+    fs::remove(tmpFile);
+
+    return res;
+}
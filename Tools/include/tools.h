@@ -0,0 +1,65 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#ifndef _AVN_LOGGER_TOOLS_H_
+#define _AVN_LOGGER_TOOLS_H_
+
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+/** Parse time in "YYYY-MM-DD HH:MM:SS" local time format or seconds since epoch
+ *
+ * \param[in] str Time string
+ * \param[out] time Parsed time
+ *
+ * \return False if format is incorrect
+ */
+inline bool tool_parse_time(const std::string& str, std::chrono::system_clock::time_point& time)
+{
+    if (!str.empty() && str.find_first_not_of("0123456789") == std::string::npos) {
+        time = std::chrono::system_clock::from_time_t(static_cast<std::time_t>(std::stoll(str)));
+        return true;
+    }
+
+    std::tm tm{};
+    std::istringstream stream(str);
+
+    stream >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    if (stream.fail())
+        return false;
+
+    tm.tm_isdst = -1;
+    time = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    return true;
+}
+
+/** Parse time window from command line arguments
+ *
+ * Window end includes the whole second specified.
+ *
+ * \param[in] argc Arguments amount
+ * \param[in] argv Arguments
+ * \param[in] first Window start argument index
+ * \param[out] from Window start
+ * \param[out] to Window end
+ *
+ * \return False if format is incorrect
+ */
+inline bool tool_parse_window(int argc, char *argv[], int first, std::chrono::system_clock::time_point& from, std::chrono::system_clock::time_point& to)
+{
+    from = std::chrono::system_clock::time_point::min();
+    to = std::chrono::system_clock::time_point::max();
+
+    if ((argc > first && !tool_parse_time(argv[first], from)) || (argc > first + 1 && !tool_parse_time(argv[first + 1], to)))
+        return false;
+
+    if (argc > first + 1)
+        to += std::chrono::seconds(1) - std::chrono::microseconds(1);
+
+    return true;
+}
+
+#endif  // _AVN_LOGGER_TOOLS_H_
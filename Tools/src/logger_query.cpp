@@ -0,0 +1,61 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+// Extracts time range from the text log file by its time index sidecar file "<file>.idx".
+//
+// Usage : logger_query <file> [from [to]]
+//
+// Window bounds are local time in "YYYY-MM-DD HH:MM:SS" format or seconds since epoch. Range borders are found by the
+// binary search over the index, so output has index granularity and can contain records around the window.
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include <tools.h>
+#include <avn/logger/logger_file_index.h>
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 4) {
+        std::cerr << "Usage : " << argv[0] << " <file> [from [to]]" << std::endl;
+        std::cerr << "    from, to : \"YYYY-MM-DD HH:MM:SS\" local time or seconds since epoch" << std::endl;
+        return 1;
+    }
+
+    std::chrono::system_clock::time_point from, to;
+
+    if (!tool_parse_window(argc, argv, 2, from, to)) {
+        std::cerr << "Incorrect time format" << std::endl;
+        return 1;
+    }
+
+    std::ifstream file(argv[1], std::ios_base::binary);
+    if (!file) {
+        std::cerr << "Unable to open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    ALogger::ALoggerFileIndexReader index(argv[1]);
+    if (!index || index.entries() == 0) {
+        std::cerr << "Index file " << ALogger::ALoggerFileIndex::indexPath(argv[1]) << " is not found, whole file is output" << std::endl;
+    }
+
+    const auto [start, end] = index ? index.range(from, to) : std::make_pair(std::uint64_t{0}, std::numeric_limits<std::uint64_t>::max());
+
+    file.seekg(static_cast<std::streamoff>(start));
+
+    char buffer[64 * 1024];
+    auto left{ end - start };
+
+    while (left != 0 && file) {
+        file.read(buffer, static_cast<std::streamsize>(std::min<std::uint64_t>(left, sizeof(buffer))));
+        const auto read{ static_cast<std::uint64_t>(file.gcount()) };
+        std::cout.write(buffer, static_cast<std::streamsize>(read));
+        left -= read;
+    }
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+// Decompresses records of ALoggerTxtZFile compressed log within time window.
+//
+// Usage : logger_zread <file> [from [to]]
+//
+// Window bounds are local time in "YYYY-MM-DD HH:MM:SS" format or seconds since epoch. Blocks out of the window are
+// skipped without decompression.
+
+#include <iostream>
+#include <string>
+
+#include <tools.h>
+#include <avn/logger/logger_zblock.h>
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 4) {
+        std::cerr << "Usage : " << argv[0] << " <file> [from [to]]" << std::endl;
+        std::cerr << "    from, to : \"YYYY-MM-DD HH:MM:SS\" local time or seconds since epoch" << std::endl;
+        return 1;
+    }
+
+    std::chrono::system_clock::time_point from, to;
+
+    if (!tool_parse_window(argc, argv, 2, from, to)) {
+        std::cerr << "Incorrect time format" << std::endl;
+        return 1;
+    }
+
+    ALogger::ALoggerZBlockReader reader(argv[1]);
+    if (!reader) {
+        std::cerr << "Unable to open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    const auto blocks{ reader.readWindow(from, to, [](std::chrono::system_clock::time_point, std::string_view message) {
+        std::cout.write(message.data(), static_cast<std::streamsize>(message.size()));
+        std::cout.put('\n');
+    }) };
+
+    if (blocks < 0) {
+        std::cerr << "Corrupted file " << argv[1] << std::endl;
+        return 2;
+    }
+
+    return 0;
+}